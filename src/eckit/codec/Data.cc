@@ -12,28 +12,163 @@
 
 #include "eckit/codec/Data.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "eckit/codec/Exceptions.h"
 #include "eckit/codec/Stream.h"
 #include "eckit/codec/detail/Checksum.h"
+#include "eckit/codec/detail/Defaults.h"
+#include "eckit/codec/detail/RecordSections.h"
+#include "eckit/thread/ParallelFor.h"
 #include "eckit/utils/Compressor.h"
 
 namespace eckit::codec {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+namespace {
+
+std::unique_ptr<Compressor> make_compressor(const std::string& compression) {
+    std::unique_ptr<Compressor> compressor(CompressorFactory::instance().build(compression));
+    if (dynamic_cast<NoCompressor*>(compressor.get()) != nullptr) {
+        return nullptr;
+    }
+    return compressor;
+}
+
+/// Call f(i, compressor, scratch) for each of the n chunks, shared out over threads (0: the workers of the executor,
+/// see parallelFor), each range of chunks with its compressor and scratch buffer. Called from a task of the
+/// executor (e.g. by RecordReader), the chunks are shared out over the same workers, no threads are created
+template <typename F>
+void for_each_chunk(size_t n, size_t threads, const std::string& compression, F f) {
+    const size_t tasks = threads > 0 ? threads : parallelExecutor().size();
+    const size_t grain = std::max<size_t>(1, n / (4 * std::max<size_t>(1, tasks)));
+
+    parallelFor(n, grain, threads, [&](size_t begin, size_t end) {
+        auto compressor = make_compressor(compression);
+        Buffer scratch;
+        for (size_t i = begin; i < end; ++i) {
+            f(i, *compressor, scratch);
+        }
+    });
+}
+
+/// Index of data compressed in chunks (see RecordDataChunks)
+class Chunks {
+public:
+    Chunks(const void* data, size_t size, size_t uncompressed_size, size_t chunk_size) :
+        data_(static_cast<const char*>(data)) {
+        if (size < sizeof(head_)) {
+            throw DataCorruption("Data compressed in chunks is truncated");
+        }
+        ::memcpy(reinterpret_cast<char*>(&head_), data_, sizeof(head_));
+        if (not head_.valid() || head_.chunk_size != chunk_size || head_.size != uncompressed_size
+            || head_.chunks != (uncompressed_size + chunk_size - 1) / chunk_size) {
+            throw DataCorruption("Data compressed in chunks has an unexpected header");
+        }
+
+        const auto n = static_cast<size_t>(head_.chunks);
+        begin_       = sizeof(head_) + n * sizeof(RecordDataChunks::Entry);
+        if (size < begin_) {
+            throw DataCorruption("Data compressed in chunks is truncated");
+        }
+        entries_.resize(n);
+        ::memcpy(reinterpret_cast<char*>(entries_.data()), data_ + sizeof(head_), n * sizeof(RecordDataChunks::Entry));
+        for (const auto& entry : entries_) {
+            if (entry.offset + entry.length > size - begin_) {
+                throw DataCorruption("Data compressed in chunks is truncated");
+            }
+        }
+    }
+
+    size_t size() const { return entries_.size(); }
+
+    size_t chunk_size() const { return static_cast<size_t>(head_.chunk_size); }
+
+    /// Uncompressed length of chunk i
+    size_t length(size_t i) const { return std::min(chunk_size(), static_cast<size_t>(head_.size) - i * chunk_size()); }
+
+    /// Decompress chunk i into scratch, after verifying its checksum
+    void decompress(size_t i, const Compressor& compressor, Buffer& scratch) const {
+        const auto& entry = entries_[i];
+        const char* in    = data_ + begin_ + entry.offset;
+        const auto len    = static_cast<size_t>(entry.length);
+
+        if (defaults::checksum_read()) {
+            Checksum encoded{entry.checksum};
+            if (encoded.available()) {
+                Checksum computed{checksum(in, len, encoded.algorithm())};
+                if (computed.available() && computed.str() != encoded.str()) {
+                    throw DataCorruption("Mismatch in checksums of compressed chunk " + std::to_string(i)
+                                         + ".\n        Encoded:  [" + encoded.str() + "].\n        Computed: ["
+                                         + computed.str() + "].");
+                }
+            }
+        }
+
+        if (scratch.size() < length(i)) {
+            scratch.resize(length(i));
+        }
+        compressor.uncompress(in, len, scratch, length(i));
+    }
+
+private:
+    const char* data_;
+    RecordDataChunks::Head head_;
+    std::vector<RecordDataChunks::Entry> entries_;
+    size_t begin_{0};
+};
+
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------------------------
+
 Data::Data(void* p, size_t size) : buffer_(p, size), size_(size) {}
 
+Data::Data(std::shared_ptr<const void> owner, const void* p, size_t size) :
+    size_(size), owner_(std::move(owner)), view_(p) {}
+
+Data::Data(Data&& other) :
+    buffer_(std::move(other.buffer_)), size_(other.size_), owner_(std::move(other.owner_)), view_(other.view_) {
+    other.size_ = 0;
+    other.view_ = nullptr;
+}
+
+Data& Data::operator=(Data&& other) {
+    buffer_     = std::move(other.buffer_);
+    size_       = other.size_;
+    owner_      = std::move(other.owner_);
+    view_       = other.view_;
+    other.size_ = 0;
+    other.view_ = nullptr;
+    return *this;
+}
+
+std::shared_ptr<const void> Data::shared() const {
+    return view_ != nullptr ? std::shared_ptr<const void>(owner_, view_) : nullptr;
+}
+
+void Data::release() {
+    if (view_ != nullptr) {
+        owner_.reset();
+        view_ = nullptr;
+        size_ = 0;
+    }
+}
+
 std::uint64_t Data::write(Stream& out) const {
     if (size() > 0) {
-        ASSERT(buffer_.size() >= size());
-        return out.write(buffer_.data(), size());
+        ASSERT(view_ != nullptr || buffer_.size() >= size());
+        return out.write(data(), size());
     }
     return 0;
 }
 
 std::uint64_t Data::read(Stream& in, size_t size) {
+    release();
     if (size > size_) {
         buffer_.resize(size);
         size_ = size;
@@ -42,49 +177,153 @@ std::uint64_t Data::read(Stream& in, size_t size) {
 }
 
 
-void Data::compress(const std::string& compression) {
+void Data::compress(const std::string& compression, size_t chunk_size, size_t threads) {
     if (size_ > 0) {
-        auto compressor = std::unique_ptr<Compressor>(CompressorFactory::instance().build(compression));
-        if (dynamic_cast<NoCompressor*>(compressor.get()) != nullptr) {
+        auto compressor = make_compressor(compression);
+        if (not compressor) {
             return;
         }
 
-        Buffer compressed(static_cast<size_t>(1.2 * static_cast<double>(size_)));
-        size_   = compressor->compress(buffer_, size_, compressed);
-        buffer_ = std::move(compressed);
+        if (chunk_size == 0) {
+            Buffer compressed(static_cast<size_t>(1.2 * static_cast<double>(size_)));
+            const size_t compressed_size = compressor->compress(data(), size_, compressed);
+            release();
+            size_   = compressed_size;
+            buffer_ = std::move(compressed);
+            return;
+        }
+
+        RecordDataChunks::Head head;
+        head.chunk_size = chunk_size;
+        head.chunks     = (size_ + chunk_size - 1) / chunk_size;
+        head.size       = size_;
+
+        // n.b. the chunks are compressed into their own buffers, the data is only assembled once their sizes are known
+        const auto n = static_cast<size_t>(head.chunks);
+        std::vector<Buffer> compressed(n);
+        std::vector<RecordDataChunks::Entry> entries(n);
+
+        for_each_chunk(n, threads, compression, [&](size_t i, const Compressor& c, Buffer&) {
+            const char* in = static_cast<const char*>(data()) + i * chunk_size;
+            const auto len = std::min(chunk_size, size_ - i * chunk_size);
+
+            compressed[i].resize(static_cast<size_t>(1.2 * static_cast<double>(len)));
+            entries[i].length   = c.compress(in, len, compressed[i]);
+            entries[i].checksum = codec::checksum(compressed[i], static_cast<size_t>(entries[i].length));
+        });
+
+        std::uint64_t offset = 0;
+        for (auto& entry : entries) {
+            entry.offset = offset;
+            offset += entry.length;
+        }
+
+        const size_t begin = sizeof(head) + n * sizeof(RecordDataChunks::Entry);
+        Buffer chunks(begin + static_cast<size_t>(offset));
+        auto* out = static_cast<char*>(chunks.data());
+        ::memcpy(out, reinterpret_cast<const char*>(&head), sizeof(head));
+        ::memcpy(out + sizeof(head), reinterpret_cast<const char*>(entries.data()),
+                 n * sizeof(RecordDataChunks::Entry));
+        for (size_t i = 0; i < n; ++i) {
+            ::memcpy(out + begin + entries[i].offset, compressed[i].data(), static_cast<size_t>(entries[i].length));
+        }
+
+        release();
+        size_   = chunks.size();
+        buffer_ = std::move(chunks);
     }
 }
 
-void Data::decompress(const std::string& compression, size_t uncompressed_size) {
-    auto compressor = std::unique_ptr<Compressor>(CompressorFactory::instance().build(compression));
-    if (dynamic_cast<NoCompressor*>(compressor.get()) != nullptr) {
+void Data::decompress(const std::string& compression, size_t uncompressed_size, size_t chunk_size, size_t threads) {
+    auto compressor = make_compressor(compression);
+    if (not compressor) {
+        return;
+    }
+
+    if (chunk_size == 0) {
+        Buffer uncompressed(static_cast<size_t>(1.2 * static_cast<double>(uncompressed_size)));
+        compressor->uncompress(data(), size_, uncompressed, uncompressed_size);
+        release();
+        size_   = uncompressed_size;
+        buffer_ = std::move(uncompressed);
         return;
     }
 
-    Buffer uncompressed(static_cast<size_t>(1.2 * static_cast<double>(uncompressed_size)));
-    compressor->uncompress(buffer_, size_, uncompressed, uncompressed_size);
+    Chunks chunks(data(), size_, uncompressed_size, chunk_size);
+
+    Buffer uncompressed(uncompressed_size);
+    auto* out = static_cast<char*>(uncompressed.data());
+
+    for_each_chunk(chunks.size(), threads, compression, [&](size_t i, const Compressor& c, Buffer& scratch) {
+        chunks.decompress(i, c, scratch);
+        ::memcpy(out + i * chunk_size, scratch.data(), chunks.length(i));
+    });
+
+    release();
     size_   = uncompressed_size;
     buffer_ = std::move(uncompressed);
 }
 
+void Data::decompress(const std::string& compression, size_t uncompressed_size, size_t chunk_size, size_t offset,
+                      size_t length, void* out) const {
+    if (offset + length > uncompressed_size) {
+        throw OutOfRange("Range [" + std::to_string(offset) + ", " + std::to_string(offset + length)
+                             + ") is beyond the data size " + std::to_string(uncompressed_size),
+                         Here());
+    }
+    if (length == 0) {
+        return;
+    }
+
+    auto compressor = make_compressor(compression);
+    if (not compressor) {
+        ASSERT(size_ == uncompressed_size);
+        ::memcpy(out, static_cast<const char*>(data()) + offset, length);
+        return;
+    }
+
+    if (chunk_size == 0) {
+        Buffer uncompressed(static_cast<size_t>(1.2 * static_cast<double>(uncompressed_size)));
+        compressor->uncompress(data(), size_, uncompressed, uncompressed_size);
+        ::memcpy(out, static_cast<const char*>(uncompressed.data()) + offset, length);
+        return;
+    }
+
+    Chunks chunks(data(), size_, uncompressed_size, chunk_size);
+
+    Buffer scratch;
+    auto* o = static_cast<char*>(out);
+    for (size_t i = offset / chunk_size; i * chunk_size < offset + length; ++i) {
+        chunks.decompress(i, *compressor, scratch);
+
+        const size_t begin = std::max(offset, i * chunk_size);
+        const size_t end   = std::min(offset + length, i * chunk_size + chunks.length(i));
+        ::memcpy(o + (begin - offset), static_cast<const char*>(scratch.data()) + (begin - i * chunk_size),
+                 end - begin);
+    }
+}
+
 void Data::clear() {
+    release();
     buffer_ = Buffer{};
     size_   = 0;
 }
 
 std::string Data::checksum(const std::string& algorithm) const {
-    return codec::checksum(buffer_, size_, algorithm);
+    return codec::checksum(data(), size_, algorithm);
 }
 
 void Data::assign(const Data& other) {
+    release();
     if (other.size() > buffer_.size()) {
         buffer_.resize(other.size());
     }
     size_ = other.size();
-    buffer_.copy(other.buffer_, size_);
+    buffer_.copy(other.data(), size_);
 }
 
 void Data::assign(const void* p, size_t s) {
+    release();
     if (s > size()) {
         buffer_.resize(s);
     }
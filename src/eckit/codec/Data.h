@@ -13,6 +13,8 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <string>
 
 #include "eckit/io/Buffer.h"
 
@@ -27,26 +29,51 @@ public:
     Data() = default;
     Data(void*, size_t);
 
-    Data(Data&&)            = default;
-    Data& operator=(Data&&) = default;
+    /// View of memory kept alive by owner (e.g. a memory mapped file), not copied
+    Data(std::shared_ptr<const void> owner, const void*, size_t);
+
+    Data(Data&&);
+    Data& operator=(Data&&);
 
     operator const void*() const { return data(); }
-    const void* data() const { return buffer_.data(); }
+    const void* data() const { return view_ != nullptr ? view_ : buffer_.data(); }
     size_t size() const { return size_; }
 
+    /// The data, sharing ownership of the memory viewed, if a view (nullptr otherwise)
+    std::shared_ptr<const void> shared() const;
+
     void assign(const Data& other);
     void assign(const void*, size_t);
     void clear();
 
     std::uint64_t write(Stream& out) const;
     std::uint64_t read(Stream& in, size_t size);
-    void compress(const std::string& compression);
-    void decompress(const std::string& compression, size_t uncompressed_size);
+
+    /// Compress the data, as a whole (chunk_size = 0), or in chunks of chunk_size uncompressed bytes (the last one
+    /// possibly shorter), compressed independently over threads (0: all the workers, see parallelFor), each chunk
+    /// with its compressed size and checksum (see RecordDataChunks)
+    void compress(const std::string& compression, size_t chunk_size = 0, size_t threads = 0);
+
+    /// Decompress the data, compressed as a whole (chunk_size = 0) or in chunks of chunk_size bytes, in which case the
+    /// chunks are decompressed over threads (0: all the workers, see parallelFor)
+    void decompress(const std::string& compression, size_t uncompressed_size, size_t chunk_size = 0,
+                    size_t threads = 0);
+
+    /// Copy the uncompressed bytes [offset, offset + length) into out, the data being left compressed. Only the
+    /// chunks overlapping the range are decompressed (all the data, if not compressed in chunks)
+    void decompress(const std::string& compression, size_t uncompressed_size, size_t chunk_size, size_t offset,
+                    size_t length, void* out) const;
+
     std::string checksum(const std::string& algorithm = "") const;
 
 private:
+    /// Stop viewing memory, if a view, the buffer being then empty
+    void release();
+
     Buffer buffer_;
     size_t size_{0};
+    std::shared_ptr<const void> owner_;
+    const void* view_{nullptr};
 };
 
 //---------------------------------------------------------------------------------------------------------------------
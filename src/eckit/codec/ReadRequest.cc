@@ -13,7 +13,6 @@
 #include "eckit/codec/ReadRequest.h"
 
 #include "eckit/codec/Exceptions.h"
-#include "eckit/codec/RecordItemReader.h"
 #include "eckit/codec/detail/Checksum.h"
 #include "eckit/codec/detail/Defaults.h"
 #include "eckit/log/Log.h"
@@ -72,19 +71,33 @@ ReadRequest::~ReadRequest() {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+RecordItemReader ReadRequest::reader() const {
+    return stream_ ? RecordItemReader{stream_, offset_, key_} : RecordItemReader{uri_};
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 void ReadRequest::read() {
     if (item_->empty()) {
-        if (stream_) {
-            RecordItemReader{stream_, offset_, key_}.read(*item_);
-        }
-        else {
-            RecordItemReader(uri_).read(*item_);
-        }
+        reader().read(*item_);
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 
+bool ReadRequest::section(std::uint64_t& offset, std::uint64_t& length) const {
+    return !finished() && item_->empty() && reader().section(offset, length);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void ReadRequest::read(const void* section, size_t length, std::shared_ptr<const void> owner) {
+    ASSERT(item_->empty());
+    reader().read(*item_, section, length, std::move(owner));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 void ReadRequest::checksum(bool b) {
     do_checksum_ = b;
 }
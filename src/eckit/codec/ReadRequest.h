@@ -17,6 +17,7 @@
 #include <string>
 
 #include "eckit/codec/RecordItem.h"
+#include "eckit/codec/RecordItemReader.h"
 #include "eckit/codec/detail/Decoder.h"
 
 namespace eckit::codec {
@@ -54,7 +55,19 @@ public:
 
     void checksum(bool);
 
+    /// Location of the item data section in the record file (or stream), if it is still to be read and can be read
+    /// along with others (see RecordItemReader::section)
+    bool section(std::uint64_t& offset, std::uint64_t& length) const;
+
+    /// Read the item, its data section being given (as read at section()). If owner is set, the data is not copied
+    /// but viewed, the section memory being kept alive by owner (see RecordItemReader::read)
+    void read(const void* section, size_t length, std::shared_ptr<const void> owner = nullptr);
+
+    bool finished() const { return finished_ || !item_; }
+
 private:
+    RecordItemReader reader() const;
+
     ReadRequest(const std::string& URI, Decoder* decoder);
     ReadRequest(Stream, size_t offset, const std::string& key, Decoder*);
 
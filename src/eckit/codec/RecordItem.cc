@@ -13,6 +13,7 @@
 #include "eckit/codec/RecordItem.h"
 
 #include "eckit/codec/Exceptions.h"
+#include "eckit/codec/detail/Defaults.h"
 #include "eckit/filesystem/URI.h"
 
 namespace eckit::codec {
@@ -97,17 +98,31 @@ void RecordItem::clear() {
 void RecordItem::decompress() {
     ASSERT(not empty());
     if (metadata().data.compressed()) {
-        data_.decompress(metadata().data.compression(), metadata().data.size());
+        data_.decompress(metadata().data.compression(), metadata().data.size(), metadata().data.chunk_size(),
+                         defaults::compression_threads());
     }
     metadata_->data.compressed(false);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 
+void RecordItem::decompress(size_t offset, size_t length, void* out) const {
+    ASSERT(not empty());
+    const auto& info = metadata().data;
+    if (info.compressed()) {
+        data_.decompress(info.compression(), info.size(), info.chunk_size(), offset, length, out);
+    }
+    else {
+        data_.decompress("none", data_.size(), 0, offset, length, out);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 void RecordItem::compress() {
     ASSERT(not empty());
     if (not metadata().data.compressed() && metadata().data.compression() != "none") {
-        data_.compress(metadata().data.compression());
+        data_.compress(metadata().data.compression(), metadata().data.chunk_size(), defaults::compression_threads());
         metadata_->data.compressed(true);
     }
 }
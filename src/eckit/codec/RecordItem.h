@@ -63,6 +63,10 @@ public:
 
     void decompress();
 
+    /// Copy the uncompressed bytes [offset, offset + length) of the data into out, decompressing only the chunks
+    /// overlapping the range if the data is compressed in chunks
+    void decompress(size_t offset, size_t length, void* out) const;
+
     void compress();
 
 
@@ -12,6 +12,8 @@
 
 #include "eckit/codec/RecordItemReader.h"
 
+#include <cstring>
+
 #include "eckit/codec/Exceptions.h"
 #include "eckit/codec/FileStream.h"
 #include "eckit/codec/Record.h"
@@ -214,4 +216,53 @@ void RecordItemReader::read(Metadata& metadata, Data& data) {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+bool RecordItemReader::section(std::uint64_t& offset, std::uint64_t& length) const {
+    const auto& metadata = record_.metadata(uri_.key);
+    if (metadata.link() || metadata.data.section() == 0) {
+        return false;
+    }
+
+    const auto& parsed       = static_cast<const ParsedRecord&>(record_);
+    const auto& data_section = parsed.data_sections.at(static_cast<size_t>(metadata.data.section()) - 1);
+
+    offset = data_section.offset;
+    length = data_section.length;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void RecordItemReader::read(RecordItem& item, const void* section, size_t length, std::shared_ptr<const void> owner) {
+    if (length < sizeof(RecordDataSection::Begin) + sizeof(RecordDataSection::End)) {
+        throw InvalidRecord("Data section is not valid");
+    }
+
+    const auto* begin = static_cast<const char*>(section);
+    const auto* end   = begin + length - sizeof(RecordDataSection::End);
+
+    RecordDataSection::Begin data_begin;
+    RecordDataSection::End data_end;
+    ::memcpy(reinterpret_cast<char*>(&data_begin), begin, sizeof(data_begin));
+    ::memcpy(reinterpret_cast<char*>(&data_end), end, sizeof(data_end));
+    if (not data_begin.valid() || not data_end.valid()) {
+        throw InvalidRecord("Data section is not valid");
+    }
+
+    const auto* data_ptr = begin + sizeof(RecordDataSection::Begin);
+    const auto data_size = length - sizeof(data_begin) - sizeof(data_end);
+
+    Data data;
+    if (owner) {
+        data = Data(std::move(owner), data_ptr, data_size);
+    }
+    else {
+        data.assign(data_ptr, data_size);
+    }
+
+    item.metadata(record_.metadata(uri_.key));
+    item.data(std::move(data));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace eckit::codec
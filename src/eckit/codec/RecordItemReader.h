@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
 
 #include "eckit/codec/Record.h"
@@ -36,6 +38,14 @@ public:
 
     void read(Metadata&, Data&);
 
+    /// Location of the item data section in the record file (or stream), so that it can be read along with others
+    /// @return false if the item has no data section in the record (no data, or a link)
+    bool section(std::uint64_t& offset, std::uint64_t& length) const;
+
+    /// Read the item, its data section being given (as read at section()). If owner is set, the item data is not
+    /// copied but viewed, the section memory being kept alive by owner (e.g. a memory mapped file)
+    void read(RecordItem&, const void* section, size_t length, std::shared_ptr<const void> owner = nullptr);
+
 private:
     RecordItemReader(const std::string& ref, const std::string& uri);
 
@@ -12,20 +12,75 @@
 
 #include "eckit/codec/RecordReader.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "eckit/codec/Exceptions.h"
+#include "eckit/codec/FileStream.h"
 #include "eckit/codec/Metadata.h"
 #include "eckit/codec/RecordItemReader.h"
+#include "eckit/codec/detail/Defaults.h"
+#include "eckit/io/Buffer.h"
+#include "eckit/log/Log.h"
+#include "eckit/memory/MMap.h"
+#include "eckit/os/Stat.h"
+#include "eckit/thread/ParallelFor.h"
 
 namespace eckit::codec {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+namespace {
+
+/// Read-only mapping of the bytes [offset, offset + length) of a file, starting at begin, unmapped when the last
+/// reference to it goes
+std::shared_ptr<const void> map_file(const std::string& path, std::uint64_t offset, std::uint64_t length,
+                                     const char*& begin) {
+    const auto page    = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+    const auto aligned = offset - offset % page;
+    const auto size    = static_cast<size_t>(offset + length - aligned);
+
+    int fd;
+    SYSCALL2(fd = ::open(path.c_str(), O_RDONLY), path);
+
+    Stat::Struct s;
+    if (Stat::fstat(fd, &s) != 0 || static_cast<std::uint64_t>(s.st_size) < offset + length) {
+        ::close(fd);
+        throw InvalidRecord("Data sections are beyond the end of file " + path);
+    }
+
+    void* addr = MMap::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(aligned));
+
+    // n.b. the mapping outlives the file descriptor
+    ::close(fd);
+
+    if (addr == MAP_FAILED) {
+        Log::error() << "mmap(" << path << ')' << Log::syserr << std::endl;
+        throw FailedSystemCall("mmap");
+    }
+
+    begin = static_cast<const char*>(addr) + (offset - aligned);
+    return {addr, [size](void* p) { MMap::munmap(p, size); }};
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------------------------
+
 RecordReader::RecordReader(const Record::URI& ref) : RecordReader(ref.path, ref.offset) {}
 
 //---------------------------------------------------------------------------------------------------------------------
 
-RecordReader::RecordReader(const std::string& path, uint64_t offset) : path_{path}, offset_{offset} {}
+RecordReader::RecordReader(const std::string& path, uint64_t offset) :
+    path_{path}, offset_{offset}, threads_{defaults::read_threads()}, mmap_{defaults::read_mmap()} {}
 
-RecordReader::RecordReader(Stream stream, uint64_t offset) : stream_{stream}, offset_{offset} {}
+RecordReader::RecordReader(Stream stream, uint64_t offset) :
+    stream_{stream}, offset_{offset}, threads_{defaults::read_threads()}, mmap_{false} {}
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -55,10 +110,115 @@ void RecordReader::wait(const std::string& key) {
 //---------------------------------------------------------------------------------------------------------------------
 
 void RecordReader::wait() {
-    // This can be optimized perhaps to overlap IO with decoding in multithreaded environment
+    // Data sections closer than this are read in one go, up to a maximum size
+    constexpr std::uint64_t coalesce_gap  = 64 * 1024;
+    constexpr std::uint64_t coalesce_size = 64 * 1024 * 1024;
+
+    struct Section {
+        std::uint64_t offset;
+        std::uint64_t length;
+        ReadRequest* request;
+    };
+
+    std::vector<Section> sections;
+    std::vector<ReadRequest*> others;  // links and items without data, read separately
+
     for (auto& pair : requests_) {
         auto& request = pair.second;
-        request.wait();
+        if (request.finished()) {
+            continue;
+        }
+
+        Section section{0, 0, &request};
+        if (request.section(section.offset, section.length)) {
+            sections.push_back(section);
+        }
+        else {
+            others.push_back(&request);
+        }
+    }
+
+    std::sort(sections.begin(), sections.end(),
+              [](const Section& a, const Section& b) { return a.offset < b.offset; });
+
+    // n.b. on the workers of the shared executor (or of the caller's), threads_ of them at most
+    std::unique_ptr<TaskGroup> group;
+    if (threads_ != 1 && sections.size() + others.size() > 1) {
+        group = std::make_unique<TaskGroup>(parallelExecutor(), threads_);
+    }
+
+    // checksum, decompress and decode an item that has been read
+    auto complete = [&group](ReadRequest* request) {
+        if (group) {
+            group->run([request]() { request->wait(); });
+        }
+        else {
+            request->wait();
+        }
+    };
+
+    if (not sections.empty() && mmap_) {
+        const auto begin = sections.front().offset;
+        auto end         = begin;
+        for (const auto& section : sections) {
+            end = std::max(end, section.offset + section.length);
+        }
+
+        // n.b. the items view the mapping, which is unmapped with the last of them (or of the data decoded from them)
+        const char* mapped = nullptr;
+        auto mapping       = map_file(path_, begin, end - begin, mapped);
+
+        for (auto& section : sections) {
+            section.request->read(mapped + (section.offset - begin), section.length, mapping);
+            complete(section.request);
+        }
+        sections.clear();
+    }
+
+    // n.b. the file (or stream) is only read from this thread, overlapping with the completion of the items read
+    if (not sections.empty()) {
+        Stream in = stream_ ? stream_ : InputFileStream(path_);
+        Buffer buffer;
+
+        for (size_t i = 0; i < sections.size();) {
+            const auto begin = sections[i].offset;
+            auto end         = begin + sections[i].length;
+
+            size_t j = i + 1;
+            for (; j < sections.size(); ++j) {
+                const auto next = sections[j].offset + sections[j].length;
+                if (sections[j].offset > end + coalesce_gap || next - begin > coalesce_size) {
+                    break;
+                }
+                end = std::max(end, next);
+            }
+
+            const auto length = static_cast<size_t>(end - begin);
+            if (buffer.size() < length) {
+                buffer.resize(length);
+            }
+
+            in.seek(begin);
+            if (in.read(buffer, length) != length) {
+                throw InvalidRecord("Data section is not valid");
+            }
+
+            for (; i < j; ++i) {
+                auto& section    = sections[i];
+                const auto* data = static_cast<const char*>(buffer.data()) + (section.offset - begin);
+                section.request->read(data, section.length);
+                complete(section.request);
+            }
+        }
+    }
+
+    for (auto* request : others) {
+        request->read();
+        complete(request);
+    }
+
+    if (group) {
+        group->wait();
     }
 }
 
@@ -80,6 +240,14 @@ void RecordReader::checksum(bool b) {
     do_checksum_ = b ? 1 : 0;
 }
 
+void RecordReader::threads(size_t n) {
+    threads_ = n;
+}
+
+void RecordReader::mmap(bool b) {
+    mmap_ = b && !stream_;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::codec
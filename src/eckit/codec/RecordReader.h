@@ -49,6 +49,8 @@ public:
 
     void wait(const std::string& key);
 
+    /// Complete the outstanding requests. The data sections are read in file order, adjacent ones in one go, and
+    /// each item is checksummed, decompressed and decoded by a thread pool as soon as it is read
     void wait();
 
     ReadRequest& request(const std::string& key);
@@ -57,6 +59,15 @@ public:
 
     void checksum(bool);
 
+    /// Number of threads completing the requests (0: as many as the workers, see parallelFor; default:
+    /// $ECKIT_CODEC_READ_THREADS)
+    void threads(size_t);
+
+    /// Map the record file into memory rather than reading it (default: $ECKIT_CODEC_READ_MMAP), for records read
+    /// from a file. The items then view the mapping, so that uncompressed data is not copied before decoding, nor at
+    /// all when decoded into an ArrayView, which keeps the file mapped as long as it exists
+    void mmap(bool);
+
 private:
     Record::URI uri() const;
 
@@ -75,6 +86,10 @@ private:
     std::uint64_t offset_;
 
     int do_checksum_{-1};
+
+    size_t threads_;
+
+    bool mmap_;
 };
 
 //---------------------------------------------------------------------------------------------------------------------
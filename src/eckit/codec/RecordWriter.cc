@@ -22,6 +22,16 @@ namespace eckit::codec {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+/// Alignment of the data of each item, and of the length of records, so that data written to a file is aligned in
+/// it, and can be used in place when the file is mapped
+constexpr size_t data_alignment = 8;
+
+inline size_t padding(std::uint64_t position) {
+    return static_cast<size_t>((data_alignment - position % data_alignment) % data_alignment);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 template <typename OStream, typename Struct>
 inline void write_struct(OStream& out, const Struct& s) {
     static_assert(Struct::bytes == sizeof(Struct));
@@ -64,7 +74,8 @@ size_t RecordWriter::write(Stream out) const {
         write_struct(out, RecordMetadataSection::End());
         r.metadata_length = position() - r.metadata_offset;
         r.metadata_checksum
-            = do_checksum_ != 0 ? codec::checksum(metadata_str.data(), metadata_str.size()) : std::string("none:");
+            = do_checksum_ != 0 ? codec::checksum(metadata_str.data(), metadata_str.size(), checksum_algorithm_)
+                              : std::string("none:");
 
         // Index section
         // -------------
@@ -91,7 +102,10 @@ size_t RecordWriter::write(Stream out) const {
             }
             Data data;
             encode_data(encoder, data);
-            data.compress(info.compression());
+            data.compress(info.compression(), info.chunk_size(), threads_);
+
+            write_string(out, std::string(padding(position() + sizeof(RecordDataSection::Begin)), ' '));
+
             auto& data_section  = index[i];
             data_section.offset = position();
             write_struct(out, RecordDataSection::Begin());
@@ -100,13 +114,14 @@ size_t RecordWriter::write(Stream out) const {
             }
             write_struct(out, RecordDataSection::End());
             data_section.length   = position() - data_section.offset;
-            data_section.checksum = do_checksum_ != 0 ? data.checksum() : std::string("none:");
+            data_section.checksum = do_checksum_ != 0 ? data.checksum(checksum_algorithm_) : std::string("none:");
             ++i;
         }
     }
 
     // End Record
     // ----------
+    write_string(out, std::string(padding(position() + sizeof(RecordEnd)), ' '));
     write_struct(out, RecordEnd());
     auto end_of_record = out.position();
 
@@ -143,12 +158,30 @@ void RecordWriter::compression(bool on) {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+void RecordWriter::chunk_size(size_t s) {
+    chunk_size_ = s;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void RecordWriter::threads(size_t n) {
+    threads_ = n;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 void RecordWriter::checksum(bool on) {
     do_checksum_ = on && defaults::checksum_write() ? 1 : 0;  //  possible to be off via environment
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 
+void RecordWriter::checksum_algorithm(const std::string& algorithm) {
+    checksum_algorithm_ = algorithm;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 void RecordWriter::set(const RecordWriter::Key& key, Link&& link, const Configuration&) {
     keys_.emplace_back(key);
     encoders_[key] = Encoder{link};
@@ -162,6 +195,9 @@ void RecordWriter::set(const RecordWriter::Key& key, Encoder&& encoder, const Co
     if (encoder.encodes_data()) {
         ++nb_data_sections_;
         info.compression(config.getString("compression", compression_));
+        if (info.compression() != "none") {
+            info.chunk_size(config.getUnsigned("chunk_size", chunk_size_));
+        }
         info.section(nb_data_sections_);
     }
     keys_.emplace_back(key);
@@ -202,11 +238,16 @@ size_t RecordWriter::estimateMaximumSize() const {
         if (info.section() == 0) {
             continue;
         }
+        size += padding(size + sizeof(RecordDataSection::Begin));
         size += sizeof(RecordDataSection::Begin);
         {
             Metadata m;
             size_t max_data_size = encode_metadata(encoder, m);
             if (info.compression() != "none") {
+                if (info.chunk_size() > 0) {
+                    auto chunks = (max_data_size + info.chunk_size() - 1) / info.chunk_size();
+                    max_data_size += sizeof(RecordDataChunks::Head) + chunks * sizeof(RecordDataChunks::Entry);
+                }
                 max_data_size = static_cast<size_t>(1.2 * static_cast<double>(max_data_size));
                 max_data_size = std::max<size_t>(max_data_size, 10 * 1024);  // minimum 10KB
             }
@@ -215,6 +256,7 @@ size_t RecordWriter::estimateMaximumSize() const {
         size += sizeof(RecordDataSection::End);
     }
 
+    size += padding(size + sizeof(RecordEnd));
     size += sizeof(RecordEnd);
 
     return size;
@@ -233,6 +275,9 @@ std::string RecordWriter::metadata() const {
             m.set("data.section", info.section());
             if (info.compression() != "none") {
                 m.set("data.compression.type", info.compression());
+                if (info.chunk_size() > 0) {
+                    m.set("data.compression.chunk_size", info.chunk_size());
+                }
             }
         }
         metadata.set(key, m);
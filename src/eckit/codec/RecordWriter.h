@@ -53,9 +53,18 @@ public:
     /// @brief Set compression off or to default
     void compression(bool);
 
+    /// @brief Set size of the chunks compressed independently (and in parallel), 0 to compress items as a whole
+    void chunk_size(size_t);
+
+    /// @brief Set number of threads compressing the chunks of an item (0: all the workers, see parallelFor)
+    void threads(size_t);
+
     /// @brief Set checksum off or to default
     void checksum(bool);
 
+    /// @brief Set checksum algorithm of metadata and data sections (see HashFactory), e.g. "xxh3" (default: xxh64)
+    void checksum_algorithm(const std::string&);
+
     // -- set( Key, Value ) where Value can be a variety of things
 
     /// @brief Add link to other record item (RecordItem::URI)
@@ -122,7 +131,10 @@ private:
     std::map<std::string, DataInfo> info_;
 
     std::string compression_{defaults::compression_algorithm()};
+    size_t chunk_size_{defaults::compression_chunk_size()};
+    size_t threads_{defaults::compression_threads()};
     int do_checksum_{defaults::checksum_write() ? 1 : 0};
+    std::string checksum_algorithm_{defaults::checksum_algorithm()};
     int nb_data_sections_{0};
 
     std::string metadata() const;
@@ -19,6 +19,7 @@
 namespace eckit::codec::defaults {
 
 [[maybe_unused]] static const std::string& checksum_algorithm() {
+    // n.b. writers may select another algorithm (e.g. "xxh3", "crc32c"), which is stored with the checksum
     static const auto checksum = Resource<std::string>("eckit.codec.checksum.algorithm;$ECKIT_CODEC_CHECKSUM", "xxh64");
     return checksum;
 }
@@ -33,10 +34,31 @@ namespace eckit::codec::defaults {
     return checksum;
 }
 
+[[maybe_unused]] static size_t read_threads() {
+    static const auto threads = Resource<size_t>("eckit.codec.read.threads;$ECKIT_CODEC_READ_THREADS", 0);
+    return threads;
+}
+
+[[maybe_unused]] static bool read_mmap() {
+    static const auto mmap = Resource<bool>("eckit.codec.read.mmap;$ECKIT_CODEC_READ_MMAP", false);
+    return mmap;
+}
+
 [[maybe_unused]] static const std::string& compression_algorithm() {
     static const auto compression = Resource<std::string>("eckit.codec.compression;$ECKIT_CODEC_COMPRESSION", "none");
     return compression;
 }
 
+[[maybe_unused]] static size_t compression_chunk_size() {
+    static const auto chunk_size
+        = Resource<size_t>("eckit.codec.compression.chunk_size;$ECKIT_CODEC_COMPRESSION_CHUNK_SIZE", 0);
+    return chunk_size;
+}
+
+[[maybe_unused]] static size_t compression_threads() {
+    static const auto threads = Resource<size_t>("eckit.codec.compression.threads;$ECKIT_CODEC_COMPRESSION_THREADS", 0);
+    return threads;
+}
+
 
 }  // namespace eckit::codec::defaults
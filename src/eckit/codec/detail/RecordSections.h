@@ -168,5 +168,31 @@ struct RecordDataSection {
 
 // ------------------------------------------------------------------------------------------------------------------------------------
 
+/// Layout of the data of an item compressed in chunks: Head, an Entry per chunk, then the compressed chunks
+struct RecordDataChunks {
+    static constexpr char TAG[] = "CHUNKS";
+
+    struct Head {  // 32 bytes
+        static constexpr size_t bytes = 32;
+
+        FixedString<8> string{TAG};
+        std::uint64_t chunk_size{0};  ///< uncompressed size of the chunks (but the last, possibly shorter)
+        std::uint64_t chunks{0};      ///< number of chunks
+        std::uint64_t size{0};        ///< uncompressed size of the data
+
+        bool valid() const { return string == TAG; }
+    };
+
+    struct Entry {  // 80 bytes
+        static constexpr size_t bytes = 80;
+
+        std::uint64_t offset;      ///< offset of the compressed chunk, from the end of the entries
+        std::uint64_t length;      ///< length of the compressed chunk
+        FixedString<64> checksum;  ///< checksum of the compressed chunk
+    };
+};
+
+// ------------------------------------------------------------------------------------------------------------------------------------
+
 
 }  // namespace eckit::codec
@@ -0,0 +1,69 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+
+#include "eckit/codec/types/array/ArrayView.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace eckit::codec {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+ArrayView::ArrayView(ArrayMetadata&& metadata, std::shared_ptr<const void> data, bool shared) :
+    ArrayMetadata(std::move(metadata)), data_(std::move(data)), shared_(shared) {}
+
+ArrayView::ArrayView(const ArrayView& other) : ArrayMetadata(other), data_(other.data_), shared_(other.shared_) {}
+
+ArrayView::ArrayView(ArrayView&& other) :
+    ArrayMetadata(std::move(other)), data_(std::move(other.data_)), shared_(other.shared_) {}
+
+ArrayView& ArrayView::operator=(const ArrayView& other) {
+    ArrayMetadata::operator=(ArrayMetadata(other));
+    data_   = other.data_;
+    shared_ = other.shared_;
+    return *this;
+}
+
+ArrayView& ArrayView::operator=(ArrayView&& other) {
+    ArrayMetadata::operator=(std::move(other));
+    data_   = std::move(other.data_);
+    shared_ = other.shared_;
+    return *this;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void decode(const Metadata& metadata, const Data& data, ArrayView& out) {
+    ArrayMetadata array(metadata);
+
+    const auto bytes = array.bytes();
+    if (data.size() < bytes) {
+        throw DataCorruption("Array data is " + std::to_string(data.size()) + " bytes, " + std::to_string(bytes)
+                             + " bytes expected");
+    }
+
+    // n.b. the elements are only used in place if aligned
+    auto shared = data.shared();
+    if (shared && reinterpret_cast<std::uintptr_t>(shared.get()) % array.datatype().size() == 0) {
+        out = ArrayView(std::move(array), std::move(shared), true);
+        return;
+    }
+
+    std::shared_ptr<const void> copy(new char[bytes], std::default_delete<char[]>());
+    ::memcpy(const_cast<void*>(copy.get()), data.data(), bytes);
+    out = ArrayView(std::move(array), std::move(copy), false);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::codec
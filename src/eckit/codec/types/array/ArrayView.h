@@ -0,0 +1,68 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+
+#pragma once
+
+#include <memory>
+
+#include "eckit/codec/Data.h"
+#include "eckit/codec/Exceptions.h"
+#include "eckit/codec/Metadata.h"
+#include "eckit/codec/types/array/ArrayMetadata.h"
+
+namespace eckit::codec {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// Read-only array decoded without copying its data, when the data read can be shared: with RecordReader::mmap, an
+/// uncompressed array views the mapped record file, which stays mapped as long as the view (or a copy of it) exists.
+/// Otherwise (e.g. compressed data), the data is copied once, into memory owned by the view.
+class ArrayView : public ArrayMetadata {
+public:
+    ArrayView() = default;
+
+    ArrayView(ArrayMetadata&&, std::shared_ptr<const void> data, bool shared);
+
+    ArrayView(const ArrayView&);
+
+    ArrayView(ArrayView&&);
+
+    ArrayView& operator=(const ArrayView&);
+
+    ArrayView& operator=(ArrayView&&);
+
+    const void* data() const { return data_.get(); }
+
+    template <typename T>
+    const T* data() const {
+        if (datatype().kind() != DataType::kind<T>()) {
+            throw Exception("ArrayView of " + datatype().str() + " cannot be accessed as " + DataType::str<T>(),
+                            Here());
+        }
+        return static_cast<const T*>(data_.get());
+    }
+
+    /// If the data is shared with the memory read (not copied)
+    bool shared() const { return shared_; }
+
+private:
+    std::shared_ptr<const void> data_;
+    bool shared_{false};
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void decode(const Metadata&, const Data&, ArrayView&);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::codec
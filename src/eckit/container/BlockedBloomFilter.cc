@@ -0,0 +1,361 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+
+#include "eckit/container/BlockedBloomFilter.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+#include "eckit/eckit.h"
+
+#include "eckit/config/LibEcKit.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/io/AutoCloser.h"
+#include "eckit/io/FileHandle.h"
+#include "eckit/log/Bytes.h"
+#include "eckit/log/Log.h"
+#include "eckit/memory/MMap.h"
+#include "eckit/os/Stat.h"
+
+#if eckit_HAVE_XXHASH
+#define XXH_INLINE_ALL
+#include "eckit/contrib/xxhash/xxhash.h"
+#endif
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+constexpr char magic[8]               = {'E', 'C', 'K', 'I', 'T', 'B', 'L', 'F'};
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+constexpr size_t maxHashes = 16;
+
+constexpr size_t words = BlockedBloomFilter::blockSize / sizeof(std::uint64_t);
+
+
+/// Bits of a value within its block, by double hashing of the (remixed) hash
+template <typename F>
+inline void forEachBit(std::uint64_t hash, size_t k, F f) {
+    static_assert(BlockedBloomFilter::blockBits == 512, "9 bits per position expected");
+
+    const std::uint64_t h = hash * 0x9E3779B97F4A7C15ULL;
+    auto a                = static_cast<std::uint32_t>(h);
+    auto b                = static_cast<std::uint32_t>(h >> 32) | 1U;
+
+    for (size_t i = 0; i < k; ++i, a += b) {
+        const std::uint32_t bit = a >> (32 - 9);
+        f(bit / 64, std::uint64_t(1) << (bit % 64));
+    }
+}
+
+
+inline void prefetch(const void* addr) {
+#if defined(__GNUC__)
+    __builtin_prefetch(addr);
+#endif
+}
+
+
+void write(DataHandle& dh, const void* buffer, size_t length) {
+    ASSERT(dh.write(buffer, static_cast<long>(length)) == static_cast<long>(length));
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::uint64_t BlockedBloomFilter::hash(const void* buffer, size_t length) {
+#if eckit_HAVE_XXHASH
+    return XXH3_64bits(buffer, length);
+#else
+    // FNV-1a, with a final mix so that all bits depend on all input bytes
+    const auto* p   = static_cast<const unsigned char*>(buffer);
+    std::uint64_t h = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < length; ++i) {
+        h = (h ^ p[i]) * 0x100000001B3ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+#endif
+}
+
+
+std::uint32_t BlockedBloomFilter::hashFunction() {
+#if eckit_HAVE_XXHASH
+    return 1;  // XXH3, 64 bits
+#else
+    return 2;  // FNV-1a, 64 bits
+#endif
+}
+
+
+BlockedBloomFilter::BlockedBloomFilter(size_t capacity, double falsePositiveRate) :
+    blocks_(nullptr), nblocks_(0), hashes_(0), entries_(0), addr_(nullptr), size_(0) {
+    ASSERT(0. < falsePositiveRate && falsePositiveRate < 1.);
+
+    const double ln2 = std::log(2.);
+    const double n   = static_cast<double>(std::max<size_t>(capacity, 1));
+    const double m   = std::ceil(-n * std::log(falsePositiveRate) / (ln2 * ln2));
+
+    const auto k = static_cast<size_t>(std::lround(m / n * ln2));
+    setup(static_cast<size_t>(std::ceil(m / blockBits)), std::min(std::max<size_t>(k, 1), maxHashes));
+}
+
+
+BlockedBloomFilter::BlockedBloomFilter(const PathName& path, bool mapped) :
+    blocks_(nullptr), nblocks_(0), hashes_(0), entries_(0), addr_(nullptr), size_(0) {
+
+    auto check = [this, &path](bool ok, const std::string& what) {
+        if (!ok) {
+            if (addr_ != nullptr) {
+                MMap::munmap(addr_, size_);
+                addr_ = nullptr;
+            }
+            throw BadValue("BlockedBloomFilter: cannot load " + path.asString() + ", " + what);
+        }
+    };
+
+    auto validate = [this, &check](const Header& header) {
+        check(::memcmp(header.magic_, magic, sizeof(magic)) == 0, "not a Bloom filter file");
+        check(header.version_ == version, "unsupported version " + std::to_string(header.version_));
+        check(header.order_ == byteOrderMark, "written with a different byte order");
+        check(header.hashFunction_ == hashFunction(), "written with a different hash function");
+        check(1 <= header.hashes_ && header.hashes_ <= maxHashes && header.blocks_ > 0, "inconsistent header");
+
+        nblocks_ = header.blocks_;
+        hashes_  = header.hashes_;
+        entries_ = header.entries_;
+    };
+
+    Header header;
+
+    if (mapped) {
+        int fd;
+        SYSCALL2(fd = ::open(path.localPath(), O_RDONLY), path);
+
+        Stat::Struct s;
+        if (Stat::fstat(fd, &s) != 0 || static_cast<size_t>(s.st_size) < blockSize) {
+            ::close(fd);
+            throw ReadError("BlockedBloomFilter: cannot map " + path.asString() + ", not a Bloom filter file");
+        }
+
+        size_ = static_cast<size_t>(s.st_size);
+        addr_ = MMap::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+
+        // n.b. the mapping outlives the file descriptor
+        ::close(fd);
+
+        if (addr_ == MAP_FAILED) {
+            addr_ = nullptr;
+            Log::error() << "mmap(" << path << ')' << Log::syserr << std::endl;
+            throw FailedSystemCall("mmap");
+        }
+
+        ::memcpy(&header, addr_, sizeof(Header));
+        validate(header);
+
+        check(size_ == (nblocks_ + 1) * blockSize, "truncated file");
+        blocks_ = reinterpret_cast<Block*>(static_cast<char*>(addr_) + blockSize);
+    }
+    else {
+        FileHandle dh(path);
+        dh.openForRead();
+        auto c = closer(dh);
+
+        Block first;
+        check(dh.read(&first, blockSize) == static_cast<long>(blockSize), "not a Bloom filter file");
+        ::memcpy(&header, &first, sizeof(Header));
+        validate(header);
+
+        storage_.resize(nblocks_);
+        blocks_ = storage_.data();
+
+        const auto length = static_cast<long>(nblocks_ * blockSize);
+        check(dh.read(blocks_, length) == length, "truncated file");
+    }
+
+    Log::debug<LibEcKit>() << "BlockedBloomFilter: " << (mapped ? "mapped " : "loaded ") << path << ": " << *this
+                           << std::endl;
+}
+
+
+BlockedBloomFilter::~BlockedBloomFilter() {
+    if (addr_ != nullptr) {
+        MMap::munmap(addr_, size_);
+    }
+}
+
+
+void BlockedBloomFilter::setup(size_t nblocks, size_t hashes) {
+    // n.b. block() maps the 32 high bits of the hash onto the blocks
+    ASSERT(0 < nblocks && nblocks <= (size_t(1) << 32));
+
+    nblocks_ = nblocks;
+    hashes_  = hashes;
+
+    storage_.assign(nblocks_, Block{});
+    blocks_ = storage_.data();
+}
+
+
+void BlockedBloomFilter::checkWritable() const {
+    if (mapped()) {
+        throw UserError("BlockedBloomFilter: cannot modify a memory mapped filter");
+    }
+}
+
+
+size_t BlockedBloomFilter::block(std::uint64_t hash) const {
+    // Multiply-shift range reduction, avoiding a division
+    return static_cast<size_t>(((hash >> 32) * nblocks_) >> 32);
+}
+
+
+void BlockedBloomFilter::insertHash(std::uint64_t hash) {
+    checkWritable();
+
+    std::uint64_t* w = blocks_[block(hash)].words_;
+    forEachBit(hash, hashes_, [w](size_t word, std::uint64_t mask) { w[word] |= mask; });
+    entries_++;
+}
+
+
+bool BlockedBloomFilter::containsHash(std::uint64_t hash) const {
+    const std::uint64_t* w = blocks_[block(hash)].words_;
+
+    // n.b. gather the bits into a block-sized mask, and compare in one go
+    std::uint64_t m[words] = {};
+    forEachBit(hash, hashes_, [&m](size_t word, std::uint64_t mask) { m[word] |= mask; });
+
+    bool found = true;
+    for (size_t i = 0; i < words; ++i) {
+        found &= (w[i] & m[i]) == m[i];
+    }
+    return found;
+}
+
+
+void BlockedBloomFilter::insertHashes(const std::uint64_t* hashes, size_t n) {
+    checkWritable();
+
+    size_t idx[batch];
+    for (size_t i = 0; i < n; i += batch) {
+        const size_t end = std::min(n, i + batch);
+
+        for (size_t j = i; j < end; ++j) {
+            idx[j - i] = block(hashes[j]);
+            prefetch(blocks_ + idx[j - i]);
+        }
+
+        for (size_t j = i; j < end; ++j) {
+            std::uint64_t* w = blocks_[idx[j - i]].words_;
+            forEachBit(hashes[j], hashes_, [w](size_t word, std::uint64_t mask) { w[word] |= mask; });
+        }
+    }
+
+    entries_ += n;
+}
+
+
+void BlockedBloomFilter::containsHashes(const std::uint64_t* hashes, size_t n, bool* result) const {
+    for (size_t i = 0; i < n; i += batch) {
+        const size_t end = std::min(n, i + batch);
+
+        for (size_t j = i; j < end; ++j) {
+            prefetch(blocks_ + block(hashes[j]));
+        }
+
+        for (size_t j = i; j < end; ++j) {
+            result[j] = containsHash(hashes[j]);
+        }
+    }
+}
+
+
+void BlockedBloomFilter::merge(const BlockedBloomFilter& other) {
+    checkWritable();
+    ASSERT_MSG(nblocks_ == other.nblocks_ && hashes_ == other.hashes_,
+               "BlockedBloomFilter: merge requires filters of the same size and number of hashes");
+
+    for (size_t b = 0; b < nblocks_; ++b) {
+        for (size_t i = 0; i < words; ++i) {
+            blocks_[b].words_[i] |= other.blocks_[b].words_[i];
+        }
+    }
+
+    entries_ += other.entries_;
+}
+
+
+void BlockedBloomFilter::clear() {
+    checkWritable();
+    std::fill(storage_.begin(), storage_.end(), Block{});
+    entries_ = 0;
+}
+
+
+void BlockedBloomFilter::save(const PathName& path) const {
+    static_assert(sizeof(Header) <= blockSize, "Header should fit in a block");
+
+    // n.b. the header is padded to a block, so that the blocks are aligned when the file is mapped
+    Block first{};
+    Header header;
+    ::memset(&header, 0, sizeof(Header));
+
+    ::memcpy(header.magic_, magic, sizeof(magic));
+    header.version_      = version;
+    header.order_        = byteOrderMark;
+    header.hashes_       = static_cast<std::uint32_t>(hashes_);
+    header.hashFunction_ = hashFunction();
+    header.blocks_       = nblocks_;
+    header.entries_      = entries_;
+    ::memcpy(&first, &header, sizeof(Header));
+
+    PathName tmp = PathName::unique(path);
+    {
+        FileHandle dh(tmp);
+        dh.openForWrite((nblocks_ + 1) * blockSize);
+        auto c = closer(dh);
+
+        write(dh, &first, blockSize);
+        write(dh, blocks_, nblocks_ * blockSize);
+    }
+
+    PathName::rename(tmp, path);
+}
+
+
+double BlockedBloomFilter::falsePositiveRate() const {
+    const auto k = static_cast<double>(hashes_);
+    return std::pow(1. - std::exp(-k * static_cast<double>(entries_) / static_cast<double>(bits())), k);
+}
+
+
+void BlockedBloomFilter::print(std::ostream& s) const {
+    s << "BlockedBloomFilter(size=" << Bytes(double(nblocks_ * blockSize)) << ",hashes=" << hashes_
+      << ",entries=" << entries_ << ",mapped=" << mapped() << ")";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
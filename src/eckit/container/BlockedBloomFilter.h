@@ -0,0 +1,212 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "eckit/filesystem/PathName.h"
+#include "eckit/memory/NonCopyable.h"
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Hash of the values inserted into a BlockedBloomFilter, specialise for other types
+template <typename T, typename = void>
+struct BloomFilterHash;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Bloom filter with the bits of each value in a single cache line (block), so an insertion or a lookup touches
+/// one cache line whatever the number of hashes.
+///
+/// Values are hashed once (64-bit xxHash, if available); the block and the k bits within it are derived from that
+/// hash by double hashing. The filter is sized from the expected number of values and the target false positive
+/// rate. Blocking makes the false positive rate slightly higher than that of a classic Bloom filter of the same size.
+///
+/// The bit array can be saved to a file, then loaded or memory mapped (read-only) from it.
+class BlockedBloomFilter : private NonCopyable {
+
+public:  // types
+    static constexpr size_t blockSize = 64;  ///< bytes, a cache line
+    static constexpr size_t blockBits = blockSize * 8;
+
+    struct alignas(blockSize) Block {
+        std::uint64_t words_[blockSize / sizeof(std::uint64_t)];
+    };
+
+    struct Header {
+        char magic_[8];               ///< "ECKITBLF"
+        std::uint32_t version_;       ///< format version
+        std::uint32_t order_;         ///< byte order mark, reads 0x01020304 on a machine of the same byte order
+        std::uint32_t hashes_;        ///< number of bits set per value
+        std::uint32_t hashFunction_;  ///< see hashFunction()
+        std::uint64_t blocks_;
+        std::uint64_t entries_;
+    };
+
+public:  // class methods
+    static constexpr std::uint32_t version = 1;
+
+    /// 64-bit hash of a buffer, as used by the filter
+    static std::uint64_t hash(const void* buffer, size_t length);
+
+    /// @returns identifier of the hash function, the filters of different hash functions are not compatible
+    static std::uint32_t hashFunction();
+
+public:  // methods
+    /// @param capacity expected number of values
+    /// @param falsePositiveRate target false positive rate, at capacity
+    explicit BlockedBloomFilter(size_t capacity, double falsePositiveRate = 0.01);
+
+    /// Load a filter written by save()
+    /// @param mapped map the file read-only (no insertions possible) rather than read it
+    explicit BlockedBloomFilter(const PathName&, bool mapped = false);
+
+    ~BlockedBloomFilter();
+
+    template <typename T, typename H = BloomFilterHash<T>>
+    void insert(const T& value) {
+        insertHash(H()(value));
+    }
+
+    template <typename T, typename H = BloomFilterHash<T>>
+    bool contains(const T& value) const {
+        return containsHash(H()(value));
+    }
+
+    /// n.b. C strings are hashed like std::string
+    void insert(const char* value);
+    bool contains(const char* value) const;
+
+    /// Insert a range of values, in batches (the cache lines of a batch are prefetched)
+    template <typename It, typename H = BloomFilterHash<typename std::iterator_traits<It>::value_type>>
+    void insert(It begin, It end) {
+        std::uint64_t hashes[batch];
+        while (begin != end) {
+            size_t n = 0;
+            for (; n < batch && begin != end; ++n, ++begin) {
+                hashes[n] = H()(*begin);
+            }
+            insertHashes(hashes, n);
+        }
+    }
+
+    /// Look up a range of values, in batches, setting result[i] for the i-th value
+    template <typename It, typename H = BloomFilterHash<typename std::iterator_traits<It>::value_type>>
+    void contains(It begin, It end, bool* result) const {
+        std::uint64_t hashes[batch];
+        while (begin != end) {
+            size_t n = 0;
+            for (; n < batch && begin != end; ++n, ++begin) {
+                hashes[n] = H()(*begin);
+            }
+            containsHashes(hashes, n, result);
+            result += n;
+        }
+    }
+
+    void insertHash(std::uint64_t);
+    bool containsHash(std::uint64_t) const;
+
+    void insertHashes(const std::uint64_t*, size_t n);
+    void containsHashes(const std::uint64_t*, size_t n, bool* result) const;
+
+    /// Union, with a filter of the same size and number of hashes
+    void merge(const BlockedBloomFilter&);
+
+    void clear();
+
+    void save(const PathName&) const;
+
+    bool empty() const { return entries_ == 0; }
+
+    /// @returns number of insertions (an upper bound of the number of distinct values)
+    size_t entries() const { return entries_; }
+
+    /// @returns size of the bit array, in bits
+    size_t bits() const { return nblocks_ * blockBits; }
+
+    /// @returns number of bits set per value
+    size_t hashes() const { return hashes_; }
+
+    /// @returns expected false positive rate, for the current number of entries
+    double falsePositiveRate() const;
+
+    bool mapped() const { return addr_ != nullptr; }
+
+private:  // methods
+    static constexpr size_t batch = 32;
+
+    void print(std::ostream&) const;
+
+    size_t block(std::uint64_t hash) const;
+
+    void setup(size_t nblocks, size_t hashes);
+
+    void checkWritable() const;
+
+private:  // members
+    std::vector<Block> storage_;
+    Block* blocks_;
+    size_t nblocks_;
+    size_t hashes_;
+    size_t entries_;
+
+    void* addr_;
+    size_t size_;
+
+private:  // friends
+    friend std::ostream& operator<<(std::ostream& s, const BlockedBloomFilter& p) {
+        p.print(s);
+        return s;
+    }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <>
+struct BloomFilterHash<std::string> {
+    std::uint64_t operator()(const std::string& value) const {
+        return BlockedBloomFilter::hash(value.data(), value.size());
+    }
+};
+
+template <>
+struct BloomFilterHash<const char*> {
+    std::uint64_t operator()(const char* value) const { return BlockedBloomFilter::hash(value, std::strlen(value)); }
+};
+
+inline void BlockedBloomFilter::insert(const char* value) {
+    insert<const char*>(value);
+}
+
+inline bool BlockedBloomFilter::contains(const char* value) const {
+    return contains<const char*>(value);
+}
+
+/// Values without padding (e.g. integers), hashed by their bytes
+template <typename T>
+struct BloomFilterHash<T, std::enable_if_t<std::has_unique_object_representations_v<T>>> {
+    std::uint64_t operator()(const T& value) const { return BlockedBloomFilter::hash(&value, sizeof(T)); }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
@@ -27,6 +27,7 @@ namespace eckit {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+/// Bloom filter with a single hash (MD5) per value, see BlockedBloomFilter for a faster and more accurate filter
 template <typename T>
 class BloomFilter : private NonCopyable {
 
@@ -45,6 +46,8 @@ protected:  // methods
     void print(std::ostream&) const;
 
 private:  // members
+    static constexpr size_t bitsPerElement = sizeof(data_type) * 8;
+
     static size_t elementCount(size_t nbits);
 
     /// Which bit should we be considering?
@@ -23,6 +23,7 @@
 
 #include "eckit/config/LibEcKit.h"
 #include "eckit/config/Resource.h"
+#include "eckit/container/ConcurrentCacheLRU.h"
 #include "eckit/eckit.h"
 #include "eckit/filesystem/PathExpander.h"
 #include "eckit/filesystem/PathName.h"
@@ -132,13 +133,30 @@ public:  // methods
 
     typedef std::string key_t;
 
+    struct MemoryCacheEntry {
+        PathName path_;
+        value_type value_;
+    };
+
+    typedef ConcurrentCacheLRU<key_t, MemoryCacheEntry> MemoryCache;
+
 public:  // methods
     explicit CacheManager(const std::string& loaderName, const std::string& roots, bool throwOnCacheMiss,
                           size_t maxCacheSize);
 
     PathName getOrCreate(const key_t& key, CacheContentCreator& creator, value_type& value) const;
 
+    /// Keep the values in memory as well, in front of the files, in a thread-safe cache bounded by capacity in the
+    /// units of size (e.g. bytes; if size is not given, in number of values). To be set up before getOrCreate().
+    /// @note value_type should be cheap to copy (e.g. a std::shared_ptr), as the values are copied in and out
+    void memoryCache(size_t capacity, std::function<size_t(const value_type&)> size = nullptr, size_t shards = 0);
+
+    /// @returns the in-memory cache (e.g. for its statistics), nullptr if not set up
+    const MemoryCache* memoryCache() const { return memory_.get(); }
+
 private:  // methods
+    PathName getOrCreateFile(const key_t& key, CacheContentCreator& creator, value_type& value) const;
+
     bool get(const key_t& key, PathName& path) const;
 
     PathName stage(const key_t& key, const PathName& root) const;
@@ -152,6 +170,8 @@ private:  // members
     std::vector<PathName> roots_;
 
     bool throwOnCacheMiss_;
+
+    std::unique_ptr<MemoryCache> memory_;
 };
 
 
@@ -275,9 +295,39 @@ bool CacheManager<Traits>::commit(const key_t& key, const PathName& tmpfile, con
     return true;
 }
 
+template <class Traits>
+void CacheManager<Traits>::memoryCache(size_t capacity, std::function<size_t(const value_type&)> size,
+                                       size_t shards) {
+    typename MemoryCache::size_function_type entrySize;
+    if (size) {
+        entrySize = [size](const key_t&, const MemoryCacheEntry& entry) { return size(entry.value_); };
+    }
+    memory_.reset(new MemoryCache(capacity, entrySize, shards));
+}
+
 template <class Traits>
 PathName CacheManager<Traits>::getOrCreate(const key_t& key, CacheContentCreator& creator, value_type& value) const {
 
+    if (!memory_) {
+        return getOrCreateFile(key, creator, value);
+    }
+
+    MemoryCacheEntry entry;
+    if (memory_->find(key, entry)) {
+        Log::debug<LibEcKit>() << "CACHE-MANAGER " << Traits::name() << ", found in memory " << key << std::endl;
+        value = entry.value_;
+        return entry.path_;
+    }
+
+    PathName path = getOrCreateFile(key, creator, value);
+    memory_->insert(key, {path, value});
+    return path;
+}
+
+template <class Traits>
+PathName CacheManager<Traits>::getOrCreateFile(const key_t& key, CacheContentCreator& creator,
+                                               value_type& value) const {
+
     PathName path;
 
     if (get(key, path)) {
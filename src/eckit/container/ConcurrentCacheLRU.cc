@@ -0,0 +1,277 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "eckit/container/ConcurrentCacheLRU.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <thread>
+
+#include "eckit/thread/AutoLock.h"
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V, typename H>
+ConcurrentCacheLRU<K, V, H>::ConcurrentCacheLRU(size_t capacity, size_function_type size, size_t shards,
+                                                purge_handler_type purge) :
+    sizeFunction_(size ? std::move(size) : size_function_type([](const key_type&, const value_type&) -> size_t {
+        return 1;
+    })),
+    purge_(std::move(purge)),
+    mask_(0),
+    capacity_(capacity),
+    size_(0),
+    tick_(0) {
+
+    if (shards == 0) {
+        shards = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    size_t n = 1;
+    while (n < shards) {
+        n <<= 1;
+    }
+
+    mask_ = n - 1;
+    shards_.reset(new Shard[n]);
+}
+
+template <typename K, typename V, typename H>
+ConcurrentCacheLRU<K, V, H>::~ConcurrentCacheLRU() {
+    clear();
+}
+
+template <typename K, typename V, typename H>
+bool ConcurrentCacheLRU<K, V, H>::insert(const key_type& key, const value_type& value) {
+    value_type copy(value);
+    return insert(key, copy, true);
+}
+
+template <typename K, typename V, typename H>
+bool ConcurrentCacheLRU<K, V, H>::insert(const key_type& key, value_type& value, bool overwrite) {
+    const size_t size = sizeFunction_(key, value);
+
+    bool existed = false;
+
+    // n.b. declared before the lock, so the values are destroyed without holding it
+    storage_type replaced;
+    storage_type evicted;
+
+    {
+        Shard& s = shard(key);
+        AutoLock<Mutex> lock(s.mutex_);
+
+        auto itr = s.map_.find(key);
+        if (itr != s.map_.end()) {
+            existed = true;
+
+            if (!overwrite) {
+                // keep the cached entry, and make it the most recently used
+                itr->second->used_ = tick_.fetch_add(1, std::memory_order_relaxed);
+                s.storage_.splice(s.storage_.begin(), s.storage_, itr->second);
+                value = itr->second->value_;
+                return true;
+            }
+
+            // erase the key from where it is, we'll reinsert it again so it comes on top
+            size_.fetch_sub(itr->second->size_, std::memory_order_relaxed);
+            replaced.splice(replaced.end(), s.storage_, itr->second);
+            s.map_.erase(itr);
+            ++s.statistics_.replacements_;
+        }
+
+        if (size > capacity()) {
+            ++s.statistics_.evictions_;
+        }
+        else {
+            s.storage_.push_front(Entry{key, value, size, tick_.fetch_add(1, std::memory_order_relaxed)});
+            s.map_[key] = s.storage_.begin();
+            size_.fetch_add(size, std::memory_order_relaxed);
+            ++s.statistics_.insertions_;
+        }
+    }
+
+    trim(evicted);
+    purge(evicted);
+
+    return existed;
+}
+
+template <typename K, typename V, typename H>
+bool ConcurrentCacheLRU<K, V, H>::find(const key_type& key, value_type& value) {
+    Shard& s = shard(key);
+    AutoLock<Mutex> lock(s.mutex_);
+
+    auto itr = s.map_.find(key);
+    if (itr == s.map_.end()) {
+        ++s.statistics_.misses_;
+        return false;
+    }
+
+    ++s.statistics_.hits_;
+
+    // move entry of list to front, this keeps the most popular in front
+    itr->second->used_ = tick_.fetch_add(1, std::memory_order_relaxed);
+    s.storage_.splice(s.storage_.begin(), s.storage_, itr->second);
+
+    value = itr->second->value_;
+    return true;
+}
+
+template <typename K, typename V, typename H>
+V ConcurrentCacheLRU<K, V, H>::access(const key_type& key) {
+    value_type value;
+    if (!find(key, value)) {
+        throw OutOfRange("key not in ConcurrentCacheLRU", Here());
+    }
+    return value;
+}
+
+template <typename K, typename V, typename H>
+bool ConcurrentCacheLRU<K, V, H>::remove(const key_type& key) {
+    storage_type removed;
+
+    {
+        Shard& s = shard(key);
+        AutoLock<Mutex> lock(s.mutex_);
+
+        auto itr = s.map_.find(key);
+        if (itr == s.map_.end()) {
+            return false;
+        }
+
+        size_.fetch_sub(itr->second->size_, std::memory_order_relaxed);
+        removed.splice(removed.end(), s.storage_, itr->second);
+        s.map_.erase(itr);
+    }
+
+    purge(removed);
+    return true;
+}
+
+template <typename K, typename V, typename H>
+bool ConcurrentCacheLRU<K, V, H>::exists(const key_type& key) const {
+    Shard& s = shard(key);
+    AutoLock<Mutex> lock(s.mutex_);
+    return s.map_.find(key) != s.map_.end();
+}
+
+template <typename K, typename V, typename H>
+void ConcurrentCacheLRU<K, V, H>::clear() {
+    storage_type removed;
+
+    for (size_t i = 0; i <= mask_; ++i) {
+        Shard& s = shards_[i];
+        AutoLock<Mutex> lock(s.mutex_);
+
+        for (const auto& entry : s.storage_) {
+            size_.fetch_sub(entry.size_, std::memory_order_relaxed);
+        }
+
+        removed.splice(removed.end(), s.storage_);
+        s.map_.clear();
+    }
+
+    purge(removed);
+}
+
+template <typename K, typename V, typename H>
+void ConcurrentCacheLRU<K, V, H>::capacity(size_t size) {
+    capacity_.store(size, std::memory_order_relaxed);
+
+    storage_type evicted;
+    trim(evicted);
+    purge(evicted);
+}
+
+template <typename K, typename V, typename H>
+size_t ConcurrentCacheLRU<K, V, H>::entries() const {
+    size_t n = 0;
+    for (size_t i = 0; i <= mask_; ++i) {
+        AutoLock<Mutex> lock(shards_[i].mutex_);
+        n += shards_[i].map_.size();
+    }
+    return n;
+}
+
+template <typename K, typename V, typename H>
+typename ConcurrentCacheLRU<K, V, H>::Statistics ConcurrentCacheLRU<K, V, H>::statistics() const {
+    Statistics total;
+    for (size_t i = 0; i <= mask_; ++i) {
+        AutoLock<Mutex> lock(shards_[i].mutex_);
+        const auto& s = shards_[i].statistics_;
+        total.hits_ += s.hits_;
+        total.misses_ += s.misses_;
+        total.insertions_ += s.insertions_;
+        total.evictions_ += s.evictions_;
+        total.replacements_ += s.replacements_;
+    }
+    return total;
+}
+
+template <typename K, typename V, typename H>
+void ConcurrentCacheLRU<K, V, H>::trim(storage_type& evicted) {
+    while (size() > capacity()) {
+
+        // the least recently used entry is the oldest of the least recently used entries of the shards
+        // n.b. only one lock is held at a time, so another thread may use the entry meanwhile: it is then
+        //      still evicted, as it was the least recently used when we looked
+
+        Shard* victim        = nullptr;
+        std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+
+        for (size_t i = 0; i <= mask_; ++i) {
+            Shard& s = shards_[i];
+            AutoLock<Mutex> lock(s.mutex_);
+            if (!s.storage_.empty() && s.storage_.back().used_ < oldest) {
+                oldest = s.storage_.back().used_;
+                victim = &s;
+            }
+        }
+
+        if (victim == nullptr) {
+            return;
+        }
+
+        AutoLock<Mutex> lock(victim->mutex_);
+        if (victim->storage_.empty()) {
+            continue;
+        }
+
+        auto last = std::prev(victim->storage_.end());
+        size_.fetch_sub(last->size_, std::memory_order_relaxed);
+        victim->map_.erase(last->key_);
+        evicted.splice(evicted.end(), victim->storage_, last);
+        ++victim->statistics_.evictions_;
+    }
+}
+
+template <typename K, typename V, typename H>
+void ConcurrentCacheLRU<K, V, H>::purge(storage_type& entries) const {
+    if (purge_) {
+        for (auto& entry : entries) {
+            purge_(entry.key_, entry.value_);
+        }
+    }
+}
+
+template <typename K, typename V, typename H>
+void ConcurrentCacheLRU<K, V, H>::print(std::ostream& os) const {
+    os << "ConcurrentCacheLRU(capacity=" << capacity() << ",size=" << size() << ",entries=" << entries()
+       << ",shards=" << shards() << "," << statistics() << ")";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
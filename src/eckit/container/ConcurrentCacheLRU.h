@@ -0,0 +1,192 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#ifndef eckit_container_ConcurrentCacheLRU_h
+#define eckit_container_ConcurrentCacheLRU_h
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/CodeLocation.h"
+#include "eckit/memory/NonCopyable.h"
+#include "eckit/thread/Mutex.h"
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Thread-safe LRU cache, bounded by the total size of its entries as given by a size function (e.g. in bytes).
+///
+/// The entries are spread over shards by hash of the key, each with its own lock, so that threads accessing
+/// different keys seldom contend. The capacity is global: when it is exceeded, the least recently used entry
+/// of all shards is evicted (comparing the least recently used entry of each shard), so a few large entries can
+/// use the whole capacity.
+///
+/// Values are copied in and out of the cache, use e.g. a std::shared_ptr for large values. Evicted values are
+/// purged and destroyed outside of the locks.
+
+template <typename K, typename V, typename Hash = std::hash<K>>
+class ConcurrentCacheLRU : private NonCopyable {
+
+public:  // types
+    using key_type   = K;
+    using value_type = V;
+
+    /// @returns size of an entry, in the units of the capacity
+    using size_function_type = std::function<size_t(const key_type&, const value_type&)>;
+
+    /// Called on entries leaving the cache (evicted, removed or cleared)
+    using purge_handler_type = std::function<void(const key_type&, value_type&)>;
+
+    struct Statistics {
+        size_t hits_         = 0;
+        size_t misses_       = 0;
+        size_t insertions_   = 0;
+        size_t evictions_    = 0;  ///< entries evicted to respect the capacity, or too large to be cached
+        size_t replacements_ = 0;  ///< entries overwritten by the insertion of the same key
+
+        friend std::ostream& operator<<(std::ostream& s, const Statistics& p) {
+            s << "hits=" << p.hits_ << ",misses=" << p.misses_ << ",insertions=" << p.insertions_
+              << ",evictions=" << p.evictions_ << ",replacements=" << p.replacements_;
+            return s;
+        }
+    };
+
+public:  // methods
+    /// @param capacity maximum total size of the entries
+    /// @param size size function, if not given every entry has size 1 (i.e. capacity in number of entries)
+    /// @param shards number of shards, rounded up to a power of 2 (if 0, from the hardware concurrency)
+    explicit ConcurrentCacheLRU(size_t capacity, size_function_type size = nullptr, size_t shards = 0,
+                                purge_handler_type purge = nullptr);
+
+    ~ConcurrentCacheLRU();
+
+    /// Inserts an entry into the cache, overwrites if already exists
+    /// @note an entry larger than the capacity is not cached (and counts as evicted)
+    /// @returns true if a key already existed
+    bool insert(const key_type& key, const value_type& value);
+
+    /// Looks up a key, making it the most recently used
+    /// @returns true (and sets value) if the key is in the cache
+    bool find(const key_type& key, value_type& value);
+
+    /// Accesses a key that must already exist
+    /// @throws OutOfRange exception is key not in cache
+    value_type access(const key_type& key);
+
+    /// Looks up a key, or inserts the value returned by create() if not in the cache
+    /// @note create() is called without holding any lock, so concurrent misses on the same key may all create it,
+    ///       but only the first one is cached and returned to all
+    template <typename F>
+    value_type getOrCreate(const key_type& key, F create) {
+        value_type value;
+        if (!find(key, value)) {
+            value = create();
+            insert(key, value, false);
+        }
+        return value;
+    }
+
+    /// Remove a key-value pair from the cache
+    /// No effect if key is not present
+    ///
+    /// @return true if removed
+    bool remove(const key_type& key);
+
+    /// @returns true if the key exists in the cache
+    bool exists(const key_type& key) const;
+
+    /// Clears all entries in the cache
+    void clear();
+
+    /// @returns the maximum total size of the entries
+    size_t capacity() const { return capacity_.load(std::memory_order_relaxed); }
+
+    /// resizes the cache capacity
+    void capacity(size_t size);
+
+    /// @returns the current total size of the entries
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    /// @returns the number of entries
+    size_t entries() const;
+
+    /// @returns number of shards
+    size_t shards() const { return mask_ + 1; }
+
+    /// @returns the counters, summed over the shards
+    Statistics statistics() const;
+
+    void print(std::ostream& os) const;
+
+    friend std::ostream& operator<<(std::ostream& s, const ConcurrentCacheLRU& p) {
+        p.print(s);
+        return s;
+    }
+
+private:  // types
+    struct Entry {
+        key_type key_;
+        value_type value_;
+        size_t size_;
+        std::uint64_t used_;  ///< tick of the last use
+    };
+
+    using storage_type = std::list<Entry>;
+    using map_type     = std::unordered_map<key_type, typename storage_type::iterator, Hash>;
+
+    struct Shard {
+        mutable Mutex mutex_;
+        storage_type storage_;  ///< most recently used first
+        map_type map_;
+        Statistics statistics_;
+    };
+
+private:  // methods
+    /// n.b. the hash is mixed, so that the keys of a shard don't share the low bits of their hash
+    Shard& shard(const key_type& key) const {
+        return shards_[((static_cast<std::uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ULL) >> 32) & mask_];
+    }
+
+    /// Inserts an entry into the cache, if the key already exists overwrites it or (if not overwrite) sets value to
+    /// the cached one
+    /// @returns true if a key already existed
+    bool insert(const key_type& key, value_type& value, bool overwrite);
+
+    /// Evicts least recently used entries until within capacity, into evicted
+    void trim(storage_type& evicted);
+
+    void purge(storage_type& entries) const;
+
+private:  // members
+    size_function_type sizeFunction_;
+    purge_handler_type purge_;
+
+    size_t mask_;
+    std::unique_ptr<Shard[]> shards_;
+
+    std::atomic<size_t> capacity_;
+    std::atomic<size_t> size_;
+    std::atomic<std::uint64_t> tick_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
+
+#include "ConcurrentCacheLRU.cc"
+
+#endif
@@ -0,0 +1,332 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#ifndef KDBuckets_H
+#define KDBuckets_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/memory/NonCopyable.h"
+#include "eckit/thread/ParallelFor.h"
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Static KD-tree for batches of nearest neighbour and radius queries.
+///
+/// Unlike KDTreeX, the leaves hold buckets of up to bucketSize points, and the coordinates are stored as a
+/// structure of arrays (one array per axis) in the order of the leaves, so that the distances to the points of a
+/// bucket are computed by a loop that vectorises. The tree is immutable once built, so it can be queried from
+/// several threads; the batch queries share the query points out to threads, each reusing its scratch buffers.
+///
+/// Results refer to the points by their index in the tree (see point() and payload()), with their distance.
+template <class Traits>
+class KDBuckets : private NonCopyable {
+public:
+    typedef typename Traits::Point Point;
+    typedef typename Traits::Payload Payload;
+
+    static constexpr size_t DIMS = Point::DIMS;
+
+    struct Result {
+        size_t index_;
+        double distance_;
+
+        bool operator<(const Result& other) const { return distance_ < other.distance_; }
+    };
+
+    typedef std::vector<Result> ResultList;
+
+public:
+    explicit KDBuckets(size_t bucketSize = 32) :
+        bucketSize_(bucketSize) {
+        ASSERT(bucketSize_ > 0);
+    }
+
+    /// Build from values (with point() and payload()), which are copied
+    template <typename ITER>
+    void build(ITER begin, ITER end, size_t threads = 0) {
+        std::vector<std::pair<Point, Payload>> values;
+        for (ITER i = begin; i != end; ++i) {
+            values.emplace_back(i->point(), i->payload());
+        }
+
+        partition(values, threads);
+
+        for (size_t d = 0; d < DIMS; ++d) {
+            coords_[d].resize(values.size());
+            for (size_t i = 0; i < values.size(); ++i) {
+                coords_[d][i] = values[i].first.x(d);
+            }
+        }
+
+        payloads_.clear();
+        payloads_.reserve(values.size());
+        for (const auto& v : values) {
+            payloads_.push_back(v.second);
+        }
+    }
+
+    template <typename Container>
+    void build(const Container& c, size_t threads = 0) {
+        build(c.begin(), c.end(), threads);
+    }
+
+    size_t size() const { return payloads_.size(); }
+    bool empty() const { return payloads_.empty(); }
+
+    Point point(size_t index) const {
+        double x[DIMS];
+        for (size_t d = 0; d < DIMS; ++d) {
+            x[d] = coords_[d][index];
+        }
+        return Point(x);
+    }
+
+    const Payload& payload(size_t index) const { return payloads_[index]; }
+
+    /// The k nearest points, sorted by distance, into result
+    void kNearestNeighbours(const Point& p, size_t k, ResultList& result) const {
+        Scratch scratch;
+        kNearestNeighbours(p, k, result, scratch);
+    }
+
+    /// The points within radius, sorted by distance, into result
+    void findInSphere(const Point& p, double radius, ResultList& result) const {
+        Scratch scratch;
+        findInSphere(p, radius, result, scratch);
+    }
+
+    /// The k nearest points of each of the n points, over threads (0: as many as the workers, see parallelFor)
+    void kNearestNeighbours(const Point* points, size_t n, size_t k, std::vector<ResultList>& results,
+                            size_t threads = 0) const {
+        batch(n, results, threads, [=](size_t i, ResultList& result, Scratch& scratch) {
+            kNearestNeighbours(points[i], k, result, scratch);
+        });
+    }
+
+    /// The points within radius of each of the n points, over threads (0: as many as the workers)
+    void findInSphere(const Point* points, size_t n, double radius, std::vector<ResultList>& results,
+                      size_t threads = 0) const {
+        batch(n, results, threads, [=](size_t i, ResultList& result, Scratch& scratch) {
+            findInSphere(points[i], radius, result, scratch);
+        });
+    }
+
+private:
+    /// Inner node (splitting along axis_ at split_, children at index + 1 and right_), or leaf (axis_ == DIMS)
+    /// of the points [begin_, end_)
+    struct Node {
+        double split_;
+        size_t axis_;
+        size_t right_;
+        size_t begin_;
+        size_t end_;
+    };
+
+    /// Buffers of a thread, reused from query to query
+    struct Scratch {
+        std::vector<double> distances_;
+    };
+
+    /// Queries per task
+    static constexpr size_t chunk = 256;
+
+    /// Below this size, a range is partitioned by a single task
+    static constexpr size_t grain = 1 << 16;
+
+    bool leaf(size_t n) const { return n <= bucketSize_; }
+
+    /// Number of nodes of a tree over n values
+    size_t countNodes(size_t n) const { return leaf(n) ? 1 : 1 + countNodes(n / 2) + countNodes(n - n / 2); }
+
+    /// Reorder the values so that each inner node range is split at its middle (along the axis of its depth), and
+    /// set up the nodes, in pre-order
+    void partition(std::vector<std::pair<Point, Payload>>& values, size_t threads) {
+        nodes_.assign(values.empty() ? 0 : countNodes(values.size()), Node{});
+        if (values.empty()) {
+            return;
+        }
+
+        if (values.size() <= grain) {
+            threads = 1;
+        }
+
+        auto first = values.begin();
+        parallelTasks(threads, [&](TaskGroup* group) { partition(first, first, values.end(), 0, 0, group); });
+    }
+
+    template <typename ITER>
+    void partition(ITER first, ITER begin, ITER end, size_t index, size_t depth, TaskGroup* group) {
+        const auto n = size_t(end - begin);
+
+        // n.b. tasks set up distinct nodes
+        Node& node  = nodes_[index];
+        node.begin_ = size_t(begin - first);
+        node.end_   = size_t(end - first);
+        node.axis_  = DIMS;
+
+        if (leaf(n)) {
+            return;
+        }
+
+        const size_t axis = depth % DIMS;
+        ITER middle       = begin + n / 2;
+
+        std::nth_element(begin, middle, end, [axis](const std::pair<Point, Payload>& a,
+                                                    const std::pair<Point, Payload>& b) {
+            return a.first.x(axis) < b.first.x(axis);
+        });
+
+        node.axis_  = axis;
+        node.split_ = middle->first.x(axis);
+        node.right_ = index + 1 + countNodes(n / 2);
+
+        if (group != nullptr && n > grain) {
+            group->run([=]() { partition(first, begin, middle, index + 1, depth + 1, group); });
+        }
+        else {
+            partition(first, begin, middle, index + 1, depth + 1, group);
+        }
+        partition(first, middle, end, node.right_, depth + 1, group);
+    }
+
+    /// Squared distances from p to the points of a leaf, into scratch
+    const double* distances(const Node& node, const Point& p, Scratch& scratch) const {
+        const size_t n = node.end_ - node.begin_;
+        if (scratch.distances_.size() < n) {
+            scratch.distances_.resize(n);
+        }
+
+        double* d2 = scratch.distances_.data();
+        std::fill(d2, d2 + n, 0.);
+
+        for (size_t d = 0; d < DIMS; ++d) {
+            const double* x = coords_[d].data() + node.begin_;
+            const double pd = p.x(d);
+            for (size_t i = 0; i < n; ++i) {
+                const double dx = x[i] - pd;
+                d2[i] += dx * dx;
+            }
+        }
+
+        return d2;
+    }
+
+    void kNearestNeighbours(const Point& p, size_t k, ResultList& result, Scratch& scratch) const {
+        result.clear();
+        if (k == 0 || nodes_.empty()) {
+            return;
+        }
+
+        // n.b. result is a max-heap of squared distances while searching
+        kNearestNeighbours(0, p, k, result, scratch);
+
+        std::sort_heap(result.begin(), result.end());
+        for (auto& r : result) {
+            r.distance_ = std::sqrt(r.distance_);
+        }
+    }
+
+    void kNearestNeighbours(size_t index, const Point& p, size_t k, ResultList& heap, Scratch& scratch) const {
+        const Node& node = nodes_[index];
+
+        if (node.axis_ == DIMS) {
+            const double* d2 = distances(node, p, scratch);
+            for (size_t i = 0; i < node.end_ - node.begin_; ++i) {
+                if (heap.size() < k) {
+                    heap.push_back({node.begin_ + i, d2[i]});
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (d2[i] < heap.front().distance_) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = {node.begin_ + i, d2[i]};
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+            return;
+        }
+
+        const double diff = p.x(node.axis_) - node.split_;
+        const size_t near = diff < 0 ? index + 1 : node.right_;
+        const size_t far  = diff < 0 ? node.right_ : index + 1;
+
+        kNearestNeighbours(near, p, k, heap, scratch);
+        if (heap.size() < k || diff * diff < heap.front().distance_) {
+            kNearestNeighbours(far, p, k, heap, scratch);
+        }
+    }
+
+    void findInSphere(const Point& p, double radius, ResultList& result, Scratch& scratch) const {
+        result.clear();
+        if (nodes_.empty()) {
+            return;
+        }
+
+        findInSphere(0, p, radius * radius, result, scratch);
+
+        std::sort(result.begin(), result.end());
+        for (auto& r : result) {
+            r.distance_ = std::sqrt(r.distance_);
+        }
+    }
+
+    void findInSphere(size_t index, const Point& p, double r2, ResultList& result, Scratch& scratch) const {
+        const Node& node = nodes_[index];
+
+        if (node.axis_ == DIMS) {
+            const double* d2 = distances(node, p, scratch);
+            for (size_t i = 0; i < node.end_ - node.begin_; ++i) {
+                if (d2[i] <= r2) {
+                    result.push_back({node.begin_ + i, d2[i]});
+                }
+            }
+            return;
+        }
+
+        const double diff = p.x(node.axis_) - node.split_;
+        if (diff <= 0 || diff * diff <= r2) {
+            findInSphere(index + 1, p, r2, result, scratch);
+        }
+        if (diff >= 0 || diff * diff <= r2) {
+            findInSphere(node.right_, p, r2, result, scratch);
+        }
+    }
+
+    template <typename F>
+    void batch(size_t n, std::vector<ResultList>& results, size_t threads, F query) const {
+        results.resize(n);
+
+        parallelFor(n, chunk, threads, [&](size_t begin, size_t end) {
+            Scratch scratch;
+            for (size_t i = begin; i < end; ++i) {
+                query(i, results[i], scratch);
+            }
+        });
+    }
+
+private:
+    size_t bucketSize_;
+
+    std::vector<Node> nodes_;
+    std::array<std::vector<double>, DIMS> coords_;
+    std::vector<Payload> payloads_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
+
+#endif
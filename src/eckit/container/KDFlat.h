@@ -0,0 +1,116 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#ifndef KDFlat_H
+#define KDFlat_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+
+#include "eckit/container/StatCollector.h"
+#include "eckit/exception/Exceptions.h"
+
+//------------------------------------------------------------------------------------------------------
+
+namespace eckit {
+
+//------------------------------------------------------------------------------------------------------
+
+/// Allocator of the nodes of a tree in one block of memory, linked by 32-bit indices (from 1, 0 is null), so that
+/// the nodes are smaller and a search touches fewer cache lines than with KDMemory.
+///
+/// The nodes are never moved (the tree holds pointers to them while building), so room must be reserved for all
+/// of them. Deleting nodes does not release their memory, reserving room again discards them all.
+struct KDFlat : public StatCollector {
+    typedef std::uint32_t Ptr;
+
+    /// Room for n nodes, the nodes allocated so far being discarded (so that the tree can be rebuilt)
+    template <class Node>
+    void reserve(size_t n, const Node*) {
+        ASSERT(n < std::numeric_limits<Ptr>::max());
+
+        count_ = 0;
+        if (n > capacity_ || itemSize_ != sizeof(Node)) {
+            // n.b. index 0 is not used
+            storage_.reset(new char[(n + 1) * sizeof(Node)]);
+            itemSize_ = sizeof(Node);
+            capacity_ = n;
+        }
+    }
+
+    Ptr root() const { return count_ > 0 ? 1 : 0; }
+
+    void root(Ptr r) { ASSERT(r == 1); }
+
+    template <class Node>
+    Node* base(const Node*) {
+        ASSERT(sizeof(Node) == itemSize_);
+        return reinterpret_cast<Node*>(storage_.get());
+    }
+
+    template <class Node>
+    Ptr convert(Node* p) {
+        return p ? static_cast<Ptr>(p - base(p)) : 0;
+    }
+
+    template <class Node>
+    Node* convert(Ptr p, const Node* dummy) {
+        return p ? base(dummy) + p : nullptr;
+    }
+
+    template <class Node, typename A>
+    Node* newNode1(const A& a, const Node* dummy) {
+        return new (next(dummy)) Node(a);
+    }
+
+    template <class Node, typename A, typename B>
+    Node* newNode2(const A& a, const B& b, const Node* dummy) {
+        return new (next(dummy)) Node(a, b);
+    }
+
+    template <class Node, typename A, typename B, typename C>
+    Node* newNode3(const A& a, const B& b, const C& c, const Node* dummy) {
+        return new (next(dummy)) Node(a, b, c);
+    }
+
+    /// Append a node, in the order of its index (see KDNode::writeLayout)
+    template <class Node>
+    void write(const Node* node) {
+        ::memcpy(static_cast<void*>(next(node)), node, sizeof(Node));
+    }
+
+    template <class Node>
+    void deleteNode(Ptr, const Node*) {
+        // Ignore, the memory is released with the allocator
+    }
+
+    size_t nbItems() const { return count_; }
+
+private:
+    template <class Node>
+    Node* next(const Node* dummy) {
+        ASSERT(count_ < capacity_);
+        return base(dummy) + (++count_);
+    }
+
+    std::unique_ptr<char[]> storage_;
+    size_t itemSize_{0};
+    size_t capacity_{0};
+    size_t count_{0};
+};
+
+//------------------------------------------------------------------------------------------------------
+
+}  // end namespace eckit
+
+#endif
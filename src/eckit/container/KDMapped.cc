@@ -20,6 +20,7 @@
 #include <sys/types.h>
 #include <cstring>  // for memcpy
 
+#include "eckit/io/FileHandle.h"
 #include "eckit/memory/MMap.h"
 
 
@@ -137,4 +138,68 @@ void KDMapped::getMetadata(void* addr, size_t size) {
 }
 
 
+KDMappedWriter::KDMappedWriter(const PathName& path, size_t itemCount, size_t itemSize, const void* metadata,
+                               size_t metadataSize) :
+    path_(path), tmp_(PathName::unique(path)), header_(itemCount, itemSize, metadataSize), buffer_(1024 * 1024) {
+    ASSERT(itemCount > 0);
+    ASSERT(itemSize <= buffer_.size());
+    ASSERT(metadataSize == 0 || metadata != nullptr);
+
+    // As KDMapped: header, metadata, then the items (the first unused) from an offset multiple of the item size
+    size_t base = ((header_.headerSize_ + header_.metadataSize_ + header_.itemSize_ - 1) / header_.itemSize_)
+                  * header_.itemSize_;
+
+    handle_.reset(new FileHandle(tmp_));
+    handle_->openForWrite(base + (itemCount + 1) * itemSize);
+
+    std::vector<char> start(base + itemSize, 0);
+    ::memcpy(start.data(), &header_, sizeof(header_));
+    if (metadataSize > 0) {
+        ::memcpy(start.data() + sizeof(header_), metadata, metadataSize);
+    }
+
+    ASSERT(handle_->write(start.data(), long(start.size())) == long(start.size()));
+}
+
+KDMappedWriter::~KDMappedWriter() {
+    if (handle_) {
+        // Not closed: an error occurred
+        try {
+            handle_->close();
+            tmp_.unlink();
+        }
+        catch (std::exception& e) {
+            Log::error() << "KDMappedWriter: cannot clean up " << tmp_ << ": " << e.what() << std::endl;
+        }
+    }
+}
+
+void KDMappedWriter::write(const void* item) {
+    ASSERT(count_ < header_.itemCount_);
+    if (used_ + header_.itemSize_ > buffer_.size()) {
+        flush();
+    }
+    ::memcpy(buffer_.data() + used_, item, header_.itemSize_);
+    used_ += header_.itemSize_;
+    count_++;
+}
+
+void KDMappedWriter::flush() {
+    if (used_ > 0) {
+        ASSERT(handle_->write(buffer_.data(), long(used_)) == long(used_));
+        used_ = 0;
+    }
+}
+
+void KDMappedWriter::close() {
+    ASSERT(count_ == header_.itemCount_);
+    flush();
+
+    handle_->close();
+    handle_.reset();
+
+    PathName::rename(tmp_, path_);
+}
+
+
 }  // namespace eckit
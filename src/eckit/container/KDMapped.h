@@ -11,12 +11,20 @@
 #ifndef KDMapped_H
 #define KDMapped_H
 
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
 #include "eckit/container/StatCollector.h"
 #include "eckit/exception/Exceptions.h"
 #include "eckit/filesystem/PathName.h"
+#include "eckit/memory/NonCopyable.h"
 
 namespace eckit {
 
+class DataHandle;
+
 struct KDMappedHeader {
     size_t headerSize_;
     size_t itemCount_;
@@ -122,6 +130,64 @@ private:
     int fd_;
 };
 
+
+/// KDMapped with 32-bit node indices, for smaller nodes (and files)
+class KDMapped32 : public KDMapped {
+public:
+    typedef std::uint32_t Ptr;
+
+    KDMapped32(const PathName& path, size_t itemCount, size_t itemSize, size_t metadataSize) :
+        KDMapped(path, itemCount, itemSize, metadataSize) {
+        ASSERT(itemCount < std::numeric_limits<Ptr>::max());
+    }
+
+    Ptr root() const { return static_cast<Ptr>(KDMapped::root()); }
+
+    void root(Ptr r) { KDMapped::root(r); }
+
+    template <class Node>
+    Ptr convert(Node* p) {
+        return static_cast<Ptr>(KDMapped::convert(p));
+    }
+
+    template <class Node>
+    Node* convert(Ptr p, const Node* dummy) {
+        return KDMapped::convert(KDMapped::Ptr(p), dummy);
+    }
+};
+
+
+/// Writes a file in the layout of KDMapped in one sequential pass, for items already laid out (in the order of
+/// their indices, from 1). The file is written under a temporary name, and renamed by close().
+class KDMappedWriter : private NonCopyable {
+public:
+    KDMappedWriter(const PathName&, size_t itemCount, size_t itemSize, const void* metadata = nullptr,
+                   size_t metadataSize = 0);
+    ~KDMappedWriter();
+
+    /// Append the next item, of itemSize bytes
+    void write(const void* item);
+
+    /// @returns if index is the last index of the file
+    bool last(size_t index) const { return index == header_.itemCount_; }
+
+    void close();
+
+private:
+    void flush();
+
+    PathName path_;
+    PathName tmp_;
+
+    KDMappedHeader header_;
+
+    size_t count_{0};
+    std::vector<char> buffer_;
+    size_t used_{0};
+
+    std::unique_ptr<DataHandle> handle_;
+};
+
 }  // namespace eckit
 
 
@@ -11,9 +11,13 @@
 #ifndef KDTree_H
 #define KDTree_H
 
+#include <algorithm>
+
 #include "eckit/container/kdtree/KDNode.h"
 #include "eckit/container/sptree/SPTree.h"
+#include "eckit/thread/ParallelFor.h"
 
+#include "KDFlat.h"
 #include "KDMapped.h"
 #include "KDMemory.h"
 
@@ -53,6 +57,38 @@ public:
         build(b, e);
     }
 
+    /// Build as build(), partitioning the values over threads (0: as many as the workers, see parallelFor)
+    /// ITER must be a random access iterator
+    /// WARNING: container is changed (sorted)
+    template <typename ITER>
+    void buildParallel(ITER begin, ITER end, size_t threads = 0) {
+        partition(begin, end, threads);
+
+        Alloc& a    = this->alloc_;
+        this->root_ = a.convert(Node::buildPartitioned(a, begin, end));
+        a.root(this->root_);
+    }
+
+    /// Container must be a random access
+    /// WARNING: container is changed (sorted)
+    template <typename Container>
+    void buildParallel(Container& c, size_t threads = 0) {
+        buildParallel(c.begin(), c.end(), threads);
+    }
+
+    /// Reorder the values as the build does (only the nodes remain to be allocated), over threads
+    template <typename ITER>
+    static void partition(ITER begin, ITER end, size_t threads = 0) {
+        // Below this size, a range is partitioned by a single task
+        constexpr size_t grain = 1 << 16;
+
+        if (size_t(end - begin) <= grain) {
+            threads = 1;
+        }
+
+        parallelTasks(threads, [&](TaskGroup* group) { Node::partition(begin, end, 0, group, grain); });
+    }
+
     //
     void insert(const Value& value) {
         Alloc& a   = this->alloc_;
@@ -95,6 +131,111 @@ public:
 public:
     KDTreeMapped(const eckit::PathName& path, size_t itemCount, size_t metadataSize) :
         KDTree(alloc_), alloc_(path, itemCount, sizeof(Node), metadataSize) {}
+
+    /// Write the tree of the values directly in the file layout of KDTreeMapped, in one sequential pass (without
+    /// mapping the file), partitioning the values over threads (0: as many as the workers). To be opened with
+    /// KDTreeMapped(path, 0, metadataSize).
+    /// ITER must be a random access iterator
+    /// WARNING: container is changed (sorted)
+    template <typename ITER>
+    static void write(const eckit::PathName& path, ITER begin, ITER end, size_t threads = 0,
+                      const void* metadata = nullptr, size_t metadataSize = 0) {
+        ASSERT(begin != end);
+
+        KDTree::partition(begin, end, threads);
+
+        KDMappedWriter w(path, size_t(end - begin), sizeof(Node), metadata, metadataSize);
+        Node::writePartitioned(w, begin, end, 1);
+        w.close();
+    }
+
+    template <typename Container>
+    static void write(const eckit::PathName& path, Container& c, size_t threads = 0) {
+        write(path, c.begin(), c.end(), threads);
+    }
+};
+
+/// KD-tree with its nodes in one block of memory, linked by 32-bit indices, and laid out for searches
+template <class Traits>
+class KDTreeFlat : public KDTreeX<TT<Traits, KDFlat> > {
+    KDFlat alloc_;
+
+public:
+    typedef KDTreeX<TT<Traits, KDFlat> > KDTree;
+    typedef typename KDTree::Value Value;
+    typedef typename KDTree::Point Point;
+    typedef typename KDTree::Payload Payload;
+    typedef typename KDTree::Node Node;
+
+public:
+    /// @param capacity room for the nodes of insert(), build() makes room for its own
+    explicit KDTreeFlat(size_t capacity = 0) :
+        KDTree(alloc_) {
+        alloc_.reserve(capacity, (Node*)0);
+    }
+
+    /// ITER must be a random access iterator
+    /// WARNING: container is changed (sorted)
+    template <typename ITER>
+    void build(ITER begin, ITER end, KDLayout layout = KDLayout::VanEmdeBoas, size_t threads = 0) {
+        alloc_.reserve(size_t(end - begin), (Node*)0);
+        if (begin == end) {
+            this->root_ = 0;
+            return;
+        }
+
+        KDTree::partition(begin, end, threads);
+        Node::writeLayout(alloc_, begin, end, layout);
+
+        this->root_ = 1;
+        alloc_.root(this->root_);
+    }
+
+    /// Container must be a random access
+    /// WARNING: container is changed (sorted)
+    template <typename Container>
+    void build(Container& c, KDLayout layout = KDLayout::VanEmdeBoas, size_t threads = 0) {
+        build(c.begin(), c.end(), layout, threads);
+    }
+};
+
+/// KD-tree mapped from a file, as KDTreeMapped, with its nodes linked by 32-bit indices
+template <class Traits>
+class KDTreeMappedFlat : public KDTreeX<TT<Traits, KDMapped32> > {
+    KDMapped32 alloc_;
+
+public:
+    typedef KDTreeX<TT<Traits, KDMapped32> > KDTree;
+    typedef typename KDTree::Value Value;
+    typedef typename KDTree::Point Point;
+    typedef typename KDTree::Payload Payload;
+    typedef typename KDTree::Node Node;
+
+public:
+    KDTreeMappedFlat(const eckit::PathName& path, size_t itemCount, size_t metadataSize) :
+        KDTree(alloc_), alloc_(path, itemCount, sizeof(Node), metadataSize) {}
+
+    /// Write the tree of the values in the given layout, in one sequential pass (see KDTreeMapped::write), to be
+    /// opened with KDTreeMappedFlat(path, 0, metadataSize)
+    /// ITER must be a random access iterator
+    /// WARNING: container is changed (sorted)
+    template <typename ITER>
+    static void write(const eckit::PathName& path, ITER begin, ITER end, KDLayout layout = KDLayout::VanEmdeBoas,
+                      size_t threads = 0, const void* metadata = nullptr, size_t metadataSize = 0) {
+        ASSERT(begin != end);
+
+        KDTree::partition(begin, end, threads);
+
+        KDMappedWriter w(path, size_t(end - begin), sizeof(Node), metadata, metadataSize);
+        Node::writeLayout(w, begin, end, layout);
+        w.close();
+    }
+
+    template <typename Container>
+    static void write(const eckit::PathName& path, Container& c, KDLayout layout = KDLayout::VanEmdeBoas,
+                      size_t threads = 0) {
+        write(path, c.begin(), c.end(), layout, threads);
+    }
 };
 
 }  // namespace eckit
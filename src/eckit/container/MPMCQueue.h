@@ -0,0 +1,274 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#ifndef eckit_container_MPMCQueue_h
+#define eckit_container_MPMCQueue_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Bounded multi-producer multi-consumer queue on a lock-free ring buffer (D. Vyukov's algorithm).
+///
+/// Same interface and close()/interrupt() semantics as Queue, but push and pop only take a lock when they
+/// have to block because the queue is full or empty, and only wake up threads that are actually waiting.
+///
+/// @note the capacity is rounded up to a power of 2 (at least 2), and cannot be changed
+/// @note ELEM must be default constructible, elements are moved in and out of the ring
+
+template <typename ELEM>
+class MPMCQueue {
+
+public:  // methods
+    MPMCQueue(size_t max) :
+        capacity_(roundUp(max)), mask_(capacity_ - 1), cells_(new Cell[capacity_]) {
+        ASSERT(max > 0);
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence_.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCQueue(const MPMCQueue&)            = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+    MPMCQueue(MPMCQueue&&)                 = delete;
+    MPMCQueue& operator=(MPMCQueue&&)      = delete;
+
+    size_t maxSize() const { return capacity_; }
+
+    /// Approximate number of elements, exact when no push or pop is in progress
+    size_t size() const {
+        size_t tail = dequeuePos_.load(std::memory_order_acquire);
+        size_t head = enqueuePos_.load(std::memory_order_acquire);
+        return head > tail ? std::min(head - tail, capacity_) : 0;
+    }
+
+    bool empty() const { return !readable(); }
+
+    void close() {
+        std::unique_lock<std::mutex> locker(mutex_);
+        closed_ = true;
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+
+    bool closed() const { return closed_ || interrupted_; }
+
+    bool checkInterrupt() {
+        if (interrupted_) {
+            std::unique_lock<std::mutex> locker(mutex_);
+            std::rethrow_exception(interrupt_);
+        }
+        return true;
+    }
+
+    void interrupt(std::exception_ptr expn) {
+        std::unique_lock<std::mutex> locker(mutex_);
+        interrupt_   = expn;
+        interrupted_ = true;
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+
+    /// Non-blocking push, returns false if the queue is full
+    template <typename T>
+    bool tryPush(T&& e) {
+        if (!enqueue(std::forward<T>(e))) {
+            return false;
+        }
+        wake(consumersWaiting_, notEmpty_);
+        return true;
+    }
+
+    /// Non-blocking pop, returns false if the queue is empty
+    bool tryPop(ELEM& e) {
+        if (!dequeue(e)) {
+            return false;
+        }
+        wake(producersWaiting_, notFull_);
+        return true;
+    }
+
+    /// Blocks until an element is available. Returns -1 if the queue is closed and empty,
+    /// otherwise the (approximate) number of elements left
+    long pop(ELEM& e) {
+        for (;;) {
+            checkInterrupt();
+            if (tryPop(e)) {
+                return long(size());
+            }
+            if (closed_) {
+                // Elements pushed before close() are still delivered
+                return tryPop(e) ? long(size()) : -1;
+            }
+            waitFor(consumersWaiting_, notEmpty_, [this] { return readable(); });
+        }
+    }
+
+    /// Blocks until at least one element is available, then pops as many as are available, up to elems.size().
+    /// Returns the number of elements popped, or -1 if the queue is closed and empty
+    long pop(std::vector<ELEM>& elems) {
+        if (elems.empty()) {
+            return 0;
+        }
+        long r = pop(elems[0]);
+        if (r < 0) {
+            return r;
+        }
+        long count = 1;
+        while (size_t(count) < elems.size() && tryPop(elems[count])) {
+            count++;
+        }
+        return count;
+    }
+
+    /// Blocks while the queue is full. Returns the (approximate) number of elements in the queue
+    size_t push(const ELEM& e) { return emplace(e); }
+
+    size_t push(ELEM&& e) { return emplace(std::move(e)); }
+
+    template <typename... Args>
+    size_t emplace(Args&&... args) {
+        ELEM e(std::forward<Args>(args)...);
+        for (;;) {
+            checkInterrupt();
+            ASSERT(!closed_);
+            if (tryPush(std::move(e))) {
+                return size();
+            }
+            waitFor(producersWaiting_, notFull_, [this] { return writable(); });
+        }
+    }
+
+private:  // types
+    struct Cell {
+        std::atomic<size_t> sequence_;
+        ELEM data_;
+    };
+
+private:  // methods
+    static size_t roundUp(size_t n) {
+        size_t p = 2;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    template <typename T>
+    bool enqueue(T&& e) {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell   = cells_[pos & mask_];
+            size_t seq   = cell.sequence_.load(std::memory_order_acquire);
+            intptr_t dif = intptr_t(seq) - intptr_t(pos);
+            if (dif == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data_ = std::forward<T>(e);
+                    cell.sequence_.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (dif < 0) {
+                return false;
+            }
+            else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool dequeue(ELEM& e) {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell   = cells_[pos & mask_];
+            size_t seq   = cell.sequence_.load(std::memory_order_acquire);
+            intptr_t dif = intptr_t(seq) - intptr_t(pos + 1);
+            if (dif == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    e = std::move(cell.data_);
+                    cell.sequence_.store(pos + capacity_, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (dif < 0) {
+                return false;
+            }
+            else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// The next cell to pop has been published
+    bool readable() const {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        return intptr_t(cells_[pos & mask_].sequence_.load(std::memory_order_acquire)) - intptr_t(pos + 1) >= 0;
+    }
+
+    /// The next cell to push has been released
+    bool writable() const {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        return intptr_t(cells_[pos & mask_].sequence_.load(std::memory_order_acquire)) - intptr_t(pos) >= 0;
+    }
+
+    // A waiter registers itself then checks the ring, a waker updates the ring then checks for waiters.
+    // The fences make sure at least one of them sees the other, so no wakeup is lost.
+
+    template <typename Ready>
+    void waitFor(std::atomic<size_t>& waiting, std::condition_variable& cv, Ready ready) {
+        std::unique_lock<std::mutex> locker(mutex_);
+        waiting++;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cv.wait(locker, [&] { return ready() || closed_ || interrupted_; });
+        waiting--;
+    }
+
+    void wake(std::atomic<size_t>& waiting, std::condition_variable& cv) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) > 0) {
+            std::unique_lock<std::mutex> locker(mutex_);
+            cv.notify_one();
+        }
+    }
+
+private:  // members
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) std::atomic<size_t> dequeuePos_{0};
+
+    alignas(64) std::atomic<size_t> producersWaiting_{0};
+    std::atomic<size_t> consumersWaiting_{0};
+
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::exception_ptr interrupt_;
+    std::atomic<bool> interrupted_{false};
+    std::atomic<bool> closed_{false};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
+
+#endif  // eckit_container_MPMCQueue_h
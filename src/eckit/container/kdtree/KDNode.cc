@@ -17,11 +17,16 @@
 #include <sys/types.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <limits>
+#include <vector>
 
 #include "KDNode.h"
 
+#include "eckit/exception/Exceptions.h"
+#include "eckit/thread/Executor.h"
+
 namespace eckit {
 
 
@@ -158,6 +163,219 @@ KDNode<Traits>* KDNode<Traits>::build(Alloc& a, const ITER& begin, const ITER& e
 }
 
 
+template <class Traits>
+template <typename ITER>
+void KDNode<Traits>::partition(const ITER& begin, const ITER& end, int depth, TaskGroup* group, size_t grain) {
+    if (end - begin <= 1)
+        return;
+
+    size_t k    = Point::DIMS;
+    size_t axis = depth % k;
+
+    size_t median = (end - begin) / 2;
+
+    std::nth_element(begin, begin + median, end, sorter<Value>(axis));
+
+    ITER e2 = begin + median;
+    ITER b2 = begin + median + 1;
+
+    if (group != nullptr && size_t(end - begin) > grain) {
+        group->run([=]() { partition(begin, e2, depth + 1, group, grain); });
+    }
+    else {
+        partition(begin, e2, depth + 1, group, grain);
+    }
+    partition(b2, end, depth + 1, group, grain);
+}
+
+
+template <class Traits>
+template <typename ITER>
+KDNode<Traits>* KDNode<Traits>::buildPartitioned(Alloc& a, const ITER& begin, const ITER& end, int depth) {
+    if (end == begin)
+        return 0;
+
+    a.statsDepth(depth);
+
+    size_t k    = Point::DIMS;
+    size_t axis = depth % k;
+
+    size_t median = (end - begin) / 2;
+
+    ITER e2 = begin + median;
+    ITER b2 = begin + median + 1;
+
+    KDNode* n = a.newNode2(*e2, axis, (KDNode*)0);
+
+    n->left(a, buildPartitioned(a, begin, e2, depth + 1));
+    n->right(a, buildPartitioned(a, b2, end, depth + 1));
+
+    return n;
+}
+
+
+template <class Traits>
+template <typename ITER, typename Writer>
+void KDNode<Traits>::writePartitioned(Writer& w, const ITER& begin, const ITER& end, size_t index, int depth) {
+    if (end == begin)
+        return;
+
+    size_t k    = Point::DIMS;
+    size_t axis = depth % k;
+
+    size_t median = (end - begin) / 2;
+
+    ITER e2 = begin + median;
+    ITER b2 = begin + median + 1;
+
+    // Nodes are allocated in pre-order: this node, then the left subtree, then the right subtree
+    KDNode n(*e2, axis);
+    n.left_  = (median > 0) ? index + 1 : 0;
+    n.right_ = (b2 != end) ? index + 1 + median : 0;
+
+    // n.b. linkNodes() links the nodes in pre-order as well
+    n.next_ = w.last(index) ? 0 : index + 1;
+
+    w.write(&n);
+
+    writePartitioned(w, begin, e2, index + 1, depth + 1);
+    writePartitioned(w, b2, end, index + 1 + median, depth + 1);
+}
+
+
+namespace detail {
+
+/// Shape of a KD-tree over partitioned values: nodes are identified by the position of their value, and their
+/// children (from 1, 0 for none) follow from the ranges the values are partitioned into
+struct KDShape {
+    std::vector<std::uint32_t> left_;
+    std::vector<std::uint32_t> right_;
+    std::vector<std::uint8_t> depth_;
+
+    explicit KDShape(size_t n) :
+        left_(n), right_(n), depth_(n) {
+        ASSERT(n < std::numeric_limits<std::uint32_t>::max());
+        setup(0, n, 0);
+    }
+
+    /// @returns position of the root of [begin, end) + 1, 0 if empty
+    std::uint32_t setup(size_t begin, size_t end, size_t depth) {
+        if (begin == end) {
+            return 0;
+        }
+        size_t median  = begin + (end - begin) / 2;
+        left_[median]  = setup(begin, median, depth + 1);
+        right_[median] = setup(median + 1, end, depth + 1);
+        depth_[median] = static_cast<std::uint8_t>(depth);
+        return static_cast<std::uint32_t>(median + 1);
+    }
+
+    size_t root() const { return left_.size() / 2; }
+
+    size_t height() const {
+        size_t h = 0;
+        for (size_t n = left_.size(); n > 0; n /= 2) {
+            ++h;
+        }
+        return h;
+    }
+
+    void preOrder(size_t p, std::vector<std::uint32_t>& order) const {
+        order.push_back(static_cast<std::uint32_t>(p));
+        if (left_[p] != 0) {
+            preOrder(left_[p] - 1, order);
+        }
+        if (right_[p] != 0) {
+            preOrder(right_[p] - 1, order);
+        }
+    }
+
+    void breadthFirst(std::vector<std::uint32_t>& order) const {
+        order.push_back(static_cast<std::uint32_t>(root()));
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (left_[order[i]] != 0) {
+                order.push_back(left_[order[i]] - 1);
+            }
+            if (right_[order[i]] != 0) {
+                order.push_back(right_[order[i]] - 1);
+            }
+        }
+    }
+
+    /// The top h levels of the subtree of p
+    void vanEmdeBoas(size_t p, size_t h, std::vector<std::uint32_t>& order) const {
+        if (h == 1) {
+            order.push_back(static_cast<std::uint32_t>(p));
+            return;
+        }
+
+        const size_t top = h / 2;
+        vanEmdeBoas(p, top, order);
+        below(p, top, [&](size_t q) { vanEmdeBoas(q, h - top, order); });
+    }
+
+    /// Visit the nodes d levels below p, from left to right
+    template <typename F>
+    void below(size_t p, size_t d, const F& f) const {
+        if (d == 0) {
+            f(p);
+            return;
+        }
+        if (left_[p] != 0) {
+            below(left_[p] - 1, d - 1, f);
+        }
+        if (right_[p] != 0) {
+            below(right_[p] - 1, d - 1, f);
+        }
+    }
+};
+
+}  // namespace detail
+
+
+template <class Traits>
+template <typename ITER, typename Writer>
+void KDNode<Traits>::writeLayout(Writer& w, const ITER& begin, const ITER& end, KDLayout layout) {
+    const auto n = size_t(end - begin);
+    if (n == 0)
+        return;
+
+    detail::KDShape shape(n);
+
+    // order: positions in the order of the layout
+    std::vector<std::uint32_t> order;
+    order.reserve(n);
+
+    switch (layout) {
+        case KDLayout::PreOrder:
+            shape.preOrder(shape.root(), order);
+            break;
+        case KDLayout::BreadthFirst:
+            shape.breadthFirst(order);
+            break;
+        case KDLayout::VanEmdeBoas:
+            shape.vanEmdeBoas(shape.root(), shape.height(), order);
+            break;
+    }
+
+    ASSERT(order.size() == n);
+
+    // index of each position, from 1
+    std::vector<std::uint32_t> index(n);
+    for (size_t i = 0; i < n; ++i) {
+        index[order[i]] = static_cast<std::uint32_t>(i + 1);
+    }
+
+    size_t k = Point::DIMS;
+    for (auto p : order) {
+        KDNode node(*(begin + p), shape.depth_[p] % k);
+        node.left_  = shape.left_[p] != 0 ? index[shape.left_[p] - 1] : 0;
+        node.right_ = shape.right_[p] != 0 ? index[shape.right_[p] - 1] : 0;
+        w.write(&node);
+    }
+}
+
+
 template <class Traits>
 KDNode<Traits>* KDNode<Traits>::insert(Alloc& a, const Value& value, KDNode<Traits>* node, int depth) {
 
@@ -15,6 +15,16 @@
 
 namespace eckit {
 
+class TaskGroup;
+
+/// Order of the nodes of a KD-tree stored contiguously
+enum class KDLayout
+{
+    PreOrder,      ///< each node followed by its left then its right subtree, as allocated by build()
+    BreadthFirst,  ///< level by level
+    VanEmdeBoas,   ///< the top half of the levels, then each subtree below it, recursively (cache-oblivious)
+};
+
 
 template <class Traits>
 class KDNode : public SPNode<Traits, KDNode<Traits> > {
@@ -44,6 +54,26 @@ public:
 
     static KDNode<Traits>* insert(Alloc& a, const Value& value, KDNode<Traits>* node, int depth = 0);
 
+    /// Reorder the values as build() does, so that the median of each range (split along the axis of its depth) is
+    /// in its middle. Ranges larger than grain are partitioned by tasks of the group, if any.
+    template <typename ITER>
+    static void partition(const ITER& begin, const ITER& end, int depth = 0, TaskGroup* group = nullptr,
+                          size_t grain = 0);
+
+    /// Build over values already reordered by partition()
+    template <typename ITER>
+    static KDNode* buildPartitioned(Alloc& a, const ITER& begin, const ITER& end, int depth = 0);
+
+    /// Write the nodes over values already reordered by partition(), in the order (and with the indices) KDMapped
+    /// allocates them, starting at index
+    template <typename ITER, typename Writer>
+    static void writePartitioned(Writer& w, const ITER& begin, const ITER& end, size_t index, int depth = 0);
+
+    /// Write the nodes over values already reordered by partition() in the given layout, with indices from 1 (the
+    /// root). The nodes are not linked for iteration (see SPIterator).
+    template <typename ITER, typename Writer>
+    static void writeLayout(Writer& w, const ITER& begin, const ITER& end, KDLayout layout);
+
     /// Return the axis along which this node is split.
     size_t axis() const { return axis_; }
 
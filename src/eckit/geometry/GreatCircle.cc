@@ -10,11 +10,13 @@
 
 #include "eckit/geometry/GreatCircle.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <sstream>
 
 #include "eckit/exception/Exceptions.h"
+#include "eckit/geometry/Trigonometry.h"
 #include "eckit/types/FloatCompare.h"
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -86,6 +88,36 @@ std::vector<double> GreatCircle::latitude(double lon) const {
     return {radians_to_degrees * lat};
 }
 
+void GreatCircle::latitude(size_t n, const double* lon, double* lat) const {
+    using namespace std;
+
+    if (crossesPoles()) {
+        fill(lat, lat + n, numeric_limits<double>::quiet_NaN());
+        return;
+    }
+
+    const double tan_lat1 = tan(degrees_to_radians * A_[1]);
+    const double tan_lat2 = tan(degrees_to_radians * B_[1]);
+
+    double sin_lambda;
+    double cos_lambda;
+    sincosd(normalise_longitude(B_[0] - A_[0], -180), sin_lambda, cos_lambda);
+
+    for (size_t i = 0; i < n; ++i) {
+        double sin_lambda1p;
+        double sin_lambda2p;
+        double cos_unused;
+        sincosd(lon[i] - A_[0], sin_lambda1p, cos_unused);
+        sincosd(lon[i] - B_[0], sin_lambda2p, cos_unused);
+
+        lat[i] = (tan_lat2 * sin_lambda1p - tan_lat1 * sin_lambda2p) / sin_lambda;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        lat[i] = radians_to_degrees * atan(lat[i]);
+    }
+}
+
 std::vector<double> GreatCircle::longitude(double lat) const {
     using namespace std;
     using types::is_approximately_equal;
@@ -28,6 +28,9 @@ public:
     /// Great circle latitude given longitude, see http://www.edwilliams.org/avform.htm#Int
     std::vector<double> latitude(double lon) const;
 
+    /// Great circle latitudes given n longitudes (NaN if the great circle crosses the poles)
+    void latitude(size_t n, const double* lon, double* lat) const;
+
     /// Great circle longitude given latitude, see http://www.edwilliams.org/avform.htm#Par
     std::vector<double> longitude(double lat) const;
 
@@ -19,6 +19,8 @@
 #include "eckit/geometry/GreatCircle.h"
 #include "eckit/geometry/Point2.h"
 #include "eckit/geometry/Point3.h"
+#include "eckit/geometry/Trigonometry.h"
+#include "eckit/thread/ParallelFor.h"
 #include "eckit/types/FloatCompare.h"
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -35,6 +37,54 @@ inline double squared(double x) {
     return x * x;
 }
 
+/// Points per task of the batch methods
+static constexpr size_t chunk = 4096;
+
+/// Points per vectorised pass, within a task
+static constexpr size_t block = 256;
+
+static void centralAngles(const Point2& Alonlat, size_t n, const double* Blon, const double* Blat, double* angle,
+                          bool normalise_angle, size_t threads) {
+    // n.b. the formula (see centralAngle) holds for non-canonical coordinates, there is no need to canonicalise them
+    if (!normalise_angle) {
+        assert_latitude_range(Alonlat[1]);
+        for (size_t i = 0; i < n; ++i) {
+            assert_latitude_range(Blat[i]);
+        }
+    }
+
+    double sin_phi1;
+    double cos_phi1;
+    sincosd(Alonlat[1], sin_phi1, cos_phi1);
+
+    parallelFor(n, chunk, threads, [&](size_t begin, size_t end) {
+        double x[block];
+
+        for (size_t b = begin; b < end; b += block) {
+            const size_t m = std::min(block, end - b);
+            double* y      = angle + b;
+
+            for (size_t i = 0; i < m; ++i) {
+                double sin_phi2;
+                double cos_phi2;
+                double sin_lambda;
+                double cos_lambda;
+                sincosd(Blat[b + i], sin_phi2, cos_phi2);
+                sincosd(Blon[b + i] - Alonlat[0], sin_lambda, cos_lambda);
+
+                y[i] = std::sqrt(squared(cos_phi2 * sin_lambda)
+                                 + squared(cos_phi1 * sin_phi2 - sin_phi1 * cos_phi2 * cos_lambda));
+                x[i] = sin_phi1 * sin_phi2 + cos_phi1 * cos_phi2 * cos_lambda;
+            }
+
+            for (size_t i = 0; i < m; ++i) {
+                const double a = std::atan2(y[i], x[i]);
+                y[i]           = a <= std::numeric_limits<double>::epsilon() ? 0. : a;
+            }
+        }
+    });
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 double Sphere::centralAngle(const Point2& Alonlat, const Point2& Blonlat, bool normalise_angle) {
@@ -206,6 +256,93 @@ void Sphere::convertCartesianToSpherical(const double& radius, const Point3& A,
     Blonlat[1] = radians_to_degrees * std::asin(z);
 }
 
+void Sphere::centralAngle(const Point2& Alonlat, size_t n, const double* Blon, const double* Blat, double* angle,
+                          size_t threads) {
+    centralAngles(Alonlat, n, Blon, Blat, angle, false, threads);
+}
+
+void Sphere::centralAngle(const double& radius, const Point3& A, size_t n, const double* Bx, const double* By,
+                          const double* Bz, double* angle, size_t threads) {
+    ASSERT(radius > 0.);
+
+    parallelFor(n, chunk, threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const double d2 = squared(Bx[i] - A[0]) + squared(By[i] - A[1]) + squared(Bz[i] - A[2]);
+            angle[i]        = d2 <= std::numeric_limits<double>::epsilon() ? 0.
+                                                                         : std::asin(std::sqrt(d2) / radius * 0.5) * 2.;
+        }
+    });
+}
+
+void Sphere::distance(const double& radius, const Point2& Alonlat, size_t n, const double* Blon, const double* Blat,
+                      double* distance, size_t threads) {
+    centralAngles(Alonlat, n, Blon, Blat, distance, true, threads);
+    for (size_t i = 0; i < n; ++i) {
+        distance[i] *= radius;
+    }
+}
+
+void Sphere::distance(const double& radius, const Point3& A, size_t n, const double* Bx, const double* By,
+                      const double* Bz, double* distance, size_t threads) {
+    centralAngle(radius, A, n, Bx, By, Bz, distance, threads);
+    for (size_t i = 0; i < n; ++i) {
+        distance[i] *= radius;
+    }
+}
+
+void Sphere::greatCircleLatitudeGivenLongitude(const Point2& Alonlat, const Point2& Blonlat, size_t n,
+                                               const double* Clon, double* Clat, size_t threads) {
+    GreatCircle gc(Alonlat, Blonlat);
+    parallelFor(n, chunk, threads, [&](size_t begin, size_t end) {
+        gc.latitude(end - begin, Clon + begin, Clat + begin);
+    });
+}
+
+void Sphere::convertSphericalToCartesian(const double& radius, size_t n, const double* lon, const double* lat,
+                                         double* x, double* y, double* z, double height, bool normalise_angle,
+                                         size_t threads) {
+    ASSERT(radius > 0.);
+
+    // n.b. sincosd is exact at the poles and quadrants, and periodic, so the coordinates are not canonicalised
+    if (!normalise_angle) {
+        for (size_t i = 0; i < n; ++i) {
+            assert_latitude_range(lat[i]);
+        }
+    }
+
+    const double r = radius + height;
+
+    parallelFor(n, chunk, threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            double sin_phi;
+            double cos_phi;
+            double sin_lambda;
+            double cos_lambda;
+            sincosd(lat[i], sin_phi, cos_phi);
+            sincosd(lon[i], sin_lambda, cos_lambda);
+
+            x[i] = r * cos_phi * cos_lambda;
+            y[i] = r * cos_phi * sin_lambda;
+            z[i] = r * sin_phi;
+        }
+    });
+}
+
+void Sphere::convertCartesianToSpherical(const double& radius, size_t n, const double* x, const double* y,
+                                         const double* z, double* lon, double* lat, size_t threads) {
+    ASSERT(radius > 0.);
+
+    parallelFor(n, chunk, threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const double yi = std::abs(y[i]) <= std::numeric_limits<double>::epsilon() ? 0. : y[i];
+            const double zi = std::min(radius, std::max(-radius, z[i])) / radius;
+
+            lon[i] = radians_to_degrees * std::atan2(yi, x[i]);
+            lat[i] = radians_to_degrees * std::asin(zi);
+        }
+    });
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::geometry
@@ -11,6 +11,8 @@
 #ifndef Sphere_H
 #define Sphere_H
 
+#include <cstddef>
+
 //----------------------------------------------------------------------------------------------------------------------
 
 namespace eckit::geometry {
@@ -62,6 +64,40 @@ struct Sphere {
 
     // Convert Cartesian coordinates to spherical
     static void convertCartesianToSpherical(const double& radius, const Point3& A, Point2& Blonlat);
+
+    // Batch versions, on arrays of n coordinates (structure of arrays). The work is shared out to threads (0: as many
+    // as the workers, see parallelFor) in chunks, and the sines and cosines of angles in degrees are branch-free (see
+    // sincosd)
+
+    /// Great-circle central angles between a point and n points (latitude/longitude coordinates) in radians
+    static void centralAngle(const Point2& Alonlat, size_t n, const double* Blon, const double* Blat, double* angle,
+                             size_t threads = 0);
+
+    /// Great-circle central angles between a point and n points (Cartesian coordinates) in radians
+    static void centralAngle(const double& radius, const Point3& A, size_t n, const double* Bx, const double* By,
+                             const double* Bz, double* angle, size_t threads = 0);
+
+    /// Great-circle distances between a point and n points (latitude/longitude coordinates) in metres
+    static void distance(const double& radius, const Point2& Alonlat, size_t n, const double* Blon,
+                         const double* Blat, double* distance, size_t threads = 0);
+
+    /// Great-circle distances between a point and n points (Cartesian coordinates) in metres
+    static void distance(const double& radius, const Point3& A, size_t n, const double* Bx, const double* By,
+                         const double* Bz, double* distance, size_t threads = 0);
+
+    // Great-circle intermediate latitudes provided two circle points (A, B) and n intermediate longitudes (C) in
+    // degrees (NaN if the great circle crosses the poles)
+    static void greatCircleLatitudeGivenLongitude(const Point2& Alonlat, const Point2& Blonlat, size_t n,
+                                                  const double* Clon, double* Clat, size_t threads = 0);
+
+    // Convert spherical coordinates to Cartesian
+    static void convertSphericalToCartesian(const double& radius, size_t n, const double* lon, const double* lat,
+                                            double* x, double* y, double* z, double height = 0.,
+                                            bool normalise_angle = false, size_t threads = 0);
+
+    // Convert Cartesian coordinates to spherical
+    static void convertCartesianToSpherical(const double& radius, size_t n, const double* x, const double* y,
+                                            const double* z, double* lon, double* lat, size_t threads = 0);
 };
 
 //----------------------------------------------------------------------------------------------------------------------
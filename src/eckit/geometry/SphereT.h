@@ -79,6 +79,52 @@ struct SphereT {
     inline static void convertCartesianToSpherical(const Point3& A, Point2& Blonlat) {
         Sphere::convertCartesianToSpherical(DATUM::radius(), A, Blonlat);
     }
+
+    // Batch versions, see Sphere
+
+    /// Great-circle central angles between a point and n points (longitude/latitude coordinates) in radians
+    inline static void centralAngle(const Point2& Alonlat, size_t n, const double* Blon, const double* Blat,
+                                    double* angle, size_t threads = 0) {
+        Sphere::centralAngle(Alonlat, n, Blon, Blat, angle, threads);
+    }
+
+    /// Great-circle central angles between a point and n points (Cartesian coordinates) in radians
+    inline static void centralAngle(const Point3& A, size_t n, const double* Bx, const double* By, const double* Bz,
+                                    double* angle, size_t threads = 0) {
+        Sphere::centralAngle(DATUM::radius(), A, n, Bx, By, Bz, angle, threads);
+    }
+
+    /// Great-circle distances between a point and n points (longitude/latitude coordinates) in metres
+    inline static void distance(const Point2& Alonlat, size_t n, const double* Blon, const double* Blat,
+                                double* distance, size_t threads = 0) {
+        Sphere::distance(DATUM::radius(), Alonlat, n, Blon, Blat, distance, threads);
+    }
+
+    /// Great-circle distances between a point and n points (Cartesian coordinates) in metres
+    inline static void distance(const Point3& A, size_t n, const double* Bx, const double* By, const double* Bz,
+                                double* distance, size_t threads = 0) {
+        Sphere::distance(DATUM::radius(), A, n, Bx, By, Bz, distance, threads);
+    }
+
+    // Great-circle intermediate latitudes provided two circle points (A, B) and n intermediate longitudes (C) in
+    // degrees
+    inline static void greatCircleLatitudeGivenLongitude(const Point2& Alonlat, const Point2& Blonlat, size_t n,
+                                                         const double* Clon, double* Clat, size_t threads = 0) {
+        Sphere::greatCircleLatitudeGivenLongitude(Alonlat, Blonlat, n, Clon, Clat, threads);
+    }
+
+    // Convert spherical coordinates to Cartesian
+    inline static void convertSphericalToCartesian(size_t n, const double* lon, const double* lat, double* x,
+                                                   double* y, double* z, double height = 0.,
+                                                   bool normalise_angle = false, size_t threads = 0) {
+        Sphere::convertSphericalToCartesian(DATUM::radius(), n, lon, lat, x, y, z, height, normalise_angle, threads);
+    }
+
+    // Convert Cartesian coordinates to spherical
+    inline static void convertCartesianToSpherical(size_t n, const double* x, const double* y, const double* z,
+                                                   double* lon, double* lat, size_t threads = 0) {
+        Sphere::convertCartesianToSpherical(DATUM::radius(), n, x, y, z, lon, lat, threads);
+    }
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#ifndef Trigonometry_H
+#define Trigonometry_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace eckit::geometry {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Sine and cosine of an angle in degrees, without calls or branches so that loops over arrays of angles vectorise.
+///
+/// The angle is reduced exactly to [-45, 45] degrees and a quadrant, so that the multiples of 90 degrees give exact
+/// values (0, 1 or -1), then the reduced angle is approximated by polynomials (Cephes coefficients). The absolute
+/// error is below 2e-16, for angles up to 2^50 degrees.
+inline void sincosd(double degrees, double& sin, double& cos) {
+    // n.b. adding then subtracting 1.5 * 2^52 rounds to the nearest integer, whose low bits are then in the mantissa
+    constexpr double round = 6755399441055744.;
+
+    const double shifted = degrees * (1. / 90.) + round;
+    const double q       = shifted - round;
+    const double r       = degrees - q * 90.;  // exact
+
+    std::uint64_t bits;
+    std::memcpy(&bits, &shifted, sizeof(bits));
+    const auto quadrant = static_cast<unsigned>(bits & 3);
+
+    const double x = r * (M_PI / 180.);
+    const double z = x * x;
+
+    const double s = x + x * z * (((((1.58962301576546568060e-10 * z - 2.50507477628578072866e-8) * z
+                                      + 2.75573136213857245213e-6) * z - 1.98412698295895385996e-4) * z
+                                    + 8.33333333332211858878e-3) * z - 1.66666666666666307295e-1);
+
+    const double c = 1. - 0.5 * z + z * z * (((((-1.13585365213876817300e-11 * z + 2.08757008419747316778e-9) * z
+                                                 - 2.75573141792967388112e-7) * z + 2.48015872888517045348e-5) * z
+                                               - 1.38888888888730564116e-3) * z + 4.16666666666665929218e-2);
+
+    // sin(r + 90 q) and cos(r + 90 q) from sin(r), cos(r) and q mod 4
+    const bool swap = (quadrant & 1) != 0;
+    const double ss = swap ? c : s;
+    const double cc = swap ? s : c;
+
+    sin = (quadrant & 2) != 0 ? -ss : ss;
+    cos = ((quadrant + 1) & 2) != 0 ? -cc : cc;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::geometry
+
+#endif
@@ -10,11 +10,13 @@
 
 #include "eckit/geometry/polygon/LonLatPolygon.h"
 
+#include <algorithm>
 #include <cmath>
 #include <ostream>
 
 #include "eckit/exception/Exceptions.h"
 #include "eckit/geometry/CoordinateHelpers.h"
+#include "eckit/thread/ParallelFor.h"
 #include "eckit/types/FloatCompare.h"
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -37,15 +39,31 @@ inline double cross_product_analog(const Point2& A, const Point2& B, const Point
     return (A.x() - C.x()) * (B.y() - C.y()) - (A.y() - C.y()) * (B.x() - C.x());
 }
 
-inline int on_direction(double a, double b, double c) {
-    return a <= b && b <= c ? 1 : c <= b && b <= a ? -1
-                                                   : 0;
-};
-
-inline int on_side(const Point2& P, const Point2& A, const Point2& B) {
-    const auto p = cross_product_analog(P, A, B);
-    return is_approximately_equal(p, 0) ? 0 : p > 0 ? 1
-                                                    : -1;
+/// Edges per pass of the winding number loop
+constexpr size_t chunk = 64;
+
+/// Points per task of the batch point-in-polygon test
+constexpr size_t batch = 4096;
+
+/// Position of P relative to n edges A-B, in a loop that vectorises:
+/// - direction: if P is on (1) or under (-1) the upward edge in latitude, or neither (0),
+/// - side: if P is left (1), right (-1) or along the edge line (0), and
+/// - within: if P is between A and B in longitude.
+/// Ties resolve as in the scalar tests of the edges (an horizontal edge is upward)
+inline void on_edges(double lon, double lat, const double* alon, const double* alat, const double* blon,
+                     const double* blat, size_t n, int* direction, int* side, int* within) {
+    for (size_t i = 0; i < n; ++i) {
+        const int up   = static_cast<int>(alat[i] <= lat) & static_cast<int>(lat <= blat[i]);
+        const int down = static_cast<int>(blat[i] <= lat) & static_cast<int>(lat <= alat[i]);
+        direction[i]   = up - (down & (1 - up));
+
+        // n.b. cross_product_analog(P, A, B), compared to 0 as is_approximately_equal does with a 1e-10 tolerance
+        const double p = (lon - blon[i]) * (alat[i] - blat[i]) - (lat - blat[i]) * (alon[i] - blon[i]);
+        side[i]        = std::abs(p) <= 1e-10 ? 0 : p > 0 ? 1 : -1;
+
+        within[i] = static_cast<int>(alon[i] <= lon && lon <= blon[i])
+                    | static_cast<int>(blon[i] <= lon && lon <= alon[i]);
+    }
 }
 
 }  // namespace
@@ -55,7 +73,8 @@ inline int on_side(const Point2& P, const Point2& A, const Point2& B) {
 LonLatPolygon::LonLatPolygon(const std::vector<Point2>& points, bool includePoles) :
     container_type(points) {
     ASSERT(points.size() > 1);
-    ASSERT(is_approximately_equal(points.front()[LON], points.back()[LON]) && is_approximately_equal(points.front()[LAT], points.back()[LAT]));
+    ASSERT(is_approximately_equal(points.front()[LON], points.back()[LON])
+           && is_approximately_equal(points.front()[LAT], points.back()[LAT]));
 
     if (points.size() > 2) {
         clear();  // assumes reserved size is kept
@@ -89,6 +108,66 @@ LonLatPolygon::LonLatPolygon(const std::vector<Point2>& points, bool includePole
     ASSERT(is_approximately_greater_or_equal(90, max_[LAT]));
 
     quickCheckLongitude_ = is_approximately_greater_or_equal(360, max_[LON] - min_[LON]);
+
+    setupBands();
+}
+
+void LonLatPolygon::setupBands() {
+    const size_t edges  = size() - 1;
+    const double height = max_[LAT] - min_[LAT];
+
+    auto span = [this](size_t i) {
+        return std::minmax(operator[](i - 1)[LAT], operator[](i)[LAT]);
+    };
+
+    // n.b. an edge is in all the bands it spans, so halve the bands until the edges are not repeated too much
+    size_t nbands = std::min<size_t>(std::max<size_t>(edges / 4, 1), 1 << 16);
+    for (;; nbands /= 2) {
+        bands_.assign(nbands + 1, 0);
+        bandScale_ = height > 0 ? static_cast<double>(nbands) / height : 0;
+
+        size_t total = 0;
+        for (size_t i = 1; i < size(); ++i) {
+            const auto [lo, hi] = span(i);
+            for (size_t b = band(lo); b <= band(hi); ++b) {
+                bands_[b + 1]++;
+            }
+            total += band(hi) - band(lo) + 1;
+        }
+
+        if (nbands == 1 || total <= 8 * edges) {
+            for (size_t b = 0; b < nbands; ++b) {
+                bands_[b + 1] += bands_[b];
+            }
+
+            edgeALon_.resize(total);
+            edgeALat_.resize(total);
+            edgeBLon_.resize(total);
+            edgeBLat_.resize(total);
+            break;
+        }
+    }
+
+    // edges of each band, in polygon order
+    std::vector<size_t> next(bands_.begin(), bands_.end() - 1);
+    for (size_t i = 1; i < size(); ++i) {
+        const auto& A       = operator[](i - 1);
+        const auto& B       = operator[](i);
+        const auto [lo, hi] = span(i);
+        for (size_t b = band(lo); b <= band(hi); ++b) {
+            const size_t j = next[b]++;
+            edgeALon_[j]   = A[LON];
+            edgeALat_[j]   = A[LAT];
+            edgeBLon_[j]   = B[LON];
+            edgeBLat_[j]   = B[LAT];
+        }
+    }
+}
+
+size_t LonLatPolygon::band(double lat) const {
+    // n.b. monotonic in lat, so the band of a latitude between those of an edge ends is one the edge is in
+    const auto last = static_cast<double>(bands_.size() - 2);
+    return static_cast<size_t>(std::min(std::max(0., std::floor((lat - min_[LAT]) * bandScale_)), last));
 }
 
 void LonLatPolygon::print(std::ostream& out) const {
@@ -133,28 +212,39 @@ bool LonLatPolygon::contains(const Point2& Plonlat, bool normalise_angle) const
         }
     }
 
+    // only the edges spanning the point latitude take part, these are in its band
+    const size_t b     = band(lat);
+    const size_t begin = bands_[b];
+    const size_t end   = bands_[b + 1];
+
+    int direction[chunk];
+    int side[chunk];
+    int within[chunk];
+
     do {
         // winding number
         int wn   = 0;
         int prev = 0;
 
         // loop on polygon edges
-        for (size_t i = 1; i < size(); ++i) {
-            const auto& A = operator[](i - 1);
-            const auto& B = operator[](i);
+        for (size_t i = begin; i < end; i += chunk) {
+            const size_t n = std::min(chunk, end - i);
+            on_edges(lon, lat, &edgeALon_[i], &edgeALat_[i], &edgeBLon_[i], &edgeBLat_[i], n, direction, side, within);
 
-            // check point-edge side and direction, testing if P is on|above|below (in latitude) of a A,B polygon edge, by:
+            // check point-edge side and direction, testing if P is on|above|below (in latitude) of a A,B polygon
+            // edge, by:
             // - intersecting "up" on forward crossing & P above edge, or
             // - intersecting "down" on backward crossing & P below edge
-            const auto direction = on_direction(A[LAT], lat, B[LAT]);
-            if (direction != 0) {
-                const auto side = on_side({lon, lat}, A, B);
-                if (side == 0 && on_direction(A[LON], lon, B[LON]) != 0) {
-                    return true;
-                }
-                if ((prev != 1 && direction > 0 && side > 0) || (prev != -1 && direction < 0 && side < 0)) {
-                    prev = direction;
-                    wn += direction;
+            for (size_t j = 0; j < n; ++j) {
+                if (direction[j] != 0) {
+                    if (side[j] == 0 && within[j] != 0) {
+                        return true;
+                    }
+                    if ((prev != 1 && direction[j] > 0 && side[j] > 0)
+                        || (prev != -1 && direction[j] < 0 && side[j] < 0)) {
+                        prev = direction[j];
+                        wn += direction[j];
+                    }
                 }
             }
         }
@@ -170,6 +260,14 @@ bool LonLatPolygon::contains(const Point2& Plonlat, bool normalise_angle) const
     return false;
 }
 
+void LonLatPolygon::contains(const Point2* points, size_t n, bool* result, bool normalise_angle, size_t threads) const {
+    parallelFor(n, batch, threads, [=](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result[i] = contains(points[i], normalise_angle);
+        }
+    });
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::geometry::polygon
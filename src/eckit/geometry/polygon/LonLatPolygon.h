@@ -62,9 +62,20 @@ public:
     /// @return if point (lon,lat) is in polygon
     bool contains(const Point2& Plonlat, bool normalise_angle = false) const;
 
+    /// @brief Point-in-polygon test of many points (as above), shared out to threads
+    /// @param[in] points given points (lon,lat)
+    /// @param[in] n number of points
+    /// @param[out] result result[i] is if points[i] is in polygon
+    /// @param[in] normalise_angle normalise point angles
+    /// @param[in] threads number of threads (0: as many as the workers, see parallelFor)
+    void contains(const Point2* points, size_t n, bool* result, bool normalise_angle = false, size_t threads = 0) const;
+
 private:
     // -- Methods
 
+    void setupBands();
+    size_t band(double lat) const;
+
     void print(std::ostream&) const;
     friend std::ostream& operator<<(std::ostream&, const LonLatPolygon&);
 
@@ -75,6 +86,15 @@ private:
     bool includeNorthPole_;
     bool includeSouthPole_;
     bool quickCheckLongitude_;
+
+    // Edges by latitude band: the edges crossing band b, in polygon order, are [bands_[b], bands_[b + 1]) of the
+    // edge coordinate arrays (edge from A to B)
+    std::vector<size_t> bands_;
+    std::vector<double> edgeALon_;
+    std::vector<double> edgeALat_;
+    std::vector<double> edgeBLon_;
+    std::vector<double> edgeBLat_;
+    double bandScale_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
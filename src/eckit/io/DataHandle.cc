@@ -8,6 +8,9 @@
  * does it submit to any jurisdiction.
  */
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
 #include <cmath>
 #include <cstring>
 
@@ -26,6 +29,10 @@
 #include "eckit/log/Timer.h"
 #include "eckit/runtime/Metrics.h"
 
+#if eckit_HAVE_SENDFILE
+#include <sys/sendfile.h>
+#endif
+
 
 namespace eckit {
 
@@ -51,6 +58,174 @@ AutoClose::~AutoClose() noexcept(false) {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+namespace {
+
+// Errors meaning the kernel cannot move data between these two descriptors, rather than a failure of the transfer
+
+bool noKernelPath(int e) {
+    return e == EINVAL || e == ENOSYS || e == EXDEV || e == EOPNOTSUPP || e == EBADF || e == ESPIPE;
+}
+
+// Largest amount requested from the kernel in one call (sendfile() caps at 0x7ffff000 anyway)
+
+constexpr long long maxChunk = 1LL << 30;
+
+size_t chunk(long long total, long long length) {
+    return length < 0 ? maxChunk : std::min(maxChunk, length - total);
+}
+
+// Drives `move` until `length` bytes (or end of input when negative) have been moved.
+// Returns -1, having moved nothing, if the first call reports that this path is not available
+
+template <typename Move>
+long long kernelMove(const char* what, long long length, Move move) {
+    long long total = 0;
+    while (length < 0 || total < length) {
+        ssize_t n = move(chunk(total, length));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (total == 0 && noKernelPath(errno)) {
+                return -1;
+            }
+            throw FailedSystemCall(what, Here(), errno);
+        }
+        if (n == 0) {
+            // Some pseudo filesystems report 0 instead of an error, let the next method confirm the end of input
+            return total == 0 ? -1 : total;
+        }
+        total += n;
+    }
+    return total;
+}
+
+#if eckit_HAVE_SPLICE
+
+// Splice through a pipe, which works as soon as either end is a socket, a pipe or a regular file
+
+long long splicePipe(int in, int out, long long length) {
+
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC) != 0) {
+        return -1;
+    }
+
+    struct ClosePipe {
+        int* fds_;
+        ~ClosePipe() {
+            ::close(fds_[0]);
+            ::close(fds_[1]);
+        }
+    } closer{fds};
+
+    static const long pipeSize = Resource<long>("zeroCopyPipeSize", 1024 * 1024);
+    ::fcntl(fds[1], F_SETPIPE_SZ, pipeSize);  // Best effort, limited by /proc/sys/fs/pipe-max-size
+
+    bool spliceOut = true;
+
+    // Empty the pipe into `out`. Bytes already taken from `in` cannot be put back, so if `out` refuses
+    // splice() they go through a small buffer instead
+
+    auto drain = [&](ssize_t left) {
+        while (left > 0) {
+            ssize_t n = -1;
+            if (spliceOut) {
+                n = ::splice(fds[0], nullptr, out, nullptr, left, SPLICE_F_MOVE | SPLICE_F_MORE);
+                if (n < 0 && noKernelPath(errno)) {
+                    spliceOut = false;
+                    continue;
+                }
+            }
+            else {
+                char buffer[64 * 1024];
+                n = ::read(fds[0], buffer, std::min<ssize_t>(left, sizeof(buffer)));
+                for (ssize_t done = 0; n > 0 && done < n;) {
+                    ssize_t w = ::write(out, buffer + done, n - done);
+                    if (w < 0 && errno != EINTR) {
+                        throw FailedSystemCall("write", Here(), errno);
+                    }
+                    done += std::max<ssize_t>(w, 0);
+                }
+            }
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw FailedSystemCall("splice", Here(), errno);
+            }
+            left -= n;
+        }
+    };
+
+    return kernelMove("splice", length, [&](size_t n) {
+        ssize_t len = ::splice(in, nullptr, fds[1], nullptr, n, SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (len > 0) {
+            drain(len);
+        }
+        return len;
+    });
+}
+
+#endif
+
+// Move the data between the descriptors of two opened handles without copying it through user space,
+// using the first of copy_file_range(), sendfile() or splice() supported by the pair of descriptors.
+// Returns the number of bytes moved, or -1 if there is no such path and nothing was consumed.
+// The watcher is told which path was taken
+
+long long kernelTransfer(DataHandle& from, DataHandle& to, long long length, TransferWatcher& watcher) {
+
+    static const bool zeroCopy = Resource<bool>("zeroCopyTransfer;$ECKIT_DATAHANDLE_ZERO_COPY", true);
+
+    if (!zeroCopy) {
+        return -1;
+    }
+
+    int in  = from.fileDescriptor();
+    int out = to.fileDescriptor();
+
+    if (in < 0 || out < 0) {
+        return -1;
+    }
+
+    long long total = -1;
+
+#if eckit_HAVE_COPY_FILE_RANGE
+    total = kernelMove("copy_file_range", length,
+                       [&](size_t n) { return ::copy_file_range(in, nullptr, out, nullptr, n, 0); });
+    if (total >= 0) {
+        Log::debug<LibEcKit>() << "DataHandle transfer with copy_file_range()" << std::endl;
+        watcher.movedInKernel("copy_file_range", total);
+        return total;
+    }
+#endif
+
+#if eckit_HAVE_SENDFILE
+    total = kernelMove("sendfile", length, [&](size_t n) { return ::sendfile(out, in, nullptr, n); });
+    if (total >= 0) {
+        Log::debug<LibEcKit>() << "DataHandle transfer with sendfile()" << std::endl;
+        watcher.movedInKernel("sendfile", total);
+        return total;
+    }
+#endif
+
+#if eckit_HAVE_SPLICE
+    total = splicePipe(in, out, length);
+    if (total >= 0) {
+        Log::debug<LibEcKit>() << "DataHandle transfer with splice()" << std::endl;
+        watcher.movedInKernel("splice", total);
+        return total;
+    }
+#endif
+
+    return total;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
 
 ClassSpec DataHandle::classSpec_ = {
     &Streamable::classSpec(),
@@ -103,8 +278,6 @@ Length DataHandle::saveInto(DataHandle& other, TransferWatcher& watcher) {
     static const long bufsize = Resource<long>("bufferSize;$ECKIT_DATAHANDLE_SAVEINTO_BUFFER_SIZE",
                                                64 * 1024 * 1024);
 
-    Buffer buffer(bufsize);
-
     watcher.watch(0, 0);
 
     Length estimate = openForRead();
@@ -123,7 +296,21 @@ Length DataHandle::saveInto(DataHandle& other, TransferWatcher& watcher) {
     double writeTime = 0;
     double lastWrite = 0;
     Timer timer("Save into");
-    bool more = true;
+
+    // If nobody needs to see the data, try to keep it in the kernel
+
+    long long moved = watcher.watchesData() ? -1 : kernelTransfer(*this, other, -1, watcher);
+    bool more       = (moved < 0);
+
+    if (!more) {
+        total     = moved;
+        length    = 0;
+        readTime  = timer.elapsed();
+        writeTime = readTime;
+        progress(total);
+    }
+
+    Buffer buffer(more ? bufsize : 0);
 
     while (more) {
         more = false;
@@ -187,6 +374,7 @@ Length DataHandle::saveInto(DataHandle& other, TransferWatcher& watcher) {
     Metrics::set("read_time", readTime);
     Metrics::set("write_time", writeTime);
     Metrics::set("double_buffering", false);
+    Metrics::set("zero_copy", moved >= 0);
 
     return total;
 }
@@ -201,7 +389,6 @@ Length DataHandle::copyTo(DataHandle& other, long bufsize, Length maxsize, Trans
     if (bufsize == -1) {
         bufsize = Resource<long>("bufferSize;$ECKIT_DATAHANDLE_COPYTO_BUFFER_SIZE", 64 * 1024 * 1024);
     }
-    Buffer buffer(bufsize);
 
     Length estimate = openForRead();
     watcher.fromHandleOpened();
@@ -216,7 +403,22 @@ Length DataHandle::copyTo(DataHandle& other, long bufsize, Length maxsize, Trans
     Length total = 0;
     long length  = -1;
 
-    while ((toRead <= Length(0) || total < toRead) && (length = read(buffer, toRead <= Length(0) ? bufsize : std::min(bufsize, (long)(toRead - total)))) > 0) {
+    const long long limit = toRead <= Length(0) ? -1 : (long long)toRead;
+    long long moved       = watcher.watchesData() ? -1 : kernelTransfer(*this, other, limit, watcher);
+    if (moved >= 0) {
+        total  = moved;
+        length = 0;
+    }
+
+    Buffer buffer(moved < 0 ? bufsize : 0);
+
+    while (moved < 0 && (toRead <= Length(0) || total < toRead)) {
+
+        long size = (toRead <= Length(0)) ? bufsize : std::min(bufsize, long(toRead - total));
+        length    = read(buffer, size);
+        if (length <= 0) {
+            break;
+        }
 
         if (other.write((const char*)buffer, length) != length) {
             throw WriteError(name() + " into " + other.name());
@@ -147,6 +147,11 @@ public:
 
     virtual bool doubleBufferOK() const { return true; }
 
+    // File descriptor of the opened handle, positioned where the next read() or write() would be,
+    // so that saveInto() and copyTo() can move the data inside the kernel. -1 if not available
+
+    virtual int fileDescriptor() { return -1; }
+
     // -- Overridden methods
 
     // From Streamble
@@ -194,6 +194,17 @@ void FileHandle::rewind() {
     ::rewind(file_);
 }
 
+int FileHandle::fileDescriptor() {
+    if (file_ == nullptr) {
+        return -1;
+    }
+    // Discard any read-ahead so that the descriptor offset is the logical position
+    if (::fflush(file_)) {
+        throw WriteError(std::string("fflush(") + name_ + ")", Here());
+    }
+    return ::fileno(file_);
+}
+
 Length FileHandle::size() {
     Stat::Struct info;
     SYSCALL(Stat::stat(name_.c_str(), &info));
@@ -63,6 +63,8 @@ public:
 
     bool moveable() const override { return true; }
 
+    int fileDescriptor() override;
+
     Offset seek(const Offset&) override;
     bool canSeek() const override;
     void skip(const Length&) override;
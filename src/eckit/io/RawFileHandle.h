@@ -43,6 +43,7 @@ public:
     Offset seek(const Offset&) override;
     bool canSeek() const override { return true; }
     void skip(const Length&) override;
+    int fileDescriptor() override { return fd_; }
 
     void encode(Stream&) const override;
 
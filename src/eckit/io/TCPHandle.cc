@@ -72,6 +72,10 @@ void TCPHandle::close() {
     connection_.close();
 }
 
+int TCPHandle::fileDescriptor() {
+    return connection_.socket();
+}
+
 void TCPHandle::rewind() {
     NOTIMP;
 }
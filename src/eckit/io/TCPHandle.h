@@ -53,6 +53,8 @@ public:
 
     bool canSeek() const override { return false; }
 
+    int fileDescriptor() override;
+
     virtual void selectMover(eckit::MoverTransferSelection&, bool) const override;
 
     // From Streamable
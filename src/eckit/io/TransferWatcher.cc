@@ -20,6 +20,7 @@ namespace eckit {
 
 struct DummyTransferWatcher : public TransferWatcher {
     void watch(const void*, long) {}
+    bool watchesData() const { return false; }
 };
 
 TransferWatcher& TransferWatcher::dummy() {
@@ -31,6 +31,13 @@ public:
     virtual void fromHandleOpened() {}
     virtual void toHandleOpened() {}
 
+    /// Whether watch() needs to see the bytes transferred. If not, they may bypass user space
+    virtual bool watchesData() const { return true; }
+
+    /// Called once the bytes have been moved inside the kernel, by method ("copy_file_range", "sendfile" or "splice"),
+    /// without going through watch()
+    virtual void movedInKernel(const char* /*method*/, long long /*bytes*/) {}
+
     virtual ~TransferWatcher() {}
 
     // -- Class methods
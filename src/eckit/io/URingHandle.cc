@@ -0,0 +1,744 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "eckit/eckit.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "eckit/config/LibEcKit.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/io/FDataSync.h"
+#include "eckit/io/URingHandle.h"
+#include "eckit/log/Log.h"
+#include "eckit/maths/Functions.h"
+#include "eckit/memory/MMap.h"
+#include "eckit/memory/NonCopyable.h"
+#include "eckit/os/Stat.h"
+
+#if eckit_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace detail {
+
+#if eckit_HAVE_IO_URING
+
+/// Minimal io_uring wrapper, using the raw system calls so that we don't depend on liburing
+
+class URing : private NonCopyable {
+public:  // methods
+    static URing* create(size_t entries, std::vector<struct iovec>& buffers) {
+        struct io_uring_params params;
+        ::memset(&params, 0, sizeof(params));
+
+        int fd = ::syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0) {
+            Log::debug<LibEcKit>() << "io_uring_setup: " << Log::syserr << ", using synchronous I/O" << std::endl;
+            return nullptr;
+        }
+
+        return new URing(fd, params, buffers);
+    }
+
+    ~URing() {
+        if (sqes_ != MAP_FAILED) {
+            MMap::munmap(sqes_, sqesSize_);
+        }
+        if (cq_ != MAP_FAILED && cq_ != sq_) {
+            MMap::munmap(cq_, cqSize_);
+        }
+        if (sq_ != MAP_FAILED) {
+            MMap::munmap(sq_, sqSize_);
+        }
+        ::close(fd_);
+    }
+
+    void prepare(bool read, int fd, size_t slot, off_t offset, size_t length) {
+        unsigned tail  = *sqTail_;
+        unsigned index = tail & *sqMask_;
+
+        ASSERT(tail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) < entries_);
+
+        struct io_uring_sqe* sqe = &sqes_[index];
+        ::memset(sqe, 0, sizeof(*sqe));
+
+        sqe->fd        = fd;
+        sqe->off       = offset;
+        sqe->user_data = slot;
+
+        if (registered_) {
+            sqe->opcode    = read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+            sqe->addr      = reinterpret_cast<unsigned long>(buffers_[slot].iov_base);
+            sqe->len       = length;
+            sqe->buf_index = slot;
+        }
+        else {
+            iovecs_[slot].iov_base = buffers_[slot].iov_base;
+            iovecs_[slot].iov_len  = length;
+
+            sqe->opcode = read ? IORING_OP_READV : IORING_OP_WRITEV;
+            sqe->addr   = reinterpret_cast<unsigned long>(&iovecs_[slot]);
+            sqe->len    = 1;
+        }
+
+        sqArray_[index] = index;
+        __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+    }
+
+    /// Submits count prepared entries, optionally waiting for at least one completion
+    void enter(size_t count, bool wait) {
+        unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+        unsigned min   = wait ? 1 : 0;
+
+        while (count > 0 || min > 0) {
+            long n = ::syscall(__NR_io_uring_enter, fd_, count, min, flags, nullptr, 0);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw FailedSystemCall("io_uring_enter", Here());
+            }
+            count -= std::min<size_t>(count, n);
+            min = 0;
+        }
+    }
+
+    /// Pops one completion, returns false if none is available
+    bool pop(size_t& slot, long& result) {
+        unsigned head = *cqHead_;
+        if (head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+
+        const struct io_uring_cqe& cqe = cqes_[head & *cqMask_];
+
+        slot   = cqe.user_data;
+        result = cqe.res;
+
+        __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    bool registered() const { return registered_; }
+
+private:  // methods
+    URing(int fd, const struct io_uring_params& params, std::vector<struct iovec>& buffers) :
+        fd_(fd), entries_(params.sq_entries), buffers_(buffers), iovecs_(buffers) {
+
+        sqSize_   = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqSize_   = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        sqesSize_ = params.sq_entries * sizeof(struct io_uring_sqe);
+
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) {
+            sqSize_ = cqSize_ = std::max(sqSize_, cqSize_);
+        }
+
+        sq_ = MMap::mmap(nullptr, sqSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        if (sq_ == MAP_FAILED) {
+            ::close(fd_);
+            throw FailedSystemCall("mmap io_uring submission queue", Here());
+        }
+
+        cq_ = single ? sq_
+                     : MMap::mmap(nullptr, cqSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                                  IORING_OFF_CQ_RING);
+        if (cq_ == MAP_FAILED) {
+            MMap::munmap(sq_, sqSize_);
+            ::close(fd_);
+            throw FailedSystemCall("mmap io_uring completion queue", Here());
+        }
+
+        sqes_ = static_cast<struct io_uring_sqe*>(
+            MMap::mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES));
+        if (sqes_ == MAP_FAILED) {
+            if (cq_ != sq_) {
+                MMap::munmap(cq_, cqSize_);
+            }
+            MMap::munmap(sq_, sqSize_);
+            ::close(fd_);
+            throw FailedSystemCall("mmap io_uring submission entries", Here());
+        }
+
+        char* sq = static_cast<char*>(sq_);
+        sqHead_  = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail_  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask_  = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        char* cq = static_cast<char*>(cq_);
+        cqHead_  = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail_  = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask_  = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_    = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // Registered buffers avoid mapping the user pages on every request, but count against RLIMIT_MEMLOCK
+        registered_ = ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, buffers_.data(),
+                                buffers_.size()) == 0;
+        if (!registered_) {
+            Log::debug<LibEcKit>() << "io_uring_register: " << Log::syserr << ", using unregistered buffers"
+                                   << std::endl;
+        }
+    }
+
+private:  // members
+    int fd_;
+    unsigned entries_;
+
+    std::vector<struct iovec> buffers_;
+    std::vector<struct iovec> iovecs_;
+
+    void* sq_ = MAP_FAILED;
+    void* cq_ = MAP_FAILED;
+    struct io_uring_sqe* sqes_;
+
+    size_t sqSize_;
+    size_t cqSize_;
+    size_t sqesSize_;
+
+    unsigned* sqHead_;
+    unsigned* sqTail_;
+    unsigned* sqMask_;
+    unsigned* sqArray_;
+
+    unsigned* cqHead_;
+    unsigned* cqTail_;
+    unsigned* cqMask_;
+    struct io_uring_cqe* cqes_;
+
+    bool registered_;
+};
+
+#else  // NO eckit_HAVE_IO_URING
+
+class URing : private NonCopyable {
+public:  // methods
+    static URing* create(size_t, std::vector<struct iovec>&) { return nullptr; }
+
+    void prepare(bool, int, size_t, off_t, size_t) { NOTIMP; }
+    void enter(size_t, bool) { NOTIMP; }
+    bool pop(size_t&, long&) { NOTIMP; }
+};
+
+#endif
+
+}  // namespace detail
+
+//----------------------------------------------------------------------------------------------------------------------
+
+static size_t alignment() {
+    static size_t page = ::sysconf(_SC_PAGE_SIZE);
+    return page;
+}
+
+URingHandle::URingHandle(const PathName& path, size_t count, size_t buffsize, bool direct, bool fsync) :
+    path_(path),
+    memory_(nullptr),
+    count_(std::max<size_t>(count, 1)),
+    buffsize_(eckit::round(std::max<size_t>(buffsize, 1), alignment())),
+    batch_(std::max<size_t>(count_ / 4, 1)),
+    prepared_(0),
+    inflight_(0),
+    fd_(-1),
+    pos_(0),
+    next_(0),
+    end_(0),
+    filling_(-1),
+    direct_(direct),
+    fsync_(fsync),
+    read_(false) {}
+
+URingHandle::~URingHandle() {
+    if (fd_ != -1) {
+        try {
+            drain();
+        }
+        catch (std::exception& e) {
+            Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
+            Log::error() << "** Exception is ignored" << std::endl;
+        }
+        release();
+        ::close(fd_);
+    }
+}
+
+bool URingHandle::asynchronous() const {
+    return bool(ring_);
+}
+
+void URingHandle::open(int flags) {
+
+#ifdef O_DIRECT
+    if (direct_) {
+        fd_ = ::open(path_.localPath(), flags | O_DIRECT, 0777);
+        if (fd_ < 0 && errno == EINVAL) {
+            Log::warning() << "URingHandle: " << path_ << " does not support O_DIRECT" << std::endl;
+        }
+    }
+#endif
+
+    if (fd_ < 0) {
+        SYSCALL2(fd_ = ::open(path_.localPath(), flags, 0777), path_);
+    }
+
+    setup();
+}
+
+void URingHandle::setup() {
+    ASSERT(!memory_);
+
+    size_t length = count_ * buffsize_;
+
+    void* addr = MMap::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+        throw FailedSystemCall("mmap", Here());
+    }
+    memory_ = static_cast<char*>(addr);
+
+    slots_.clear();
+    slots_.resize(count_);
+
+    std::vector<struct iovec> buffers(count_);
+    for (size_t i = 0; i < count_; ++i) {
+        slots_[i].data_     = memory_ + i * buffsize_;
+        buffers[i].iov_base = slots_[i].data_;
+        buffers[i].iov_len  = buffsize_;
+    }
+
+    ring_.reset(detail::URing::create(count_, buffers));
+
+    fifo_.clear();
+    prepared_ = 0;
+    inflight_ = 0;
+    filling_  = -1;
+}
+
+void URingHandle::release() {
+    ring_.reset();
+    fifo_.clear();
+    slots_.clear();
+
+    if (memory_) {
+        MMap::munmap(memory_, count_ * buffsize_);
+        memory_ = nullptr;
+    }
+}
+
+Length URingHandle::openForRead() {
+    read_ = true;
+    open(O_RDONLY);
+
+    Stat::Struct info;
+    SYSCALL2(Stat::fstat(fd_, &info), path_);
+
+    end_  = info.st_size;
+    pos_  = 0;
+    next_ = 0;
+
+    readAhead();
+
+    return end_;
+}
+
+void URingHandle::openForWrite(const Length&) {
+    read_ = false;
+    open(O_WRONLY | O_CREAT | O_TRUNC);
+    pos_  = 0;
+    next_ = 0;
+}
+
+void URingHandle::openForAppend(const Length&) {
+    read_ = false;
+
+    // O_APPEND would ignore the offsets of the requests, which may complete out of order
+    open(O_WRONLY | O_CREAT);
+    SYSCALL2(pos_ = ::lseek(fd_, 0, SEEK_END), path_);
+    next_ = pos_;
+
+#ifdef O_DIRECT
+    int flags = ::fcntl(fd_, F_GETFL);
+    if ((flags & O_DIRECT) && (pos_ % alignment()) != 0) {
+        SYSCALL2(::fcntl(fd_, F_SETFL, flags & ~O_DIRECT), path_);
+    }
+#endif
+}
+
+void URingHandle::queue(size_t slot, size_t length) {
+    Slot& s = slots_[slot];
+
+    s.length_ = length;
+    s.error_  = 0;
+    s.busy_   = true;
+    s.done_   = false;
+
+    if (!ring_) {
+        long result = 0;
+        while (result < long(length)) {
+            long n = read_ ? ::pread(fd_, s.data_ + result, length - result, s.offset_ + result)
+                           : ::pwrite(fd_, s.data_ + result, length - result, s.offset_ + result);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                result = (n < 0) ? -errno : result;
+                break;
+            }
+            result += n;
+        }
+        complete(slot, result);
+        return;
+    }
+
+    ring_->prepare(read_, fd_, slot, s.offset_, length);
+
+    if (++prepared_ >= batch_) {
+        submit(false);
+    }
+}
+
+void URingHandle::submit(bool wait) {
+    if (!ring_) {
+        return;
+    }
+    ring_->enter(prepared_, wait);
+    inflight_ += prepared_;
+    prepared_ = 0;
+}
+
+void URingHandle::reap(bool wait) {
+    if (!ring_) {
+        return;
+    }
+
+    if (wait) {
+        submit(true);
+    }
+
+    size_t slot;
+    long result;
+    while (ring_->pop(slot, result)) {
+        ASSERT(inflight_ > 0);
+        inflight_--;
+        complete(slot, result);
+    }
+}
+
+void URingHandle::complete(size_t slot, long result) {
+    Slot& s = slots_[slot];
+
+    s.done_   = true;
+    s.result_ = std::max(result, 0L);
+
+    if (result < 0) {
+        if (read_) {
+            // n.b. the slot is still queued, the error is reported when read() reaches it
+            s.error_ = int(-result);
+            return;
+        }
+        s.busy_ = false;
+        std::ostringstream os;
+        os << "URingHandle: write of " << s.length_ << " bytes at offset " << s.offset_;
+        throw FailedSystemCall(path_.asString(), os.str().c_str(), Here(), int(-result));
+    }
+
+    if (size_t(result) < s.length_) {
+        // Short transfer, complete synchronously
+
+        if (read_) {
+            while (s.offset_ + result < end_ && size_t(result) < s.length_) {
+                long n = ::pread(fd_, s.data_ + result, s.length_ - result, s.offset_ + result);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n < 0) {
+                    s.error_ = errno;
+                    break;
+                }
+                if (n == 0) {
+                    break;
+                }
+                result += n;
+            }
+            s.result_ = result;
+        }
+        else {
+            const char* p = s.data_ + result;
+            size_t left   = s.length_ - result;
+            off_t where   = s.offset_ + result;
+            while (left > 0) {
+                long n = ::pwrite(fd_, p, left, where);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    s.busy_ = false;
+                    std::ostringstream os;
+                    os << "URingHandle: only " << (s.length_ - left) << " bytes written instead of " << s.length_;
+                    throw WriteError(os.str());
+                }
+                p += n;
+                left -= n;
+                where += n;
+            }
+            s.result_ = s.length_;
+        }
+    }
+
+    if (!read_) {
+        s.busy_ = false;
+    }
+}
+
+void URingHandle::drain() {
+    if (!ring_) {
+        return;
+    }
+    submit(false);
+    while (inflight_ > 0) {
+        reap(true);
+    }
+}
+
+size_t URingHandle::freeSlot() {
+    for (;;) {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (!slots_[i].busy_) {
+                return i;
+            }
+        }
+        ASSERT(ring_);
+        reap(true);
+    }
+}
+
+void URingHandle::readAhead() {
+    while (next_ < end_ && fifo_.size() < count_) {
+        size_t slot = freeSlot();
+
+        slots_[slot].offset_ = next_;
+        fifo_.push_back(slot);
+        queue(slot, buffsize_);
+
+        next_ += buffsize_;
+    }
+    submit(false);
+}
+
+long URingHandle::read(void* buffer, long length) {
+    ASSERT(read_);
+
+    char* p    = static_cast<char*>(buffer);
+    long total = 0;
+
+    while (length > 0 && !fifo_.empty()) {
+        Slot& s = slots_[fifo_.front()];
+
+        while (!s.done_) {
+            reap(true);
+        }
+
+        if (s.error_ != 0) {
+            const int err = s.error_;
+            s.busy_       = false;
+            fifo_.pop_front();
+
+            std::ostringstream os;
+            os << "URingHandle: read of " << s.length_ << " bytes at offset " << s.offset_;
+            throw FailedSystemCall(path_.asString(), os.str().c_str(), Here(), err);
+        }
+
+        if (pos_ < s.offset_) {  // file was truncated under our feet
+            break;
+        }
+
+        off_t last = s.offset_ + s.result_;
+        if (pos_ < last) {
+            long len = std::min<long>(length, last - pos_);
+            ::memcpy(p, s.data_ + (pos_ - s.offset_), len);
+            p += len;
+            pos_ += len;
+            total += len;
+            length -= len;
+        }
+
+        if (pos_ >= last) {
+            s.busy_ = false;
+            fifo_.pop_front();
+            readAhead();
+        }
+    }
+
+    return total;
+}
+
+void URingHandle::fill() {
+    Slot& s   = slots_[filling_];
+    s.offset_ = next_;
+    s.length_ = 0;
+    s.busy_   = true;
+    s.done_   = false;
+}
+
+long URingHandle::write(const void* buffer, long length) {
+    ASSERT(!read_);
+
+    const char* p = static_cast<const char*>(buffer);
+    long total    = 0;
+
+    while (length > 0) {
+        if (filling_ < 0) {
+            filling_ = freeSlot();
+            fill();
+        }
+
+        Slot& s = slots_[filling_];
+
+        long len = std::min<long>(length, buffsize_ - s.length_);
+        ::memcpy(s.data_ + s.length_, p, len);
+        s.length_ += len;
+        p += len;
+        total += len;
+        length -= len;
+
+        if (s.length_ == buffsize_) {
+            queue(filling_, buffsize_);
+            next_ += buffsize_;
+            filling_ = -1;
+        }
+    }
+
+    pos_ += total;
+    return total;
+}
+
+void URingHandle::flushSlot() {
+    if (filling_ < 0) {
+        return;
+    }
+
+    size_t length = slots_[filling_].length_;
+
+    if (length == 0) {
+        slots_[filling_].busy_ = false;
+        filling_               = -1;
+        return;
+    }
+
+#ifdef O_DIRECT
+    int flags = ::fcntl(fd_, F_GETFL);
+    if ((flags & O_DIRECT) && (length % alignment()) != 0) {
+        // Direct I/O requires aligned sizes, so the tail is written through the page cache
+        drain();
+        SYSCALL2(::fcntl(fd_, F_SETFL, flags & ~O_DIRECT), path_);
+    }
+#endif
+
+    queue(filling_, length);
+    next_ += length;
+    filling_ = -1;
+}
+
+void URingHandle::flush() {
+    if (fd_ == -1 || read_) {
+        return;
+    }
+
+    flushSlot();
+    drain();
+
+    if (fsync_) {
+        SYSCALL2(eckit::fsync(fd_), path_);
+    }
+}
+
+void URingHandle::close() {
+    if (fd_ != -1) {
+        if (read_) {
+            drain();  // wait for the read-ahead requests, the kernel still writes into our buffers
+        }
+        else {
+            flush();  // this waits for the async requests to finish
+        }
+        release();
+        SYSCALL(::close(fd_));
+        fd_ = -1;
+    }
+}
+
+Offset URingHandle::seek(const Offset& offset) {
+    ASSERT(read_);
+
+    drain();
+
+    for (auto& s : slots_) {
+        s.busy_ = false;
+    }
+    fifo_.clear();
+
+    pos_  = offset;
+    next_ = direct_ ? (pos_ / alignment()) * alignment() : pos_;
+
+    readAhead();
+
+    return pos_;
+}
+
+void URingHandle::skip(const Length& length) {
+    seek(pos_ + length);
+}
+
+void URingHandle::rewind() {
+    if (!read_) {
+        NOTIMP;
+    }
+    seek(0);
+}
+
+void URingHandle::print(std::ostream& s) const {
+    s << "URingHandle[" << path_ << ']';
+}
+
+Length URingHandle::size() {
+    Stat::Struct info;
+    if (fd_ != -1) {
+        SYSCALL2(Stat::fstat(fd_, &info), path_);
+    }
+    else {
+        SYSCALL2(Stat::stat(path_.localPath(), &info), path_);
+    }
+    return info.st_size;
+}
+
+Length URingHandle::estimate() {
+    return size();
+}
+
+Offset URingHandle::position() {
+    return pos_;
+}
+
+std::string URingHandle::title() const {
+    return std::string("URing[") + PathName::shorten(path_) + "]";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
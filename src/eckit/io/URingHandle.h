@@ -0,0 +1,130 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+/// @date   Oct 2026
+
+#ifndef eckit_io_URingHandle_h
+#define eckit_io_URingHandle_h
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "eckit/filesystem/PathName.h"
+#include "eckit/io/DataHandle.h"
+
+namespace eckit {
+
+namespace detail {
+class URing;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Asynchronous file handle based on Linux io_uring.
+///
+/// The handle owns a pool of page-aligned buffers, registered with the kernel when possible. Writes are copied into
+/// these buffers and submitted in batches, reads are served from buffers filled ahead of the current position.
+/// When io_uring is not available (at build time, or refused by the kernel at run time) the same buffer pipeline
+/// is driven by synchronous pread/pwrite calls.
+
+class URingHandle : public DataHandle {
+
+public:  // methods
+    URingHandle(const PathName& path, size_t count = 16, size_t buffsize = 1024 * 1024, bool direct = false,
+                bool fsync = false);
+
+    ~URingHandle() override;
+
+    Length openForRead() override;
+    void openForWrite(const Length&) override;
+    void openForAppend(const Length&) override;
+
+    long read(void*, long) override;
+    long write(const void*, long) override;
+    void close() override;
+    void flush() override;
+    void rewind() override;
+    void print(std::ostream&) const override;
+
+    Length size() override;
+    Length estimate() override;
+    Offset position() override;
+    Offset seek(const Offset&) override;
+    void skip(const Length&) override;
+
+    bool canSeek() const override { return read_; }
+
+    /// @returns true if requests are handled by io_uring, false if using the synchronous fallback
+    bool asynchronous() const;
+
+private:  // types
+    struct Slot {
+        char* data_    = nullptr;
+        off_t offset_  = 0;
+        size_t length_ = 0;
+        long result_   = 0;  ///< bytes transferred
+        int error_     = 0;  ///< errno of a failed read, reported when read() reaches the slot
+        bool busy_     = false;
+        bool done_     = false;
+    };
+
+private:  // methods
+    void open(int flags);
+    void setup();
+    void release();
+
+    void queue(size_t slot, size_t length);
+    void submit(bool wait);
+    void reap(bool wait);
+    void complete(size_t slot, long result);
+    void drain();
+
+    size_t freeSlot();
+    void fill();
+    void flushSlot();
+    void readAhead();
+
+    std::string title() const override;
+
+protected:  // members
+    PathName path_;
+
+private:  // members
+    std::unique_ptr<detail::URing> ring_;
+
+    std::vector<Slot> slots_;
+    std::deque<size_t> fifo_;  // slots in request order
+
+    char* memory_;
+
+    size_t count_;
+    size_t buffsize_;
+    size_t batch_;
+    size_t prepared_;
+    size_t inflight_;
+
+    int fd_;
+    off_t pos_;   // logical position of the handle
+    off_t next_;  // offset of the next request
+    off_t end_;   // file size when reading
+
+    long filling_;  // slot being filled by write(), -1 if none
+
+    bool direct_;
+    bool fsync_;
+    bool read_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
+
+#endif
@@ -54,6 +54,20 @@ public:
     /// @note B does NOT need to be allocated/sized correctly
     virtual void dsptd(const Vector& x, const SparseMatrix& A, const Vector& y, SparseMatrix& B) const = 0;
 
+    // - Methods, single precision storage
+    //   The products accumulate in the precision of the output: a float matrix with double vectors/matrices
+    //   accumulates in double. Backends without single precision kernels use the generic backend.
+
+    /// Compute the product of a sparse matrix A and vector x
+    /// @note y must be allocated and sized correctly
+    virtual void spmv(const SparseMatrixFloat& A, const VectorFloat& x, VectorFloat& y) const;
+    virtual void spmv(const SparseMatrixFloat& A, const Vector& x, Vector& y) const;
+
+    /// Compute the product of sparse matrix A and dense matrix X
+    /// @note Y must be allocated and sized correctly
+    virtual void spmm(const SparseMatrixFloat& A, const MatrixFloat& X, MatrixFloat& Y) const;
+    virtual void spmm(const SparseMatrixFloat& A, const Matrix& X, Matrix& Y) const;
+
 protected:
     LinearAlgebraSparse() = default;
     LinearAlgebraSparse(const std::string& name);
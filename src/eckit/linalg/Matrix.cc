@@ -14,31 +14,36 @@
 
 #include "eckit/exception/Exceptions.h"
 #include "eckit/io/Buffer.h"
+#include "eckit/linalg/detail/Encoding.h"
 #include "eckit/serialisation/Stream.h"
 
 namespace eckit::linalg {
 
 //----------------------------------------------------------------------------------------------------------------------
 
-Matrix::Matrix() :
+template <typename S>
+MatrixT<S>::MatrixT() :
     array_(0), rows_(0), cols_(0), own_(false) {}
 
 
-Matrix::Matrix(Size rows, Size cols) :
-    array_(new Scalar[rows * cols]), rows_(rows), cols_(cols), own_(true) {
+template <typename S>
+MatrixT<S>::MatrixT(Size rows, Size cols) :
+    array_(new S[rows * cols]), rows_(rows), cols_(cols), own_(true) {
     ASSERT(size() > 0);
     ASSERT(array_);
 }
 
 
-Matrix::Matrix(const Scalar* array, Size rows, Size cols) :
-    array_(const_cast<Scalar*>(array)), rows_(rows), cols_(cols), own_(false) {
+template <typename S>
+MatrixT<S>::MatrixT(const S* array, Size rows, Size cols) :
+    array_(const_cast<S*>(array)), rows_(rows), cols_(cols), own_(false) {
     ASSERT(size() > 0);
     ASSERT(array_);
 }
 
 
-Matrix::Matrix(Stream& stream) :
+template <typename S>
+MatrixT<S>::MatrixT(Stream& stream) :
     array_(0), rows_(0), cols_(0), own_(false) {
     Size rows, cols;
     stream >> rows;
@@ -47,35 +52,39 @@ Matrix::Matrix(Stream& stream) :
 
     ASSERT(size() > 0);
     ASSERT(array_);
-    stream.readBlob(array_, (rows * cols) * sizeof(Scalar));
+    stream.readArray(array_, rows * cols);
 }
 
 
-Matrix::Matrix(const Matrix& other) :
-    array_(new Scalar[other.size()]), rows_(other.rows_), cols_(other.cols_), own_(true) {
+template <typename S>
+MatrixT<S>::MatrixT(const MatrixT& other) :
+    array_(new S[other.size()]), rows_(other.rows_), cols_(other.cols_), own_(true) {
     ASSERT(size() > 0);
     ASSERT(array_);
-    ::memcpy(array_, other.array_, size() * sizeof(Scalar));
+    ::memcpy(array_, other.array_, size() * sizeof(S));
 }
 
 
-Matrix::~Matrix() {
+template <typename S>
+MatrixT<S>::~MatrixT() {
     if (own_) {
         delete[] array_;
     }
 }
 
 
-Matrix& Matrix::operator=(const Matrix& other) {
+template <typename S>
+MatrixT<S>& MatrixT<S>::operator=(const MatrixT& other) {
     // do not optimize for if size()==other.size(), as using copy constructor
     // consistently retains ownership (no surprises in ownership behaviour)
-    Matrix copy(other);
+    MatrixT copy(other);
     swap(copy);
     return *this;
 }
 
 
-void Matrix::swap(Matrix& other) {
+template <typename S>
+void MatrixT<S>::swap(MatrixT& other) {
     std::swap(array_, other.array_);
     std::swap(rows_, other.rows_);
     std::swap(cols_, other.cols_);
@@ -83,10 +92,11 @@ void Matrix::swap(Matrix& other) {
 }
 
 
-void Matrix::resize(Size rows, Size cols) {
+template <typename S>
+void MatrixT<S>::resize(Size rows, Size cols) {
     // avoid reallocation if memory is the same
     if (size() != rows * cols) {
-        Matrix m(rows, cols);
+        MatrixT m(rows, cols);
         swap(m);
     }
     rows_ = rows;
@@ -94,32 +104,42 @@ void Matrix::resize(Size rows, Size cols) {
 }
 
 
-void Matrix::setZero() {
+template <typename S>
+void MatrixT<S>::setZero() {
     ASSERT(size() > 0);
     ASSERT(array_);
-    ::memset(array_, 0, size() * sizeof(Scalar));
+    ::memset(array_, 0, size() * sizeof(S));
 }
 
 
-void Matrix::fill(Scalar value) {
+template <typename S>
+void MatrixT<S>::fill(S value) {
     for (Size i = 0; i < size(); ++i) {
         array_[i] = value;
     }
 }
 
 
-void Matrix::encode(Stream& stream) const {
+template <typename S>
+void MatrixT<S>::encode(Stream& stream) const {
     stream << rows_;
     stream << cols_;
-    stream.writeBlob(const_cast<Scalar*>(array_), rows_ * cols_ * sizeof(Scalar));
+    detail::encodeArray(stream, array_, rows_ * cols_);
 }
 
 
-Stream& operator<<(Stream& stream, const Matrix& matrix) {
+template <typename S>
+Stream& operator<<(Stream& stream, const MatrixT<S>& matrix) {
     matrix.encode(stream);
     return stream;
 }
 
+template class MatrixT<double>;
+template class MatrixT<float>;
+
+template Stream& operator<<(Stream&, const MatrixT<double>&);
+template Stream& operator<<(Stream&, const MatrixT<float>&);
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::linalg
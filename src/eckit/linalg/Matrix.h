@@ -22,8 +22,9 @@ namespace eckit::linalg {
 
 //-----------------------------------------------------------------------------
 
-/// Dense matrix in column major storage order
-class Matrix {
+/// Dense matrix in column major storage order, of double (Matrix) or float (MatrixFloat) entries
+template <typename S>
+class MatrixT {
 public:  // types
     using Size = linalg::Size;
 
@@ -31,29 +32,29 @@ public:  // methods
     // -- Constructors
 
     /// Default constructor (empty matrix)
-    Matrix();
+    MatrixT();
 
     /// Construct matrix with given rows and columns (allocates memory, not initialised)
-    Matrix(Size rows, Size cols);
+    MatrixT(Size rows, Size cols);
 
     /// Construct matrix from existing data (does NOT take ownership)
-    Matrix(const Scalar* array, Size rows, Size cols);
+    MatrixT(const S* array, Size rows, Size cols);
 
     /// Constructor from Stream
-    Matrix(Stream&);
+    MatrixT(Stream&);
 
     /// Copy constructor
-    Matrix(const Matrix&);
+    MatrixT(const MatrixT&);
 
     /// Destructor
-    ~Matrix();
+    ~MatrixT();
 
     // -- Mutators
 
-    Matrix& operator=(const Matrix&);
+    MatrixT& operator=(const MatrixT&);
 
     /// Swap this matrix with another
-    void swap(Matrix&);
+    void swap(MatrixT&);
 
     /// Resize matrix to given number of rows/columns (invalidates data)
     void resize(Size rows, Size cols);
@@ -62,7 +63,7 @@ public:  // methods
     void setZero();
 
     /// Fill vector with given scalar
-    void fill(Scalar);
+    void fill(S);
 
     // -- Serialisation
 
@@ -82,33 +83,33 @@ public:  // methods
 
     /// Access by row and column
     /// @note implements column-major (Fortran-style) ordering
-    Scalar& operator()(Size row, Size col) { return array_[col * rows_ + row]; }
-    const Scalar& operator()(Size row, Size col) const { return array_[col * rows_ + row]; }
+    S& operator()(Size row, Size col) { return array_[col * rows_ + row]; }
+    const S& operator()(Size row, Size col) const { return array_[col * rows_ + row]; }
 
     /// Access to linearised storage
-    Scalar& operator[](Size i) { return array_[i]; }
-    const Scalar& operator[](Size i) const { return array_[i]; }
+    S& operator[](Size i) { return array_[i]; }
+    const S& operator[](Size i) const { return array_[i]; }
 
     /// @returns modifiable view of the data
-    Scalar* data() { return array_; }
+    S* data() { return array_; }
     /// @returns read-only view of the data
-    const Scalar* data() const { return array_; }
+    const S* data() const { return array_; }
 
     /// @returns iterator to beginning of the data
-    Scalar* begin() { return array_; }
+    S* begin() { return array_; }
 
     /// @returns const iterator to beginning of the data
-    const Scalar* begin() const { return array_; }
+    const S* begin() const { return array_; }
 
     /// @returns iterator to end of the data
-    Scalar* end() { return array_ + size(); }
+    S* end() { return array_ + size(); }
 
     /// @returns const iterator to end of the data
-    const Scalar* end() const { return array_ + size(); }
+    const S* end() const { return array_ + size(); }
 
 protected:  // member variables
     /// Container
-    Scalar* array_;
+    S* array_;
 
     /// Number of rows
     Size rows_;
@@ -121,7 +122,8 @@ protected:  // member variables
 };
 
 
-Stream& operator<<(Stream&, const Matrix&);
+template <typename S>
+Stream& operator<<(Stream&, const MatrixT<S>&);
 
 
 //-----------------------------------------------------------------------------
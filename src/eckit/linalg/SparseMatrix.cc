@@ -15,6 +15,8 @@
 #include <cstring>
 #include <iterator>
 #include <numeric>
+#include <type_traits>
+#include <vector>
 
 #include "eckit/eckit.h"  // for endianness
 
@@ -24,6 +26,7 @@
 #include "eckit/io/AutoCloser.h"
 #include "eckit/io/BufferedHandle.h"
 #include "eckit/io/MemoryHandle.h"
+#include "eckit/linalg/detail/Encoding.h"
 #include "eckit/log/Bytes.h"
 #include "eckit/memory/MemoryBuffer.h"
 #include "eckit/serialisation/FileStream.h"
@@ -41,29 +44,33 @@ static const bool littleEndian = false;
 
 namespace detail {
 
-class StandardAllocator : public SparseMatrix::Allocator {
+template <typename S>
+class StandardAllocator : public SparseMatrixT<S>::Allocator {
 public:
+    using Layout = typename SparseMatrixT<S>::Layout;
+    using Shape  = typename SparseMatrixT<S>::Shape;
+
     StandardAllocator() :
         membuff_(0) {}
 
-    virtual SparseMatrix::Layout allocate(SparseMatrix::Shape& shape) {
+    virtual Layout allocate(Shape& shape) {
 
         if (shape.allocSize() > membuff_.size()) {
             membuff_.resize(shape.allocSize());
         }
 
-        SparseMatrix::Layout p;
+        Layout p;
 
         char* addr = membuff_;
 
-        p.data_  = reinterpret_cast<Scalar*>(addr);
+        p.data_  = reinterpret_cast<S*>(addr);
         p.outer_ = reinterpret_cast<Index*>(addr + shape.sizeofData());
         p.inner_ = reinterpret_cast<Index*>(addr + shape.sizeofData() + shape.sizeofOuter());
 
         return p;
     }
 
-    virtual void deallocate(SparseMatrix::Layout p, SparseMatrix::Shape) {}
+    virtual void deallocate(Layout p, Shape) {}
 
     virtual bool inSharedMemory() const { return false; }
 
@@ -72,23 +79,25 @@ public:
     eckit::MemoryBuffer membuff_;
 };
 
-class BufferAllocator : public SparseMatrix::Allocator {
+template <typename S>
+class BufferAllocator : public SparseMatrixT<S>::Allocator {
 public:
+    using Layout = typename SparseMatrixT<S>::Layout;
+    using Shape  = typename SparseMatrixT<S>::Shape;
+
     BufferAllocator(const MemoryBuffer& buffer) :
         buffer_(buffer, buffer.size()) {}
 
-    virtual eckit::linalg::SparseMatrix::Layout allocate(eckit::linalg::SparseMatrix::Shape& shape) {
+    virtual Layout allocate(Shape& shape) {
 
-        using namespace eckit::linalg;
+        Layout layout;
 
-        SparseMatrix::Layout layout;
-
-        eckit::linalg::SparseMatrix::load(buffer_.data(), buffer_.size(), layout, shape);
+        SparseMatrixT<S>::load(buffer_.data(), buffer_.size(), layout, shape);
 
         return layout;
     }
 
-    virtual void deallocate(eckit::linalg::SparseMatrix::Layout, eckit::linalg::SparseMatrix::Shape) {}
+    virtual void deallocate(Layout, Shape) {}
 
     virtual bool inSharedMemory() const { return false; }
 
@@ -101,18 +110,21 @@ public:
 
 //----------------------------------------------------------------------------------------------------------------------
 
-SparseMatrix::SparseMatrix(Allocator* alloc) {
-    owner_.reset(alloc ? alloc : new detail::StandardAllocator());
+template <typename S>
+SparseMatrixT<S>::SparseMatrixT(Allocator* alloc) {
+    owner_.reset(alloc ? alloc : new detail::StandardAllocator<S>());
     spm_ = owner_->allocate(shape_);
 }
 
-SparseMatrix::SparseMatrix(Size rows, Size cols, Allocator* alloc) {
-    owner_.reset(alloc ? alloc : new detail::StandardAllocator());
+template <typename S>
+SparseMatrixT<S>::SparseMatrixT(Size rows, Size cols, Allocator* alloc) {
+    owner_.reset(alloc ? alloc : new detail::StandardAllocator<S>());
     reserve(rows, cols, 1);
 }
 
-SparseMatrix::SparseMatrix(Size rows, Size cols, const std::vector<Triplet>& triplets) :
-    owner_(new detail::StandardAllocator()) {
+template <typename S>
+SparseMatrixT<S>::SparseMatrixT(Size rows, Size cols, const std::vector<Triplet>& triplets) :
+    owner_(new detail::StandardAllocator<S>()) {
 
     // Count number of non-zeros
     Size nnz{0};
@@ -146,7 +158,7 @@ SparseMatrix::SparseMatrix(Size rows, Size cols, const std::vector<Triplet>& tri
             }
 
             spm_.inner_[pos] = Index(it->col());
-            spm_.data_[pos]  = it->value();
+            spm_.data_[pos]  = static_cast<S>(it->value());
             ++pos;
         }
     }
@@ -159,19 +171,22 @@ SparseMatrix::SparseMatrix(Size rows, Size cols, const std::vector<Triplet>& tri
 }
 
 
-SparseMatrix::SparseMatrix(Stream& s) {
-    owner_.reset(new detail::StandardAllocator());
+template <typename S>
+SparseMatrixT<S>::SparseMatrixT(Stream& s) {
+    owner_.reset(new detail::StandardAllocator<S>());
     decode(s);
 }
 
-SparseMatrix::SparseMatrix(const MemoryBuffer& buffer) {
-    owner_.reset(new detail::BufferAllocator(buffer));
+template <typename S>
+SparseMatrixT<S>::SparseMatrixT(const MemoryBuffer& buffer) {
+    owner_.reset(new detail::BufferAllocator<S>(buffer));
     spm_ = owner_->allocate(shape_);
 }
 
-SparseMatrix::SparseMatrix(const SparseMatrix& other) {
+template <typename S>
+SparseMatrixT<S>::SparseMatrixT(const SparseMatrixT& other) {
 
-    owner_.reset(new detail::StandardAllocator());
+    owner_.reset(new detail::StandardAllocator<S>());
 
     if (!other.empty()) {  // in case we copy an other that was constructed empty
 
@@ -183,22 +198,26 @@ SparseMatrix::SparseMatrix(const SparseMatrix& other) {
     }
 }
 
-SparseMatrix::SparseMatrix(SparseMatrix&& other) :
-    SparseMatrix() {
+template <typename S>
+SparseMatrixT<S>::SparseMatrixT(SparseMatrixT&& other) :
+    SparseMatrixT() {
     swap(other);
 }
 
-SparseMatrix& SparseMatrix::operator=(const SparseMatrix& other) {
-    SparseMatrix copy(other);
+template <typename S>
+SparseMatrixT<S>& SparseMatrixT<S>::operator=(const SparseMatrixT& other) {
+    SparseMatrixT copy(other);
     swap(copy);
     return *this;
 }
 
-SparseMatrix::~SparseMatrix() {
+template <typename S>
+SparseMatrixT<S>::~SparseMatrixT() {
     reset();
 }
 
-void SparseMatrix::reset() {
+template <typename S>
+void SparseMatrixT<S>::reset() {
 
     owner_->deallocate(spm_, shape_);
 
@@ -208,7 +227,8 @@ void SparseMatrix::reset() {
 
 
 // variables into this method must be by value
-void SparseMatrix::reserve(Size rows, Size cols, Size nnz) {
+template <typename S>
+void SparseMatrixT<S>::reserve(Size rows, Size cols, Size nnz) {
 
     ASSERT(nnz > 0);
     ASSERT(nnz <= rows * cols);
@@ -224,14 +244,16 @@ void SparseMatrix::reserve(Size rows, Size cols, Size nnz) {
 }
 
 
-void SparseMatrix::save(const eckit::PathName& path) const {
+template <typename S>
+void SparseMatrixT<S>::save(const eckit::PathName& path) const {
     FileStream s(path, "w");
     auto c = closer(s);
     encode(s);
 }
 
 
-void SparseMatrix::load(const eckit::PathName& path) {
+template <typename S>
+void SparseMatrixT<S>::load(const eckit::PathName& path) {
     FileStream s(path, "r");
     auto c = closer(s);
     decode(s);
@@ -246,7 +268,8 @@ struct SPMInfo {
     ptrdiff_t inner_;
 };
 
-void SparseMatrix::load(const void* buffer, size_t bufferSize, Layout& layout, Shape& shape) {
+template <typename S>
+void SparseMatrixT<S>::load(const void* buffer, size_t bufferSize, Layout& layout, Shape& shape) {
     const char* b = static_cast<const char*>(buffer);
 
     eckit::MemoryHandle mh(buffer, bufferSize);
@@ -270,9 +293,12 @@ void SparseMatrix::load(const void* buffer, size_t bufferSize, Layout& layout, S
 
     ASSERT(bufferSize >= sizeof(SPMInfo) + shape.sizeofData() + shape.sizeofOuter() + shape.sizeofInner());
 
+    // the entries are not converted, so they must have been dumped with the same precision
+    ASSERT(info.outer_ - info.data_ == static_cast<ptrdiff_t>(shape.sizeofData()));
+
     char* addr = const_cast<char*>(b);
 
-    layout.data_  = reinterpret_cast<Scalar*>(addr + info.data_);
+    layout.data_  = reinterpret_cast<S*>(addr + info.data_);
     layout.outer_ = reinterpret_cast<Index*>(addr + info.outer_);
     layout.inner_ = reinterpret_cast<Index*>(addr + info.inner_);
 
@@ -283,11 +309,13 @@ void SparseMatrix::load(const void* buffer, size_t bufferSize, Layout& layout, S
     ASSERT(info.inner_ + shape.sizeofInner() <= bufferSize);
 }
 
-void SparseMatrix::dump(MemoryBuffer& buffer) const {
-    SparseMatrix::dump(buffer.data(), buffer.size());
+template <typename S>
+void SparseMatrixT<S>::dump(MemoryBuffer& buffer) const {
+    SparseMatrixT::dump(buffer.data(), buffer.size());
 }
 
-void SparseMatrix::dump(void* buffer, size_t size) const {
+template <typename S>
+void SparseMatrixT<S>::dump(void* buffer, size_t size) const {
 
     size_t minimum = sizeof(SPMInfo) + shape_.sizeofData() + shape_.sizeofOuter() + shape_.sizeofInner();
     ASSERT(size >= minimum);
@@ -318,7 +346,8 @@ void SparseMatrix::dump(void* buffer, size_t size) const {
     ASSERT(mh.write(spm_.inner_, shape_.sizeofInner()) == long(shape_.sizeofInner()));
 }
 
-void SparseMatrix::swap(SparseMatrix& other) {
+template <typename S>
+void SparseMatrixT<S>::swap(SparseMatrixT& other) {
 
     std::swap(spm_, other.spm_);
     std::swap(shape_, other.shape_);
@@ -326,21 +355,25 @@ void SparseMatrix::swap(SparseMatrix& other) {
     owner_.swap(other.owner_);
 }
 
-void SparseMatrix::cols(Size cols) {
+template <typename S>
+void SparseMatrixT<S>::cols(Size cols) {
     ASSERT(cols > 0);
     shape_.cols_ = cols;
 }
 
-size_t SparseMatrix::footprint() const {
+template <typename S>
+size_t SparseMatrixT<S>::footprint() const {
     return sizeof(*this) + shape_.allocSize();
 }
 
-bool SparseMatrix::inSharedMemory() const {
+template <typename S>
+bool SparseMatrixT<S>::inSharedMemory() const {
     ASSERT(owner_.get());
     return owner_->inSharedMemory();
 }
 
-void SparseMatrix::dump(std::ostream& os) const {
+template <typename S>
+void SparseMatrixT<S>::dump(std::ostream& os) const {
     for (Size i = 0; i < rows(); ++i) {
 
         const_iterator itr  = begin(i);
@@ -358,11 +391,13 @@ void SparseMatrix::dump(std::ostream& os) const {
     }
 }
 
-void SparseMatrix::print(std::ostream& os) const {
+template <typename S>
+void SparseMatrixT<S>::print(std::ostream& os) const {
     os << "SparseMatrix[" << shape_ << "," << *owner_ << "]";
 }
 
-SparseMatrix& SparseMatrix::setIdentity(Size rows, Size cols) {
+template <typename S>
+SparseMatrixT<S>& SparseMatrixT<S>::setIdentity(Size rows, Size cols) {
 
     ASSERT(rows > 0 && cols > 0);
 
@@ -380,14 +415,15 @@ SparseMatrix& SparseMatrix::setIdentity(Size rows, Size cols) {
     }
 
     for (Size i = 0; i < shape_.size_; ++i) {
-        spm_.data_[i] = Scalar(1);
+        spm_.data_[i] = S(1);
     }
 
     return *this;
 }
 
 
-SparseMatrix& SparseMatrix::transpose() {
+template <typename S>
+SparseMatrixT<S>& SparseMatrixT<S>::transpose() {
 
     /// @note Can SparseMatrix::transpose() be done more efficiently?
     ///       We are building another matrix and then swapping
@@ -403,14 +439,15 @@ SparseMatrix& SparseMatrix::transpose() {
 
     std::sort(triplets.begin(), triplets.end());  // triplets must be sorted by row
 
-    SparseMatrix tmp(shape_.cols_, shape_.rows_, triplets);
+    SparseMatrixT tmp(shape_.cols_, shape_.rows_, triplets);
 
     swap(tmp);
 
     return *this;
 }
 
-SparseMatrix SparseMatrix::rowReduction(const std::vector<size_t>& p) const {
+template <typename S>
+SparseMatrixT<S> SparseMatrixT<S>::rowReduction(const std::vector<size_t>& p) const {
     ASSERT(p.size() <= rows());
 
     std::vector<Triplet> triplets;
@@ -431,13 +468,14 @@ SparseMatrix SparseMatrix::rowReduction(const std::vector<size_t>& p) const {
         }
     }
 
-    return SparseMatrix(p.size(), cols(), triplets);
+    return SparseMatrixT(p.size(), cols(), triplets);
 }
 
 
-SparseMatrix& SparseMatrix::prune(linalg::Scalar val) {
+template <typename S>
+SparseMatrixT<S>& SparseMatrixT<S>::prune(S val) {
 
-    std::vector<Scalar> v;
+    std::vector<S> v;
     std::vector<Index> inner;
 
     Size nnz = 0;
@@ -454,10 +492,10 @@ SparseMatrix& SparseMatrix::prune(linalg::Scalar val) {
     }
     spm_.outer_[shape_.rows_] = Index(nnz);
 
-    SparseMatrix tmp;
+    SparseMatrixT tmp;
     tmp.reserve(shape_.rows_, shape_.cols_, nnz);
 
-    ::memcpy(tmp.spm_.data_, v.data(), nnz * sizeof(Scalar));
+    ::memcpy(tmp.spm_.data_, v.data(), nnz * sizeof(S));
     ::memcpy(tmp.spm_.outer_, spm_.outer_, shape_.outerSize() * sizeof(Index));
     ::memcpy(tmp.spm_.inner_, inner.data(), nnz * sizeof(Index));
 
@@ -466,13 +504,15 @@ SparseMatrix& SparseMatrix::prune(linalg::Scalar val) {
     return *this;
 }
 
-const SparseMatrix::Allocator& SparseMatrix::owner() const {
+template <typename S>
+const typename SparseMatrixT<S>::Allocator& SparseMatrixT<S>::owner() const {
     ASSERT(owner_.get());
     return *(owner_.get());
 }
 
 
-void SparseMatrix::encode(Stream& s) const {
+template <typename S>
+void SparseMatrixT<S>::encode(Stream& s) const {
 
     s << shape_.rows_;
     s << shape_.cols_;
@@ -480,20 +520,21 @@ void SparseMatrix::encode(Stream& s) const {
 
     s << littleEndian;
     s << sizeof(Index);
-    s << sizeof(Scalar);
+    s << sizeof(S);
     s << sizeof(Size);
 
     Log::debug<LibEcKit>() << "Encoding matrix : "
                            << " rows " << rows() << " cols " << cols() << " nnz " << nonZeros() << " footprint "
                            << footprint() << std::endl;
 
-    s.writeLargeBlob(spm_.outer_, shape_.outerSize() * sizeof(Index));
-    s.writeLargeBlob(spm_.inner_, shape_.innerSize() * sizeof(Index));
-    s.writeLargeBlob(spm_.data_, shape_.dataSize() * sizeof(Scalar));
+    detail::encodeArray(s, spm_.outer_, shape_.outerSize(), true);
+    detail::encodeArray(s, spm_.inner_, shape_.innerSize(), true);
+    detail::encodeArray(s, spm_.data_, shape_.dataSize(), true);
 }
 
 
-void SparseMatrix::decode(Stream& s) {
+template <typename S>
+void SparseMatrixT<S>::decode(Stream& s) {
 
     Size rows;
     Size cols;
@@ -513,7 +554,7 @@ void SparseMatrix::decode(Stream& s) {
 
     size_t scalar_size;
     s >> scalar_size;
-    ASSERT(scalar_size == sizeof(Scalar));
+    ASSERT(scalar_size == sizeof(double) || scalar_size == sizeof(float));
 
     size_t size_size;
     s >> size_size;
@@ -521,7 +562,7 @@ void SparseMatrix::decode(Stream& s) {
 
     reset();
 
-    owner_.reset(new detail::StandardAllocator());
+    owner_.reset(new detail::StandardAllocator<S>());
 
     reserve(rows, cols, nnz);
 
@@ -529,48 +570,59 @@ void SparseMatrix::decode(Stream& s) {
                            << " rows " << rows << " cols " << cols << " nnz " << nnz << " footprint " << footprint()
                            << std::endl;
 
-    s.readLargeBlob(spm_.outer_, shape_.outerSize() * sizeof(Index));
-    s.readLargeBlob(spm_.inner_, shape_.innerSize() * sizeof(Index));
-    s.readLargeBlob(spm_.data_, shape_.dataSize() * sizeof(Scalar));
-}
-
+    s.readArray(spm_.outer_, shape_.outerSize());
+    s.readArray(spm_.inner_, shape_.innerSize());
 
-Stream& operator<<(Stream& s, const SparseMatrix& v) {
-    v.encode(s);
-    return s;
+    if (scalar_size == sizeof(S)) {
+        s.readArray(spm_.data_, shape_.dataSize());
+    }
+    else {
+        // entries saved with the other precision, converted on reading
+        using T = std::conditional_t<std::is_same_v<S, double>, float, double>;
+        ASSERT(scalar_size == sizeof(T));
+
+        std::vector<T> data(shape_.dataSize());
+        s.readArray(data.data(), data.size());
+        std::transform(data.begin(), data.end(), spm_.data_, [](T v) { return static_cast<S>(v); });
+    }
 }
 
 
-SparseMatrix::const_iterator SparseMatrix::const_iterator::operator++(int) {
+template <typename S>
+typename SparseMatrixT<S>::const_iterator SparseMatrixT<S>::const_iterator::operator++(int) {
     const_iterator it = *this;
     ++(*this);
     return it;
 }
 
 
-SparseMatrix::const_iterator& SparseMatrix::const_iterator::operator=(const SparseMatrix::const_iterator& other) {
+template <typename S>
+typename SparseMatrixT<S>::const_iterator& SparseMatrixT<S>::const_iterator::operator=(const const_iterator& other) {
     matrix_ = other.matrix_;
     index_  = other.index_;
     row_    = other.row_;
     return *this;
 }
 
-bool SparseMatrix::const_iterator::operator==(const SparseMatrix::const_iterator& other) const {
+template <typename S>
+bool SparseMatrixT<S>::const_iterator::operator==(const const_iterator& other) const {
     ASSERT(other.matrix_ == matrix_);
     return other.index_ == index_;
 }
 
 
-SparseMatrix::const_iterator::const_iterator(const SparseMatrix& matrix) :
-    matrix_(const_cast<SparseMatrix*>(&matrix)), index_(0), row_(0) {
+template <typename S>
+SparseMatrixT<S>::const_iterator::const_iterator(const SparseMatrixT& matrix) :
+    matrix_(const_cast<SparseMatrixT*>(&matrix)), index_(0), row_(0) {
     const Index* outer = matrix_->outer();
     while (outer[row_ + 1] == 0) {
         ++row_;
     }
 }
 
-SparseMatrix::const_iterator::const_iterator(const SparseMatrix& matrix, Size row) :
-    matrix_(const_cast<SparseMatrix*>(&matrix)), row_(row) {
+template <typename S>
+SparseMatrixT<S>::const_iterator::const_iterator(const SparseMatrixT& matrix, Size row) :
+    matrix_(const_cast<SparseMatrixT*>(&matrix)), row_(row) {
     const Size rows = matrix_->rows();
     if (row_ > rows) {
         row_ = rows;
@@ -578,17 +630,20 @@ SparseMatrix::const_iterator::const_iterator(const SparseMatrix& matrix, Size ro
     index_ = Size(matrix_->outer()[row_]);
 }
 
-Size SparseMatrix::const_iterator::col() const {
+template <typename S>
+Size SparseMatrixT<S>::const_iterator::col() const {
     assert(matrix_ && index_ < matrix_->nonZeros());
     return Size(matrix_->inner()[index_]);
 }
 
-Size SparseMatrix::const_iterator::row() const {
+template <typename S>
+Size SparseMatrixT<S>::const_iterator::row() const {
     return row_;
 }
 
 
-SparseMatrix::const_iterator& SparseMatrix::const_iterator::operator++() {
+template <typename S>
+typename SparseMatrixT<S>::const_iterator& SparseMatrixT<S>::const_iterator::operator++() {
     if (lastOfRow()) {
         row_++;
     }
@@ -597,24 +652,33 @@ SparseMatrix::const_iterator& SparseMatrix::const_iterator::operator++() {
 }
 
 
-const Scalar& SparseMatrix::const_iterator::operator*() const {
+template <typename S>
+const S& SparseMatrixT<S>::const_iterator::operator*() const {
     assert(matrix_ && index_ < matrix_->nonZeros());
     return matrix_->spm_.data_[index_];
 }
 
-void eckit::linalg::SparseMatrix::const_iterator::print(std::ostream& os) const {
+template <typename S>
+void SparseMatrixT<S>::const_iterator::print(std::ostream& os) const {
     os << "SparseMatrix::iterator(row=" << row_ << ", index=" << index_ << ")" << std::endl;
 }
 
 
-Scalar& SparseMatrix::iterator::operator*() {
-    assert(matrix_ && index_ < matrix_->nonZeros());
-    return matrix_->spm_.data_[index_];
+template <typename S>
+S& SparseMatrixT<S>::iterator::operator*() {
+    assert(this->matrix_ && this->index_ < this->matrix_->nonZeros());
+    return this->matrix_->spm_.data_[this->index_];
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-SparseMatrix::Allocator::~Allocator() {}
+template <typename S>
+SparseMatrixT<S>::Allocator::~Allocator() {}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template class SparseMatrixT<double>;
+template class SparseMatrixT<float>;
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -15,9 +15,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <iosfwd>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 #include "eckit/io/MemoryHandle.h"
@@ -36,8 +38,9 @@ namespace eckit::linalg {
 
 //----------------------------------------------------------------------------------------------------------------------
 
-/// Sparse matrix in CRS (compressed row storage) format
-class SparseMatrix {
+/// Sparse matrix in CRS (compressed row storage) format, of double (SparseMatrix) or float (SparseMatrixFloat) entries
+template <typename S>
+class SparseMatrixT {
 public:  // types
     struct Layout {
 
@@ -50,7 +53,7 @@ public:  // types
             inner_ = nullptr;
         }
 
-        Scalar* data_;  ///< matrix entries, sized with number of non-zeros (nnz)
+        S* data_;       ///< matrix entries, sized with number of non-zeros (nnz)
         Index* outer_;  ///< start of rows,  sized number of rows + 1
         Index* inner_;  ///< column indices, sized with number of non-zeros (nnz)
     };
@@ -87,7 +90,7 @@ public:  // types
 
         size_t allocSize() const { return sizeofData() + sizeofOuter() + sizeofInner(); }
 
-        size_t sizeofData() const { return dataSize() * sizeof(Scalar); }
+        size_t sizeofData() const { return dataSize() * sizeof(S); }
         size_t sizeofOuter() const { return outerSize() * sizeof(Index); }
         size_t sizeofInner() const { return innerSize() * sizeof(Index); }
 
@@ -134,55 +137,71 @@ public:  // methods
     // -- Constructors
 
     /// Default constructor, empty matrix
-    SparseMatrix(Allocator* alloc = nullptr);
+    SparseMatrixT(Allocator* alloc = nullptr);
 
     /// Constructs an identity matrix with provided dimensions
-    SparseMatrix(Size rows, Size cols, Allocator* alloc = nullptr);
+    SparseMatrixT(Size rows, Size cols, Allocator* alloc = nullptr);
 
     /// Constructor from triplets
-    SparseMatrix(Size rows, Size cols, const std::vector<Triplet>& triplets);
+    SparseMatrixT(Size rows, Size cols, const std::vector<Triplet>& triplets);
 
     /// Constructor from Stream
-    SparseMatrix(Stream& v);
+    SparseMatrixT(Stream& v);
 
     /// Constructor from MemoryBuffer
-    SparseMatrix(const MemoryBuffer&);
+    SparseMatrixT(const MemoryBuffer&);
 
     /// Move constructor
-    SparseMatrix(SparseMatrix&&);
+    SparseMatrixT(SparseMatrixT&&);
 
     /// Copy constructor
-    SparseMatrix(const SparseMatrix&);
+    SparseMatrixT(const SparseMatrixT&);
+
+    /// Conversion constructor, from a matrix of the other precision (e.g. weights computed in double, stored in float)
+    template <typename T, std::enable_if_t<!std::is_same_v<S, T>, int> = 0>
+    explicit SparseMatrixT(const SparseMatrixT<T>& other) :
+        SparseMatrixT() {
+        if (!other.empty()) {
+            reserve(other.rows(), other.cols(), other.nonZeros());
+            std::copy(other.outer(), other.outer() + shape_.outerSize(), spm_.outer_);
+            std::copy(other.inner(), other.inner() + shape_.innerSize(), spm_.inner_);
+            std::transform(other.data(), other.data() + shape_.dataSize(), spm_.data_,
+                           [](T v) { return static_cast<S>(v); });
+        }
+    }
 
-    ~SparseMatrix();
+    ~SparseMatrixT();
 
     /// Assignment operator (allocates and copies data)
-    SparseMatrix& operator=(const SparseMatrix&);
+    SparseMatrixT& operator=(const SparseMatrixT&);
 
 public:
     /// Prune entries with exactly the given value
-    SparseMatrix& prune(Scalar val = Scalar(0));
+    SparseMatrixT& prune(S val = S(0));
 
     /// Set matrix to the identity
-    SparseMatrix& setIdentity(Size rows, Size cols);
+    SparseMatrixT& setIdentity(Size rows, Size cols);
 
     /// Transpose matrix in-place
-    SparseMatrix& transpose();
+    SparseMatrixT& transpose();
 
     /// @returns a sparse matrix that is a row reduction and reorder accoring to indexes passed in vector
-    SparseMatrix rowReduction(const std::vector<size_t>& p) const;
+    SparseMatrixT rowReduction(const std::vector<size_t>& p) const;
 
     // -- I/O
 
     void save(const eckit::PathName& path) const;
+
+    /// @note converts the entries if the file was saved with the other precision
     void load(const eckit::PathName& path);
 
     void dump(eckit::MemoryBuffer& buffer) const;
     void dump(void* buffer, size_t size) const;
 
-    static void load(const void* buffer, size_t bufferSize, Layout& layout, Shape& shape);  ///< from dump()
+    /// From dump(), without copying (the buffer must have been dumped with the same precision)
+    static void load(const void* buffer, size_t bufferSize, Layout& layout, Shape& shape);
 
-    void swap(SparseMatrix& other);
+    void swap(SparseMatrixT& other);
 
     /// @returns number of rows
     Size rows() const { return shape_.rows_; }
@@ -197,7 +216,7 @@ public:
     bool empty() const { return !nonZeros(); }
 
     /// @returns read-only view of the data vector
-    const Scalar* data() const { return spm_.data_; }
+    const S* data() const { return spm_.data_; }
 
     /// @returns read-only view of the outer index vector
     const Index* outer() const { return spm_.outer_; }
@@ -224,7 +243,7 @@ public:
 
     const Allocator& owner() const;
 
-    friend std::ostream& operator<<(std::ostream& os, const SparseMatrix& m) {
+    friend std::ostream& operator<<(std::ostream& os, const SparseMatrixT& m) {
         m.print(os);
         return os;
     }
@@ -232,8 +251,8 @@ public:
 public:  // iterators
     struct const_iterator {
 
-        const_iterator(const SparseMatrix& matrix);
-        const_iterator(const SparseMatrix& matrix, Size row);
+        const_iterator(const SparseMatrixT& matrix);
+        const_iterator(const SparseMatrixT& matrix, Size row);
 
         const_iterator(const const_iterator& other) { *this = other; }
 
@@ -249,24 +268,24 @@ public:  // iterators
         bool operator!=(const const_iterator& other) const { return !operator==(other); }
         bool operator==(const const_iterator& other) const;
 
-        const Scalar& operator*() const;
+        const S& operator*() const;
 
         void print(std::ostream&) const;
 
         bool lastOfRow() const { return ((index_ + 1) == Size(matrix_->outer()[row_ + 1])); }
 
     protected:
-        SparseMatrix* matrix_;
+        SparseMatrixT* matrix_;
         Size index_;
         Size row_;
     };
 
     struct iterator : const_iterator {
-        iterator(SparseMatrix& matrix) :
+        iterator(SparseMatrixT& matrix) :
             const_iterator(matrix) {}
-        iterator(SparseMatrix& matrix, Size row) :
+        iterator(SparseMatrixT& matrix, Size row) :
             const_iterator(matrix, row) {}
-        Scalar& operator*();
+        S& operator*();
     };
 
     /// const iterators to begin/end of row
@@ -289,10 +308,12 @@ private:  // methods
     /// Resets the matrix to a deallocated state
     void reset();
 
-    /// Serialise to a Stream
+    /// Serialise to a Stream, as (large) blobs unless detail::typedArrays()
     void encode(Stream& s) const;
 
     /// Deserialise from a Stream
+    /// @note Not cross-platform: the byte order of the writer must be that of the reader (asserted), even if the arrays
+    /// were written typed
     void decode(Stream& s);
 
 private:  // members
@@ -300,15 +321,15 @@ private:  // members
 
     Shape shape_;
 
-    std::unique_ptr<SparseMatrix::Allocator> owner_;  ///< memory manager / allocator
+    std::unique_ptr<Allocator> owner_;  ///< memory manager / allocator
 
-    friend Stream& operator<<(Stream&, const SparseMatrix&);
+    friend Stream& operator<<(Stream& s, const SparseMatrixT& m) {
+        m.encode(s);
+        return s;
+    }
 };
 
 
-Stream& operator<<(Stream&, const SparseMatrix&);
-
-
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::linalg
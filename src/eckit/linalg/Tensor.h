@@ -23,6 +23,7 @@
 
 #include "eckit/exception/Exceptions.h"
 #include "eckit/io/Buffer.h"
+#include "eckit/linalg/detail/Encoding.h"
 #include "eckit/linalg/types.h"
 #include "eckit/serialisation/Stream.h"
 #include "eckit/types/Types.h"
@@ -131,7 +132,7 @@ public:  // methods
         ASSERT(array_);
 
         // data
-        s.readBlob(array_, size() * sizeof(S));
+        s.readArray(array_, size());
         strides_ = strides(layout_, shape_);
     }
 
@@ -249,14 +250,15 @@ public:  // methods
     }
 
     /// Serialise to a Stream
-    /// This serialisation is not cross-platform
+    /// This serialisation is not cross-platform, unless written as typed arrays (see detail::typedArrays), which are
+    /// swapped on reading if the byte orders differ (the layout is not converted)
     void encode(Stream& s) const {
         s << static_cast<int>(layout_);
         s << shape_.size();
         for (auto v : shape_) {
             s << v;
         }
-        s.writeBlob(array_, size() * sizeof(S));
+        detail::encodeArray(s, array_, size());
     }
 
     /// @returns flatten size (= product of shape vector)
@@ -14,93 +14,113 @@
 
 #include "eckit/exception/Exceptions.h"
 #include "eckit/io/Buffer.h"
+#include "eckit/linalg/detail/Encoding.h"
 #include "eckit/serialisation/Stream.h"
 
 namespace eckit::linalg {
 
 //----------------------------------------------------------------------------------------------------------------------
 
-Vector::Vector() :
+template <typename S>
+VectorT<S>::VectorT() :
     array_(0), length_(0), own_(false) {}
 
 
-Vector::Vector(Size length) :
-    array_(new Scalar[length]), length_(length), own_(true) {}
+template <typename S>
+VectorT<S>::VectorT(Size length) :
+    array_(new S[length]), length_(length), own_(true) {}
 
 
-Vector::Vector(const Scalar array[], Size length) :
-    array_(const_cast<Scalar*>(array)), length_(length), own_(false) {
+template <typename S>
+VectorT<S>::VectorT(const S array[], Size length) :
+    array_(const_cast<S*>(array)), length_(length), own_(false) {
     ASSERT(array_ && length_ > 0);
 }
 
 
-Vector::Vector(Stream& stream) :
+template <typename S>
+VectorT<S>::VectorT(Stream& stream) :
     array_(0), length_(0), own_(false) {
     Size length;
     stream >> length;
     resize(length);
 
     ASSERT(length_ > 0);
-    stream.readBlob(array_, length * sizeof(Scalar));
+    stream.readArray(array_, length);
 }
 
 
-Vector::Vector(const Vector& other) :
-    array_(new Scalar[other.length_]), length_(other.length_), own_(true) {
-    ::memcpy(array_, other.array_, length_ * sizeof(Scalar));
+template <typename S>
+VectorT<S>::VectorT(const VectorT& other) :
+    array_(new S[other.length_]), length_(other.length_), own_(true) {
+    ::memcpy(array_, other.array_, length_ * sizeof(S));
 }
 
 
-Vector::~Vector() {
+template <typename S>
+VectorT<S>::~VectorT() {
     if (own_) {
         delete[] array_;
     }
 }
 
 
-Vector& Vector::operator=(const Vector& other) {
-    Vector copy(other);
+template <typename S>
+VectorT<S>& VectorT<S>::operator=(const VectorT& other) {
+    VectorT copy(other);
     swap(copy);
     return *this;
 }
 
 
-void Vector::swap(Vector& other) {
+template <typename S>
+void VectorT<S>::swap(VectorT& other) {
     std::swap(array_, other.array_);
     std::swap(length_, other.length_);
     std::swap(own_, other.own_);
 }
 
 
-void Vector::resize(Size length) {
-    Vector v(length);
+template <typename S>
+void VectorT<S>::resize(Size length) {
+    VectorT v(length);
     swap(v);
 }
 
 
-void Vector::setZero() {
-    ::memset(array_, 0, length_ * sizeof(Scalar));
+template <typename S>
+void VectorT<S>::setZero() {
+    ::memset(array_, 0, length_ * sizeof(S));
 }
 
 
-void Vector::fill(Scalar value) {
+template <typename S>
+void VectorT<S>::fill(S value) {
     for (Size i = 0; i < length_; ++i) {
         array_[i] = value;
     }
 }
 
 
-void Vector::encode(Stream& stream) const {
+template <typename S>
+void VectorT<S>::encode(Stream& stream) const {
     stream << length_;
-    stream.writeBlob(array_, length_ * sizeof(Scalar));
+    detail::encodeArray(stream, array_, length_);
 }
 
 
-Stream& operator<<(Stream& stream, const Vector& vector) {
+template <typename S>
+Stream& operator<<(Stream& stream, const VectorT<S>& vector) {
     vector.encode(stream);
     return stream;
 }
 
+template class VectorT<double>;
+template class VectorT<float>;
+
+template Stream& operator<<(Stream&, const VectorT<double>&);
+template Stream& operator<<(Stream&, const VectorT<float>&);
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::linalg
@@ -26,36 +26,37 @@ namespace eckit::linalg {
 
 //----------------------------------------------------------------------------------------------------------------------
 
-/// Vector for Linear Algebra operations
+/// Vector for Linear Algebra operations, of double (Vector) or float (VectorFloat) entries
 /// @todo provide a const view
-class Vector {
+template <typename S>
+class VectorT {
 
 public:  // methods
     // -- Constructors
 
     /// Default constructor (empty vector)
-    Vector();
+    VectorT();
 
     /// Construct vector of given size (allocates memory, not initialised)
-    Vector(Size length);
+    VectorT(Size length);
 
     /// Construct vector from existing data (does NOT take ownership)
-    Vector(const Scalar array[], Size length);
+    VectorT(const S array[], Size length);
 
     /// Constructor from Stream
-    Vector(Stream&);
+    VectorT(Stream&);
 
     /// Copy constructor
-    Vector(const Vector&);
+    VectorT(const VectorT&);
 
-    ~Vector();
+    ~VectorT();
 
     // -- Mutators
 
-    Vector& operator=(const Vector&);
+    VectorT& operator=(const VectorT&);
 
     /// Swap this vector for another
-    void swap(Vector&);
+    void swap(VectorT&);
 
     /// Resize vector to given size (invalidates data)
     void resize(Size length);
@@ -64,7 +65,7 @@ public:  // methods
     void setZero();
 
     /// Fill vector with given scalar
-    void fill(Scalar);
+    void fill(S);
 
     // -- Serialisation
 
@@ -82,34 +83,35 @@ public:  // methods
     /// @returns number of columns (always 1)
     Size cols() const { return 1; }
 
-    Scalar& operator[](Size i) { return array_[i]; }
-    const Scalar& operator[](Size i) const { return array_[i]; }
+    S& operator[](Size i) { return array_[i]; }
+    const S& operator[](Size i) const { return array_[i]; }
 
     /// @returns modifiable view of the data
-    Scalar* data() { return array_; }
+    S* data() { return array_; }
     /// @returns read-only view of the data
-    const Scalar* data() const { return array_; }
+    const S* data() const { return array_; }
 
     /// @returns iterator to beginning of the data
-    Scalar* begin() { return array_; }
+    S* begin() { return array_; }
 
     /// @returns const iterator to beginning of the data
-    const Scalar* begin() const { return array_; }
+    const S* begin() const { return array_; }
 
     /// @returns iterator to end of the data
-    Scalar* end() { return array_ + length_; }
+    S* end() { return array_ + length_; }
 
     /// @returns const iterator to end of the data
-    const Scalar* end() const { return array_ + length_; }
+    const S* end() const { return array_ + length_; }
 
-protected:           // member variables
-    Scalar* array_;  ///< Container
-    Size length_;    ///< Vector length/size
-    bool own_;       ///< do we own the memory allocated in the container ?
+protected:         // member variables
+    S* array_;     ///< Container
+    Size length_;  ///< Vector length/size
+    bool own_;     ///< do we own the memory allocated in the container ?
 };
 
 
-Stream& operator<<(Stream&, const Vector&);
+template <typename S>
+Stream& operator<<(Stream&, const VectorT<S>&);
 
 
 //----------------------------------------------------------------------------------------------------------------------
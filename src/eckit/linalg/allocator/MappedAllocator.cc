@@ -0,0 +1,209 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#include "eckit/linalg/allocator/MappedAllocator.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+#include "eckit/config/LibEcKit.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/io/AutoCloser.h"
+#include "eckit/io/FileHandle.h"
+#include "eckit/log/Bytes.h"
+#include "eckit/log/Log.h"
+#include "eckit/memory/MMap.h"
+#include "eckit/os/Stat.h"
+
+namespace eckit::linalg::allocator {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+constexpr char magic[8]              = {'E', 'C', 'K', 'I', 'T', 'S', 'P', 'M'};
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+
+std::uint64_t align(std::uint64_t offset, std::uint64_t alignment) {
+    return ((offset + alignment - 1) / alignment) * alignment;
+}
+
+
+void write(DataHandle& dh, const void* buffer, std::uint64_t length) {
+    ASSERT(dh.write(buffer, static_cast<long>(length)) == static_cast<long>(length));
+}
+
+}  // namespace
+
+
+template <typename S>
+void MappedAllocatorT<S>::save(const SparseMatrixT<S>& A, const PathName& path) {
+    ASSERT(!A.empty());
+
+    Header header;
+    ::memset(&header, 0, sizeof(Header));
+
+    ::memcpy(header.magic_, magic, sizeof(magic));
+    header.version_      = version;
+    header.order_        = byteOrderMark;
+    header.sizeofIndex_  = sizeof(Index);
+    header.sizeofScalar_ = sizeof(S);
+
+    header.rows_     = A.rows();
+    header.cols_     = A.cols();
+    header.nonZeros_ = A.nonZeros();
+
+    header.outer_ = align(sizeof(Header), alignment);
+    header.inner_ = align(header.outer_ + (header.rows_ + 1) * sizeof(Index), alignment);
+    header.data_  = align(header.inner_ + header.nonZeros_ * sizeof(Index), alignment);
+    header.size_  = header.data_ + header.nonZeros_ * sizeof(S);
+
+    Log::debug<LibEcKit>() << "MappedAllocator: saving " << path << ": rows " << header.rows_ << " cols "
+                           << header.cols_ << " nnz " << header.nonZeros_ << " size " << Bytes(header.size_)
+                           << std::endl;
+
+    const std::vector<char> padding(alignment, 0);
+
+    PathName tmp = PathName::unique(path);
+    {
+        FileHandle dh(tmp);
+        dh.openForWrite(header.size_);
+        auto c = closer(dh);
+
+        write(dh, &header, sizeof(Header));
+        write(dh, padding.data(), header.outer_ - sizeof(Header));
+
+        const std::uint64_t sizeofOuter = (header.rows_ + 1) * sizeof(Index);
+        write(dh, A.outer(), sizeofOuter);
+        write(dh, padding.data(), header.inner_ - header.outer_ - sizeofOuter);
+
+        const std::uint64_t sizeofInner = header.nonZeros_ * sizeof(Index);
+        write(dh, A.inner(), sizeofInner);
+        write(dh, padding.data(), header.data_ - header.inner_ - sizeofInner);
+
+        write(dh, A.data(), header.nonZeros_ * sizeof(S));
+    }
+
+    PathName::rename(tmp, path);
+}
+
+
+template <typename S>
+MappedAllocatorT<S>::MappedAllocatorT(const PathName& path, bool hugePages) :
+    path_(path), addr_(nullptr), size_(0) {
+
+    int fd;
+    SYSCALL2(fd = ::open(path_.localPath(), O_RDONLY), path_);
+
+    Stat::Struct s;
+    if (Stat::fstat(fd, &s) != 0 || static_cast<size_t>(s.st_size) < sizeof(Header)) {
+        ::close(fd);
+        throw ReadError("MappedAllocator: cannot map " + path_.asString() + ", not a sparse matrix file");
+    }
+
+    size_ = static_cast<size_t>(s.st_size);
+    addr_ = MMap::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+
+    // n.b. the mapping outlives the file descriptor
+    ::close(fd);
+
+    if (addr_ == MAP_FAILED) {
+        addr_ = nullptr;
+        Log::error() << "mmap(" << path_ << ')' << Log::syserr << std::endl;
+        throw FailedSystemCall("mmap");
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (hugePages && ::madvise(addr_, size_, MADV_HUGEPAGE) != 0) {
+        Log::warning() << "MappedAllocator: madvise(MADV_HUGEPAGE) on " << path_ << Log::syserr << std::endl;
+    }
+#else
+    if (hugePages) {
+        Log::warning() << "MappedAllocator: huge pages not supported on this platform" << std::endl;
+    }
+#endif
+
+    ::memcpy(&header_, addr_, sizeof(Header));
+
+    auto check = [this](bool ok, const std::string& what) {
+        if (!ok) {
+            MMap::munmap(addr_, size_);
+            addr_ = nullptr;
+            throw BadValue("MappedAllocator: cannot map " + path_.asString() + ", " + what);
+        }
+    };
+
+    check(::memcmp(header_.magic_, magic, sizeof(magic)) == 0, "not a sparse matrix file");
+    check(header_.version_ == version, "unsupported version " + std::to_string(header_.version_));
+    check(header_.order_ == byteOrderMark, "written with a different byte order");
+    check(header_.sizeofIndex_ == sizeof(Index), "written with a different index size");
+    check(header_.sizeofScalar_ == sizeof(S), "written with a different precision");
+    check(header_.size_ == size_, "truncated file");
+    check(header_.outer_ >= sizeof(Header) && header_.outer_ % alignment == 0
+              && header_.inner_ >= header_.outer_ + (header_.rows_ + 1) * sizeof(Index)
+              && header_.inner_ % alignment == 0
+              && header_.data_ >= header_.inner_ + header_.nonZeros_ * sizeof(Index)
+              && header_.data_ % alignment == 0 && header_.data_ + header_.nonZeros_ * sizeof(S) <= size_,
+          "inconsistent offsets");
+
+    Log::debug<LibEcKit>() << "MappedAllocator: mapped " << path_ << ": rows " << header_.rows_ << " cols "
+                           << header_.cols_ << " nnz " << header_.nonZeros_ << " size " << Bytes(size_)
+                           << std::endl;
+}
+
+
+template <typename S>
+MappedAllocatorT<S>::~MappedAllocatorT() {
+    if (addr_ != nullptr) {
+        MMap::munmap(addr_, size_);
+    }
+}
+
+
+template <typename S>
+typename MappedAllocatorT<S>::Layout MappedAllocatorT<S>::allocate(Shape& shape) {
+    shape.size_ = header_.nonZeros_;
+    shape.rows_ = header_.rows_;
+    shape.cols_ = header_.cols_;
+
+    auto* addr = static_cast<char*>(addr_);
+
+    Layout layout;
+    layout.outer_ = reinterpret_cast<Index*>(addr + header_.outer_);
+    layout.inner_ = reinterpret_cast<Index*>(addr + header_.inner_);
+    layout.data_  = reinterpret_cast<S*>(addr + header_.data_);
+    return layout;
+}
+
+
+template <typename S>
+void MappedAllocatorT<S>::deallocate(Layout, Shape) {}
+
+
+template <typename S>
+void MappedAllocatorT<S>::print(std::ostream& out) const {
+    out << "MappedAllocator[path=" << path_ << ",size=" << Bytes(size_) << "]";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template class MappedAllocatorT<double>;
+template class MappedAllocatorT<float>;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::linalg::allocator
@@ -0,0 +1,89 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+
+#include "eckit/filesystem/PathName.h"
+#include "eckit/linalg/SparseMatrix.h"
+
+namespace eckit::linalg::allocator {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Sparse matrix memory mapped read-only from a file, written by save().
+///
+/// The mapping is shared (through the page cache) by all the processes mapping the same file, and loading costs
+/// the same whatever the size of the matrix: the pages are read on first access. The matrix entries must not be
+/// modified (e.g. through SparseMatrix::iterator), as the memory is read-only.
+///
+/// File format (version 1), in the byte order of the machine that wrote it:
+///   - Header, see below
+///   - outer indices, inner indices and entries, each starting at a multiple of MappedAllocatorT::alignment
+template <typename S>
+class MappedAllocatorT : public SparseMatrixT<S>::Allocator {
+public:  // types
+    using Layout = typename SparseMatrixT<S>::Layout;
+    using Shape  = typename SparseMatrixT<S>::Shape;
+
+    struct Header {
+        char magic_[8];          ///< "ECKITSPM"
+        std::uint32_t version_;  ///< format version
+        std::uint32_t order_;    ///< byte order mark, reads 0x01020304 on a machine of the same byte order
+        std::uint32_t sizeofIndex_;
+        std::uint32_t sizeofScalar_;
+        std::uint64_t rows_;
+        std::uint64_t cols_;
+        std::uint64_t nonZeros_;
+        std::uint64_t outer_;  ///< offset of the outer indices
+        std::uint64_t inner_;  ///< offset of the inner indices
+        std::uint64_t data_;   ///< offset of the entries
+        std::uint64_t size_;   ///< file size
+    };
+
+public:  // class methods
+    static constexpr std::uint32_t version = 1;
+
+    /// Alignment of the arrays in the file (a page)
+    static constexpr std::uint64_t alignment = 4096;
+
+    /// Write a matrix in the format of this allocator
+    /// @note the file is written under a temporary name and renamed, so that concurrent readers never see it partially
+    static void save(const SparseMatrixT<S>&, const PathName&);
+
+public:  // methods
+    /// @param hugePages advise the kernel to back the mapping with (transparent) huge pages, where supported
+    explicit MappedAllocatorT(const PathName&, bool hugePages = false);
+
+    ~MappedAllocatorT() override;
+
+    Layout allocate(Shape&) override;
+
+    void deallocate(Layout, Shape) override;
+
+    bool inSharedMemory() const override { return true; }
+
+    void print(std::ostream&) const override;
+
+private:  // members
+    PathName path_;
+    void* addr_;
+    size_t size_;
+    Header header_;
+};
+
+using MappedAllocator      = MappedAllocatorT<Scalar>;
+using MappedAllocatorFloat = MappedAllocatorT<float>;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::linalg::allocator
@@ -0,0 +1,27 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#include "eckit/linalg/detail/Encoding.h"
+
+#include "eckit/config/Resource.h"
+
+namespace eckit::linalg::detail {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool typedArrays() {
+    static const bool typed = Resource<bool>("linalgTypedArrays;$ECKIT_LINALG_TYPED_ARRAYS", false);
+    return typed;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::linalg::detail
@@ -0,0 +1,42 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+
+#include "eckit/serialisation/Stream.h"
+
+namespace eckit::linalg::detail {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Whether vectors, matrices and tensors encode their arrays as typed arrays (see Stream::writeArray), which eckit
+/// versions that predate them cannot read. Off by default, see resource linalgTypedArrays ($ECKIT_LINALG_TYPED_ARRAYS)
+bool typedArrays();
+
+/// Encode an array of n elements, as a blob (or a large blob), unless typedArrays(). Stream::readArray reads either
+template <typename T>
+void encodeArray(Stream& s, const T* array, size_t n, bool large = false) {
+    if (typedArrays()) {
+        s.writeArray(array, n);
+    }
+    else if (large) {
+        s.writeLargeBlob(array, n * sizeof(T));
+    }
+    else {
+        s.writeBlob(array, n * sizeof(T));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::linalg::detail
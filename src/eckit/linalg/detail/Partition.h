@@ -0,0 +1,53 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#pragma once
+
+#include "eckit/linalg/types.h"
+
+namespace eckit::linalg::detail {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Splits n items (e.g. the rows of a CSR matrix) into parts of about the same cost, for load balancing.
+/// The cost of the items before item i is offsets[i] - offsets[0] (e.g. the outer indices), plus one per item.
+/// @returns the first item of the given part, part <= parts (for part == parts, returns n)
+template <typename T>
+Size partitionBegin(const T* offsets, Size n, Size part, Size parts) {
+    if (part == 0) {
+        return 0;
+    }
+    if (part >= parts) {
+        return n;
+    }
+
+    auto cost = [&](Size i) { return static_cast<Size>(offsets[i] - offsets[0]) + i; };
+
+    const double target = static_cast<double>(cost(n)) * static_cast<double>(part) / static_cast<double>(parts);
+
+    // first item whose cost reaches the target
+    Size lo = 0;
+    Size hi = n;
+    while (lo < hi) {
+        Size mid = lo + (hi - lo) / 2;
+        if (static_cast<double>(cost(mid)) < target) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::linalg::detail
@@ -0,0 +1,245 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#include "eckit/linalg/detail/SIMD.h"
+
+#include <string>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ECKIT_LINALG_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define ECKIT_LINALG_SIMD_X86 0
+#endif
+
+#include "eckit/config/Resource.h"
+
+namespace eckit::linalg::detail {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+using Csr       = void (*)(const Index*, const Index*, const Scalar*, const Scalar*, Scalar*, Size, Size);
+using SellChunk = void (*)(const Scalar*, const Index*, const Index*, Size, const Scalar*, Scalar*);
+
+constexpr Size C = SIMD::chunk;
+
+
+inline Scalar sparseDotScalar(const Scalar* val, const Index* idx, const Scalar* x, Size n) {
+    Scalar sum = 0.;
+    for (Size k = 0; k < n; ++k) {
+        sum += val[k] * x[static_cast<Size>(idx[k])];
+    }
+    return sum;
+}
+
+
+void csrScalar(const Index* outer, const Index* inner, const Scalar* val, const Scalar* x, Scalar* y, Size begin,
+               Size end) {
+    for (Size i = begin; i < end; ++i) {
+        y[i] = sparseDotScalar(val + outer[i], inner + outer[i], x, static_cast<Size>(outer[i + 1] - outer[i]));
+    }
+}
+
+
+void sellChunkScalar(const Scalar* val, const Index* idx, const Index* len, Size, const Scalar* x, Scalar* out) {
+    for (Size r = 0; r < C; ++r) {
+        Scalar sum = 0.;
+        for (Size k = 0; k < static_cast<Size>(len[r]); ++k) {
+            sum += val[k * C + r] * x[static_cast<Size>(idx[k * C + r])];
+        }
+        out[r] = sum;
+    }
+}
+
+
+#if ECKIT_LINALG_SIMD_X86
+
+__attribute__((target("avx2,fma"), always_inline)) inline Scalar sparseDotAVX2(const Scalar* val, const Index* idx,
+                                                                               const Scalar* x, Size n) {
+    // Gathering is not worth it for short rows
+    if (n < 8) {
+        return sparseDotScalar(val, idx, x, n);
+    }
+
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+
+    Size k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m256d x0 = _mm256_i32gather_pd(x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx + k)), 8);
+        __m256d x1 = _mm256_i32gather_pd(x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx + k + 4)), 8);
+        acc0       = _mm256_fmadd_pd(_mm256_loadu_pd(val + k), x0, acc0);
+        acc1       = _mm256_fmadd_pd(_mm256_loadu_pd(val + k + 4), x1, acc1);
+    }
+    for (; k + 4 <= n; k += 4) {
+        __m256d x0 = _mm256_i32gather_pd(x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx + k)), 8);
+        acc0       = _mm256_fmadd_pd(_mm256_loadu_pd(val + k), x0, acc0);
+    }
+
+    __m256d acc = _mm256_add_pd(acc0, acc1);
+    __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    sum         = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+
+    Scalar result = _mm_cvtsd_f64(sum);
+    for (; k < n; ++k) {
+        result += val[k] * x[static_cast<Size>(idx[k])];
+    }
+    return result;
+}
+
+
+__attribute__((target("avx2,fma"))) void csrAVX2(const Index* outer, const Index* inner, const Scalar* val,
+                                                   const Scalar* x, Scalar* y, Size begin, Size end) {
+    for (Size i = begin; i < end; ++i) {
+        y[i] = sparseDotAVX2(val + outer[i], inner + outer[i], x, static_cast<Size>(outer[i + 1] - outer[i]));
+    }
+}
+
+
+__attribute__((target("avx2,fma"))) void sellChunkAVX2(const Scalar* val, const Index* idx, const Index* len,
+                                                         Size width, const Scalar* x, Scalar* out) {
+    static_assert(C == 8, "SELL chunk of 8 rows expected");
+
+    // Rows shorter than the chunk width are masked out, so the padding is never read from x
+    const __m128i len0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(len));
+    const __m128i len1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(len + 4));
+
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+
+    for (Size k = 0; k < width; ++k) {
+        const __m128i kk = _mm_set1_epi32(static_cast<int>(k));
+        __m256d mask0    = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpgt_epi32(len0, kk)));
+        __m256d mask1    = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpgt_epi32(len1, kk)));
+
+        const Index* i = idx + k * C;
+        const Scalar* v = val + k * C;
+
+        __m256d x0 = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x,
+                                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(i)), mask0, 8);
+        __m256d x1 = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x,
+                                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(i + 4)), mask1, 8);
+        acc0       = _mm256_fmadd_pd(_mm256_loadu_pd(v), x0, acc0);
+        acc1       = _mm256_fmadd_pd(_mm256_loadu_pd(v + 4), x1, acc1);
+    }
+
+    _mm256_storeu_pd(out, acc0);
+    _mm256_storeu_pd(out + 4, acc1);
+}
+
+
+__attribute__((target("avx512f"), always_inline)) inline Scalar sparseDotAVX512(const Scalar* val, const Index* idx,
+                                                                                const Scalar* x, Size n) {
+    __m512d acc = _mm512_setzero_pd();
+
+    Size k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m512d xk = _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + k)), x, 8);
+        acc        = _mm512_fmadd_pd(_mm512_loadu_pd(val + k), xk, acc);
+    }
+    if (k < n) {
+        // n.b. masked loads, so that neither idx nor val are read past the end
+        const __mmask8 tail = static_cast<__mmask8>((1U << (n - k)) - 1);
+        __m256i ik = _mm512_castsi512_si256(_mm512_maskz_loadu_epi32(static_cast<__mmask16>(tail), idx + k));
+        __m512d xk = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), tail, ik, x, 8);
+        acc        = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, val + k), xk, acc);
+    }
+
+    return _mm512_reduce_add_pd(acc);
+}
+
+
+__attribute__((target("avx512f"))) void csrAVX512(const Index* outer, const Index* inner, const Scalar* val,
+                                                    const Scalar* x, Scalar* y, Size begin, Size end) {
+    for (Size i = begin; i < end; ++i) {
+        y[i] = sparseDotAVX512(val + outer[i], inner + outer[i], x, static_cast<Size>(outer[i + 1] - outer[i]));
+    }
+}
+
+
+__attribute__((target("avx512f"))) void sellChunkAVX512(const Scalar* val, const Index* idx, const Index* len,
+                                                          Size width, const Scalar* x, Scalar* out) {
+    static_assert(C == 8, "SELL chunk of 8 rows expected");
+
+    const __m512i len64 = _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(len)));
+
+    __m512d acc = _mm512_setzero_pd();
+    for (Size k = 0; k < width; ++k) {
+        const __mmask8 mask = _mm512_cmpgt_epi64_mask(len64, _mm512_set1_epi64(static_cast<long long>(k)));
+        __m256i ik          = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + k * C));
+        __m512d xk          = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, ik, x, 8);
+        acc                 = _mm512_fmadd_pd(_mm512_loadu_pd(val + k * C), xk, acc);
+    }
+
+    _mm512_storeu_pd(out, acc);
+}
+
+#endif
+
+
+struct Kernels {
+    Kernels() :
+        csr(csrScalar), sellChunk(sellChunkScalar), name("none") {
+
+        const std::string cap = Resource<std::string>("linalgSIMD;$ECKIT_LINALG_SIMD", "avx512");
+
+#if ECKIT_LINALG_SIMD_X86
+        __builtin_cpu_init();
+        if (cap == "avx512" && __builtin_cpu_supports("avx512f")) {
+            csr       = csrAVX512;
+            sellChunk = sellChunkAVX512;
+            name      = "avx512";
+        }
+        else if ((cap == "avx512" || cap == "avx2") && __builtin_cpu_supports("avx2")
+                 && __builtin_cpu_supports("fma")) {
+            csr       = csrAVX2;
+            sellChunk = sellChunkAVX2;
+            name      = "avx2";
+        }
+#endif
+    }
+
+    Csr csr;
+    SellChunk sellChunk;
+    const char* name;
+};
+
+
+// n.b. on first use, so that the resource is read once the configuration is set up
+const Kernels& kernels() {
+    static const Kernels kernels;
+    return kernels;
+}
+
+}  // namespace
+
+
+void SIMD::csr(const Index* outer, const Index* inner, const Scalar* val, const Scalar* x, Scalar* y, Size begin,
+               Size end) {
+    kernels().csr(outer, inner, val, x, y, begin, end);
+}
+
+
+void SIMD::sellChunk(const Scalar* val, const Index* idx, const Index* len, Size width, const Scalar* x,
+                     Scalar* out) {
+    kernels().sellChunk(val, idx, len, width, x, out);
+}
+
+
+const char* SIMD::name() {
+    return kernels().name;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::linalg::detail
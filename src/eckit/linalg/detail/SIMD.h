@@ -0,0 +1,43 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#pragma once
+
+#include "eckit/linalg/types.h"
+
+namespace eckit::linalg::detail {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Sparse kernels, vectorised with the widest instruction set supported by the CPU (AVX-512, AVX2) and selected
+/// at run time. The resource linalgSIMD ($ECKIT_LINALG_SIMD: none, avx2, avx512) caps the instruction set used.
+
+struct SIMD {
+
+    /// Number of rows of a SELL chunk, see sellChunk()
+    static constexpr Size chunk = 8;
+
+    /// Products of the rows begin to end - 1 of a CSR matrix (outer, inner, val) with x, into y
+    static void csr(const Index* outer, const Index* inner, const Scalar* val, const Scalar* x, Scalar* y, Size begin,
+                    Size end);
+
+    /// Products of a chunk of rows of a SELL matrix, stored column by column: entry k of row r is at
+    /// val[k * chunk + r] and idx[k * chunk + r], for k < len[r] <= width. Sets out[r], for r < chunk.
+    static void sellChunk(const Scalar* val, const Index* idx, const Index* len, Size width, const Scalar* x,
+                          Scalar* out);
+
+    /// @returns name of the instruction set used by the kernels
+    static const char* name();
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::linalg::detail
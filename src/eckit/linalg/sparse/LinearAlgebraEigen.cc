@@ -28,6 +28,20 @@ using vec_t = Eigen::VectorXd::MapType;
 using mat_t = Eigen::MatrixXd::MapType;
 using spm_t = Eigen::MappedSparseMatrix<Scalar, Eigen::RowMajor, Index>;
 
+using vecf_t = Eigen::VectorXf::MapType;
+using matf_t = Eigen::MatrixXf::MapType;
+using spmf_t = Eigen::MappedSparseMatrix<float, Eigen::RowMajor, Index>;
+
+
+static spmf_t map(const SparseMatrixFloat& A) {
+    // We expect indices to be 0-based
+    ASSERT(A.outer()[0] == 0);
+
+    // Eigen requires non-const pointers to the data
+    return {static_cast<Index>(A.rows()), static_cast<Index>(A.cols()), static_cast<Index>(A.nonZeros()),
+            const_cast<Index*>(A.outer()), const_cast<Index*>(A.inner()), const_cast<float*>(A.data())};
+}
+
 
 void LinearAlgebraEigen::print(std::ostream& out) const {
     out << "LinearAlgebraEigen[]";
@@ -67,6 +81,58 @@ void LinearAlgebraEigen::spmm(const SparseMatrix& A, const Matrix& B, Matrix& C)
 }
 
 
+void LinearAlgebraEigen::spmv(const SparseMatrixFloat& A, const VectorFloat& x, VectorFloat& y) const {
+    ASSERT(x.size() == A.cols());
+    ASSERT(y.size() == A.rows());
+
+    auto Ai = map(A);
+    vecf_t xi(Eigen::VectorXf::Map(const_cast<float*>(x.data()), x.size()));
+    vecf_t yi(Eigen::VectorXf::Map(y.data(), y.size()));
+
+    yi = Ai * xi;
+}
+
+
+void LinearAlgebraEigen::spmv(const SparseMatrixFloat& A, const Vector& x, Vector& y) const {
+    ASSERT(x.size() == A.cols());
+    ASSERT(y.size() == A.rows());
+
+    // n.b. the entries are converted on the fly, accumulating in double
+    auto Ai = map(A);
+    vec_t xi(Eigen::VectorXd::Map(const_cast<Scalar*>(x.data()), x.size()));
+    vec_t yi(Eigen::VectorXd::Map(y.data(), y.size()));
+
+    yi = Ai.cast<Scalar>() * xi;
+}
+
+
+void LinearAlgebraEigen::spmm(const SparseMatrixFloat& A, const MatrixFloat& B, MatrixFloat& C) const {
+    ASSERT(A.cols() == B.rows());
+    ASSERT(A.rows() == C.rows());
+    ASSERT(B.cols() == C.cols());
+
+    auto Ai = map(A);
+    matf_t Bi(Eigen::MatrixXf::Map(const_cast<float*>(B.data()), B.rows(), B.cols()));
+    matf_t Ci(Eigen::MatrixXf::Map(C.data(), C.rows(), C.cols()));
+
+    Ci = Ai * Bi;
+}
+
+
+void LinearAlgebraEigen::spmm(const SparseMatrixFloat& A, const Matrix& B, Matrix& C) const {
+    ASSERT(A.cols() == B.rows());
+    ASSERT(A.rows() == C.rows());
+    ASSERT(B.cols() == C.cols());
+
+    // n.b. the entries are converted on the fly, accumulating in double
+    auto Ai = map(A);
+    mat_t Bi(Eigen::MatrixXd::Map(const_cast<Scalar*>(B.data()), B.rows(), B.cols()));
+    mat_t Ci(Eigen::MatrixXd::Map(C.data(), C.rows(), C.cols()));
+
+    Ci = Ai.cast<Scalar>() * Bi;
+}
+
+
 void LinearAlgebraEigen::dsptd(const Vector& x, const SparseMatrix& A, const Vector& y, SparseMatrix& B) const {
     static const sparse::LinearAlgebraGeneric generic;
     generic.dsptd(x, A, y, B);
@@ -12,6 +12,7 @@
 #include "eckit/linalg/sparse/LinearAlgebraGeneric.h"
 
 #include <ostream>
+#include <type_traits>
 #include <vector>
 
 #include "eckit/eckit.h"
@@ -33,7 +34,14 @@ void LinearAlgebraGeneric::print(std::ostream& out) const {
 }
 
 
-void LinearAlgebraGeneric::spmv(const SparseMatrix& A, const Vector& x, Vector& y) const {
+namespace {
+
+
+// n.b. accumulates in the precision of the output
+template <typename A_t, typename X_t, typename Y_t>
+void spmv(const A_t& A, const X_t& x, Y_t& y) {
+    using T = std::remove_reference_t<decltype(y[0])>;
+
     const auto Ni = A.rows();
     const auto Nj = A.cols();
 
@@ -54,10 +62,10 @@ void LinearAlgebraGeneric::spmv(const SparseMatrix& A, const Vector& x, Vector&
 #pragma omp parallel for
 #endif
     for (Size i = 0; i < Ni; ++i) {
-        Scalar sum = 0.;
+        T sum = 0.;
 
         for (auto c = outer[i]; c < outer[i + 1]; ++c) {
-            sum += val[c] * x[static_cast<Size>(inner[c])];
+            sum += static_cast<T>(val[c]) * static_cast<T>(x[static_cast<Size>(inner[c])]);
         }
 
         y[i] = sum;
@@ -65,7 +73,10 @@ void LinearAlgebraGeneric::spmv(const SparseMatrix& A, const Vector& x, Vector&
 }
 
 
-void LinearAlgebraGeneric::spmm(const SparseMatrix& A, const Matrix& B, Matrix& C) const {
+template <typename A_t, typename B_t, typename C_t>
+void spmm(const A_t& A, const B_t& B, C_t& C) {
+    using T = std::remove_reference_t<decltype(C[0])>;
+
     const auto Ni = A.rows();
     const auto Nj = A.cols();
     const auto Nk = B.cols();
@@ -84,13 +95,11 @@ void LinearAlgebraGeneric::spmm(const SparseMatrix& A, const Matrix& B, Matrix&
 
     ASSERT(outer[0] == 0);  // expect indices to be 0-based
 
-    std::vector<Scalar> sum;
-
 #if eckit_HAVE_OMP
 #pragma omp parallel
 #endif
     {
-        std::vector<Scalar> sum(Nk);
+        std::vector<T> sum(Nk);
 
 #if eckit_HAVE_OMP
 #pragma omp for
@@ -100,9 +109,9 @@ void LinearAlgebraGeneric::spmm(const SparseMatrix& A, const Matrix& B, Matrix&
 
             for (auto c = outer[i]; c < outer[i + 1]; ++c) {
                 const auto j = static_cast<Size>(inner[c]);
-                const auto v = val[c];
+                const auto v = static_cast<T>(val[c]);
                 for (Size k = 0; k < Nk; ++k) {
-                    sum[k] += v * B(j, k);
+                    sum[k] += v * static_cast<T>(B(j, k));
                 }
             }
 
@@ -114,6 +123,39 @@ void LinearAlgebraGeneric::spmm(const SparseMatrix& A, const Matrix& B, Matrix&
 }
 
 
+}  // namespace
+
+
+void LinearAlgebraGeneric::spmv(const SparseMatrix& A, const Vector& x, Vector& y) const {
+    sparse::spmv(A, x, y);
+}
+
+
+void LinearAlgebraGeneric::spmm(const SparseMatrix& A, const Matrix& B, Matrix& C) const {
+    sparse::spmm(A, B, C);
+}
+
+
+void LinearAlgebraGeneric::spmv(const SparseMatrixFloat& A, const VectorFloat& x, VectorFloat& y) const {
+    sparse::spmv(A, x, y);
+}
+
+
+void LinearAlgebraGeneric::spmv(const SparseMatrixFloat& A, const Vector& x, Vector& y) const {
+    sparse::spmv(A, x, y);
+}
+
+
+void LinearAlgebraGeneric::spmm(const SparseMatrixFloat& A, const MatrixFloat& B, MatrixFloat& C) const {
+    sparse::spmm(A, B, C);
+}
+
+
+void LinearAlgebraGeneric::spmm(const SparseMatrixFloat& A, const Matrix& B, Matrix& C) const {
+    sparse::spmm(A, B, C);
+}
+
+
 void LinearAlgebraGeneric::dsptd(const Vector& x, const SparseMatrix& A, const Vector& y, SparseMatrix& B) const {
     const auto Ni = A.rows();
     const auto Nj = A.cols();
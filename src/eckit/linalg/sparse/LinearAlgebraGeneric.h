@@ -23,6 +23,10 @@ struct LinearAlgebraGeneric final : public LinearAlgebraSparse {
     void spmv(const SparseMatrix&, const Vector&, Vector&) const override;
     void spmm(const SparseMatrix&, const Matrix&, Matrix&) const override;
     void dsptd(const Vector&, const SparseMatrix&, const Vector&, SparseMatrix&) const override;
+    void spmv(const SparseMatrixFloat&, const VectorFloat&, VectorFloat&) const override;
+    void spmv(const SparseMatrixFloat&, const Vector&, Vector&) const override;
+    void spmm(const SparseMatrixFloat&, const MatrixFloat&, MatrixFloat&) const override;
+    void spmm(const SparseMatrixFloat&, const Matrix&, Matrix&) const override;
     void print(std::ostream&) const override;
 };
 
@@ -0,0 +1,116 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#include "eckit/linalg/sparse/LinearAlgebraSIMD.h"
+
+#include <ostream>
+
+#include "eckit/eckit.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/linalg/Matrix.h"
+#include "eckit/linalg/SparseMatrix.h"
+#include "eckit/linalg/Vector.h"
+#include "eckit/linalg/detail/Partition.h"
+#include "eckit/linalg/detail/SIMD.h"
+
+#if eckit_HAVE_OMP
+#include <omp.h>
+#endif
+
+namespace eckit::linalg::sparse {
+
+static const LinearAlgebraSIMD __la_simd("simd");
+
+using detail::SIMD;
+
+
+namespace {
+
+/// Y = A X for the Nk (contiguous) columns of X and Y, the rows are shared out to the threads by number of non-zeros
+void multiply(const SparseMatrix& A, const Scalar* X, Scalar* Y, Size Nk) {
+    const auto Ni = A.rows();
+    const auto Nj = A.cols();
+
+    const auto* const outer = A.outer();
+    const auto* const inner = A.inner();
+    const auto* const val   = A.data();
+
+#if eckit_HAVE_OMP
+#pragma omp parallel
+#endif
+    {
+        Size part  = 0;
+        Size parts = 1;
+#if eckit_HAVE_OMP
+        part  = static_cast<Size>(omp_get_thread_num());
+        parts = static_cast<Size>(omp_get_num_threads());
+#endif
+
+        const Size begin = detail::partitionBegin(outer, Ni, part, parts);
+        const Size end   = detail::partitionBegin(outer, Ni, part + 1, parts);
+
+        for (Size k = 0; k < Nk; ++k) {
+            SIMD::csr(outer, inner, val, X + k * Nj, Y + k * Ni, begin, end);
+        }
+    }
+}
+
+}  // namespace
+
+
+void LinearAlgebraSIMD::print(std::ostream& out) const {
+    out << "LinearAlgebraSIMD[" << SIMD::name() << "]";
+}
+
+
+void LinearAlgebraSIMD::spmv(const SparseMatrix& A, const Vector& x, Vector& y) const {
+    const auto Ni = A.rows();
+    const auto Nj = A.cols();
+
+    ASSERT(y.rows() == Ni);
+    ASSERT(x.rows() == Nj);
+
+    if (A.empty()) {
+        return;
+    }
+
+    ASSERT(A.outer()[0] == 0);  // expect indices to be 0-based
+
+    multiply(A, x.data(), y.data(), 1);
+}
+
+
+void LinearAlgebraSIMD::spmm(const SparseMatrix& A, const Matrix& B, Matrix& C) const {
+    const auto Ni = A.rows();
+    const auto Nj = A.cols();
+    const auto Nk = B.cols();
+
+    ASSERT(C.rows() == Ni);
+    ASSERT(B.rows() == Nj);
+    ASSERT(C.cols() == Nk);
+
+    if (A.empty()) {
+        return;
+    }
+
+    ASSERT(A.outer()[0] == 0);  // expect indices to be 0-based
+
+    // n.b. the matrices are column-major, so the columns of B and C are contiguous
+    multiply(A, B.data(), C.data(), Nk);
+}
+
+
+void LinearAlgebraSIMD::dsptd(const Vector& x, const SparseMatrix& A, const Vector& y, SparseMatrix& B) const {
+    // Memory bound, nothing to vectorise
+    LinearAlgebraSparse::getBackend("generic").dsptd(x, A, y, B);
+}
+
+}  // namespace eckit::linalg::sparse
@@ -0,0 +1,35 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#pragma once
+
+#include "eckit/linalg/LinearAlgebraSparse.h"
+
+namespace eckit::linalg::sparse {
+
+/// CSR kernels sharing the rows out to the threads by number of non-zeros (rather than by number of rows), with
+/// the inner products vectorised for the CPU the code runs on (see detail::SIMD)
+struct LinearAlgebraSIMD final : public LinearAlgebraSparse {
+    LinearAlgebraSIMD() {}
+    LinearAlgebraSIMD(const std::string& name) :
+        LinearAlgebraSparse(name) {}
+
+    // single precision overloads from the base class (generic kernels)
+    using LinearAlgebraSparse::spmm;
+    using LinearAlgebraSparse::spmv;
+
+    void spmv(const SparseMatrix&, const Vector&, Vector&) const override;
+    void spmm(const SparseMatrix&, const Matrix&, Matrix&) const override;
+    void dsptd(const Vector&, const SparseMatrix&, const Vector&, SparseMatrix&) const override;
+    void print(std::ostream&) const override;
+};
+
+}  // namespace eckit::linalg::sparse
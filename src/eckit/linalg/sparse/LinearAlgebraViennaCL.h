@@ -24,6 +24,10 @@ struct LinearAlgebraViennaCL final : public LinearAlgebraSparse {
     LinearAlgebraViennaCL(const std::string& name) :
         LinearAlgebraSparse(name) {}
 
+    // single precision overloads from the base class (generic kernels)
+    using LinearAlgebraSparse::spmm;
+    using LinearAlgebraSparse::spmv;
+
     void spmv(const SparseMatrix&, const Vector&, Vector&) const override;
     void spmm(const SparseMatrix&, const Matrix&, Matrix&) const override;
     void dsptd(const Vector&, const SparseMatrix&, const Vector&, SparseMatrix&) const override;
@@ -0,0 +1,147 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#include "eckit/linalg/sparse/SELLMatrix.h"
+
+#include <algorithm>
+#include <numeric>
+#include <ostream>
+
+#include "eckit/eckit.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/linalg/SparseMatrix.h"
+#include "eckit/linalg/Vector.h"
+#include "eckit/linalg/detail/Partition.h"
+#include "eckit/linalg/detail/SIMD.h"
+
+#if eckit_HAVE_OMP
+#include <omp.h>
+#endif
+
+namespace eckit::linalg::sparse {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+using detail::SIMD;
+
+
+SELLMatrix::SELLMatrix(const SparseMatrix& A, Size sigma) :
+    rows_(A.rows()), cols_(A.cols()), nnz_(A.nonZeros()), sigma_(sigma) {
+    ASSERT(sigma_ > 0);
+
+    constexpr Size C = SIMD::chunk;
+
+    const Size chunks = (rows_ + C - 1) / C;
+    const Size padded = chunks * C;
+
+    const auto* const outer = A.outer();
+    const auto* const inner = A.inner();
+    const auto* const val   = A.data();
+
+    auto length = [&](Size i) -> Index { return A.empty() ? 0 : outer[i + 1] - outer[i]; };
+
+    // Sort the rows by decreasing length, within windows of sigma rows
+
+    row_.resize(padded, -1);
+    std::iota(row_.begin(), row_.begin() + static_cast<std::ptrdiff_t>(rows_), 0);
+
+    if (sigma_ > 1) {
+        for (Size w = 0; w < rows_; w += sigma_) {
+            auto first = row_.begin() + static_cast<std::ptrdiff_t>(w);
+            auto last  = row_.begin() + static_cast<std::ptrdiff_t>(std::min(w + sigma_, rows_));
+            std::stable_sort(first, last, [&](Index a, Index b) { return length(Size(a)) > length(Size(b)); });
+        }
+    }
+
+    len_.resize(padded, 0);
+    for (Size r = 0; r < rows_; ++r) {
+        len_[r] = length(Size(row_[r]));
+    }
+
+    // Chunks are as wide as their longest row
+
+    start_.resize(chunks + 1, 0);
+    for (Size c = 0; c < chunks; ++c) {
+        Index width   = *std::max_element(len_.begin() + static_cast<std::ptrdiff_t>(c * C),
+                                          len_.begin() + static_cast<std::ptrdiff_t>((c + 1) * C));
+        start_[c + 1] = start_[c] + static_cast<Size>(width) * C;
+    }
+
+    // n.b. the padding is never read from x, see SIMD::sellChunk
+    val_.assign(start_[chunks], 0.);
+    inner_.assign(start_[chunks], 0);
+
+    for (Size r = 0; r < rows_; ++r) {
+        const Size c    = r / C;
+        const Size lane = r % C;
+        const auto i    = static_cast<Size>(row_[r]);
+        for (Index k = 0; k < len_[r]; ++k) {
+            const auto e                           = static_cast<Size>(outer[i] + k);
+            val_[start_[c] + Size(k) * C + lane]   = val[e];
+            inner_[start_[c] + Size(k) * C + lane] = inner[e];
+        }
+    }
+}
+
+
+void SELLMatrix::spmv(const Vector& x, Vector& y) const {
+    ASSERT(y.rows() == rows_);
+    ASSERT(x.rows() == cols_);
+
+    constexpr Size C  = SIMD::chunk;
+    const Size chunks = start_.size() - 1;
+
+#if eckit_HAVE_OMP
+#pragma omp parallel
+#endif
+    {
+        Size part  = 0;
+        Size parts = 1;
+#if eckit_HAVE_OMP
+        part  = static_cast<Size>(omp_get_thread_num());
+        parts = static_cast<Size>(omp_get_num_threads());
+#endif
+
+        // n.b. the chunks are shared out by number of entries, rather than by number of chunks
+        const Size begin = detail::partitionBegin(start_.data(), chunks, part, parts);
+        const Size end   = detail::partitionBegin(start_.data(), chunks, part + 1, parts);
+
+        Scalar out[C];
+        for (Size c = begin; c < end; ++c) {
+            const Size width = (start_[c + 1] - start_[c]) / C;
+            SIMD::sellChunk(val_.data() + start_[c], inner_.data() + start_[c], len_.data() + c * C, width, x.data(),
+                            out);
+
+            for (Size lane = 0; lane < C; ++lane) {
+                const Index i = row_[c * C + lane];
+                if (i >= 0) {
+                    y[static_cast<Size>(i)] = out[lane];
+                }
+            }
+        }
+    }
+}
+
+
+size_t SELLMatrix::footprint() const {
+    return sizeof(*this) + start_.capacity() * sizeof(Size) + (len_.capacity() + row_.capacity()) * sizeof(Index)
+           + val_.capacity() * sizeof(Scalar) + inner_.capacity() * sizeof(Index);
+}
+
+
+void SELLMatrix::print(std::ostream& out) const {
+    out << "SELLMatrix[rows=" << rows_ << ",cols=" << cols_ << ",nnz=" << nnz_ << ",C=" << SIMD::chunk
+        << ",sigma=" << sigma_ << ",stored=" << storedSize() << "]";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::linalg::sparse
@@ -0,0 +1,74 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+
+#include "eckit/linalg/types.h"
+#include "eckit/memory/NonCopyable.h"
+
+namespace eckit::linalg::sparse {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Sparse matrix in SELL-C-sigma format, for repeated products with vectors.
+///
+/// The rows are grouped in chunks of C rows (detail::SIMD::chunk), stored column by column and padded to the
+/// longest row of the chunk, so that a chunk is multiplied with one SIMD lane per row. To limit the padding, the
+/// rows are sorted by decreasing length within windows of sigma rows; the sort does not move rows further apart
+/// than sigma, which preserves the locality of the accesses to x.
+///
+/// Building the layout costs about as much as a few products, it is worth it when a matrix (e.g. of interpolation
+/// weights) is applied to many vectors.
+class SELLMatrix : private NonCopyable {
+public:
+    /// @param sigma sorting window, in rows (1 for no sorting)
+    explicit SELLMatrix(const SparseMatrix&, Size sigma = 256);
+
+    /// Compute the product y = A x
+    /// @note y must be allocated and sized correctly
+    void spmv(const Vector& x, Vector& y) const;
+
+    Size rows() const { return rows_; }
+    Size cols() const { return cols_; }
+    Size nonZeros() const { return nnz_; }
+
+    /// @returns number of entries stored, including the padding
+    Size storedSize() const { return val_.size(); }
+
+    /// Returns the footprint of the matrix in memory
+    size_t footprint() const;
+
+    void print(std::ostream&) const;
+
+private:
+    Size rows_;
+    Size cols_;
+    Size nnz_;
+    Size sigma_;
+
+    std::vector<Size> start_;   ///< first entry of each chunk, sized number of chunks + 1
+    std::vector<Index> len_;    ///< length of the rows, in storage order
+    std::vector<Index> row_;    ///< row of the matrix in storage order, -1 for padding
+    std::vector<Scalar> val_;   ///< entries, chunk by chunk, column by column
+    std::vector<Index> inner_;  ///< column indices of the entries
+
+    friend std::ostream& operator<<(std::ostream& os, const SELLMatrix& m) {
+        m.print(os);
+        return os;
+    }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::linalg::sparse
@@ -23,8 +23,20 @@ using Scalar = double;
 using Index  = int;
 using Size   = size_t;
 
-class Vector;
-class Matrix;
-class SparseMatrix;
+template <typename S>
+class VectorT;
+template <typename S>
+class MatrixT;
+template <typename S>
+class SparseMatrixT;
+
+using Vector       = VectorT<Scalar>;
+using Matrix       = MatrixT<Scalar>;
+using SparseMatrix = SparseMatrixT<Scalar>;
+
+/// Single precision storage, e.g. for interpolation weights (reduces the memory traffic of spmv/spmm)
+using VectorFloat       = VectorT<float>;
+using MatrixFloat       = MatrixT<float>;
+using SparseMatrixFloat = SparseMatrixT<float>;
 
 }  // namespace eckit::linalg
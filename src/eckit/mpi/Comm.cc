@@ -289,6 +289,10 @@ Comm::Comm(const std::string& name) :
 
 Comm::~Comm() {}
 
+NodeBuffer Comm::broadcastFileShared(const PathName& filepath, size_t root) const {
+    return NodeBuffer(broadcastFile(filepath, root));
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 Comm& comm(const char* name) {
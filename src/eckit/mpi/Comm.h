@@ -23,6 +23,7 @@
 #include "eckit/mpi/Buffer.h"
 #include "eckit/mpi/DataType.h"
 #include "eckit/mpi/Group.h"
+#include "eckit/mpi/NodeBuffer.h"
 #include "eckit/mpi/Operation.h"
 #include "eckit/mpi/Request.h"
 #include "eckit/mpi/Status.h"
@@ -387,6 +388,11 @@ public:  // methods
 
     virtual eckit::SharedBuffer broadcastFile(const eckit::PathName& filepath, size_t root) const = 0;
 
+    /// @brief Read file on one rank, and broadcast to one rank per node, which shares it with the other ranks of its
+    /// node (the contents are then in memory once per node, and read-only). By default, the contents are broadcast to
+    /// every rank (see broadcastFile)
+    virtual NodeBuffer broadcastFileShared(const eckit::PathName& filepath, size_t root) const;
+
     /// @brief Split the communicator based on color & give the new communicator a name
     virtual Comm& split(int color, const std::string& name) const = 0;
 
@@ -0,0 +1,68 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "eckit/mpi/NodeBuffer.h"
+
+#include "eckit/exception/Exceptions.h"
+
+namespace eckit::mpi {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+class LocalBuffer : public NodeBufferContent {
+public:
+    explicit LocalBuffer(const SharedBuffer& buffer) :
+        buffer_(buffer) {}
+
+    const void* data() const override { return buffer_->data(); }
+    size_t size() const override { return buffer_.size(); }
+
+private:
+    SharedBuffer buffer_;
+};
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+NodeBuffer::NodeBuffer(NodeBufferContent* p) :
+    content_(p) {
+    ASSERT(p);
+    content_->attach();
+}
+
+NodeBuffer::NodeBuffer(const SharedBuffer& buffer) :
+    content_(new LocalBuffer(buffer)) {
+    content_->attach();
+}
+
+NodeBuffer::~NodeBuffer() {
+    content_->detach();
+}
+
+NodeBuffer::NodeBuffer(const NodeBuffer& s) :
+    content_(s.content_) {
+    content_->attach();
+}
+
+NodeBuffer& NodeBuffer::operator=(const NodeBuffer& s) {
+    s.content_->attach();
+    content_->detach();
+    content_ = s.content_;
+    return *this;
+}
+
+NodeBufferContent::~NodeBufferContent() {}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::mpi
@@ -0,0 +1,68 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#ifndef eckit_mpi_NodeBuffer_h
+#define eckit_mpi_NodeBuffer_h
+
+#include <cstddef>
+#include <string>
+
+#include "eckit/io/SharedBuffer.h"
+#include "eckit/memory/Counted.h"
+
+namespace eckit::mpi {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class NodeBufferContent : public Counted {
+public:
+    ~NodeBufferContent() override;
+
+    virtual const void* data() const = 0;
+    virtual size_t size() const      = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Read-only memory with the same contents on all tasks, which may be shared by the tasks of a node
+/// (see Comm::broadcastFileShared). The memory is released with the last copy on each task.
+/// @invariant content_ is not null
+
+class NodeBuffer {
+
+public:  // methods
+    /// @pre content is not null
+    NodeBuffer(NodeBufferContent* content);
+
+    /// Memory of this task only
+    NodeBuffer(const SharedBuffer&);
+
+    ~NodeBuffer();
+
+    NodeBuffer(const NodeBuffer&);
+
+    NodeBuffer& operator=(const NodeBuffer&);
+
+    const void* data() const { return content_->data(); }
+
+    size_t size() const { return content_->size(); }
+
+    /// Copy of the contents (not null terminated)
+    std::string str() const { return std::string(static_cast<const char*>(data()), size()); }
+
+private:  // members
+    NodeBufferContent* content_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::mpi
+
+#endif
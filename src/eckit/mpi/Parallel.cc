@@ -11,8 +11,12 @@
 #include "eckit/mpi/Parallel.h"
 
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
+#include <cstdio>
 #include <limits>
+#include <memory>
 #include <sstream>
 
 #include "eckit/exception/Exceptions.h"
@@ -20,6 +24,7 @@
 #include "eckit/config/Resource.h"
 #include "eckit/filesystem/PathName.h"
 #include "eckit/io/DataHandle.h"
+#include "eckit/memory/MMap.h"
 #include "eckit/mpi/ParallelGroup.h"
 #include "eckit/mpi/ParallelRequest.h"
 #include "eckit/mpi/ParallelStatus.h"
@@ -726,40 +731,60 @@ int Parallel::communicator() const {
     return MPI_Comm_c2f(comm_);
 }
 
-eckit::SharedBuffer Parallel::broadcastFile(const PathName& filepath, size_t root) const {
+namespace {
 
-    ASSERT(root < size());
+struct BFileOp {
+    int err_;
+    size_t len_;
+    size_t chunk_;  ///< Of the root, so that all tasks post the same broadcasts
+};
+
+/// Communicator created for the duration of a call
+struct TemporaryComm {
+    MPI_Comm comm_ = MPI_COMM_NULL;
+    ~TemporaryComm() {
+        if (comm_ != MPI_COMM_NULL) {
+            MPI_Comm_free(&comm_);
+        }
+    }
+};
 
-    bool isRoot = rank() == root;
+size_t broadcastFileChunkSize() {
+    // n.b. the counts of MPI calls are int
+    long size = eckit::Resource<long>("MPIBroadcastFileChunkSize;$ECKIT_MPI_BROADCAST_FILE_CHUNK_SIZE",
+                                      64 * 1024 * 1024);
+    ASSERT(0 < size && size < long(std::numeric_limits<int>::max()));
+    return size_t(size);
+}
 
-    eckit::CountedBuffer* buffer = nullptr;
+/// Open the file on the root (returned), and broadcast its length and the chunk size of the root (throws on all tasks
+/// if it cannot be read)
+std::unique_ptr<DataHandle> openFile(MPI_Comm comm, bool isRoot, int root, const PathName& filepath, size_t& length,
+                                     size_t& chunk) {
+    std::unique_ptr<DataHandle> dh;
 
-    struct BFileOp {
-        int err_;
-        size_t len_;
-    } op = {0, 0};
+    BFileOp op = {0, 0, 0};
 
     errno = 0;
 
     if (isRoot) {
         try {
-            std::unique_ptr<DataHandle> dh(filepath.fileHandle());
-
-            op.len_ = dh->openForRead();
-            AutoClose closer(*dh);
-            buffer = new eckit::CountedBuffer(op.len_);
-            dh->read(buffer->data(), op.len_);
-
+            op.chunk_ = broadcastFileChunkSize();
             if (filepath.isDir()) {
                 op.err_ = EISDIR;
             }
+            else {
+                dh.reset(filepath.fileHandle());
+                op.len_ = dh->openForRead();
+            }
         }
         catch (Exception&) {
-            op.err_ = errno;
+            op.err_ = errno ? errno : EIO;
+            dh.reset();
         }
     }
 
-    broadcast(&op, sizeof(op), Data::BYTE, root);
+    MPI_CALL(MPI_Bcast(&op, sizeof(op), MPI_BYTE, root, comm));
 
     errno = op.err_;  // set errno to ensure consistent error messages across MPI tasks
 
@@ -771,13 +796,167 @@ eckit::SharedBuffer Parallel::broadcastFile(const PathName& filepath, size_t roo
         throw ShortFile(filepath);
     }
 
-    if (!isRoot) {
-        buffer = new eckit::CountedBuffer(op.len_);
+    length = op.len_;
+    chunk  = op.chunk_;
+    return dh;
+}
+
+/// Broadcast the file open on the root (dh) into buffer, in chunks, reading the next chunk while the previous one is
+/// in flight. @returns the read error of the root (or 0) on all tasks
+int broadcastChunks(MPI_Comm comm, int root, DataHandle* dh, char* buffer, size_t length, size_t chunk) {
+    int err = 0;
+
+    MPI_Request request = MPI_REQUEST_NULL;
+    for (size_t offset = 0; offset < length; offset += chunk) {
+        size_t len = std::min(chunk, length - offset);
+        char* p    = buffer + offset;
+
+        if (dh && !err) {
+            try {
+                errno = 0;
+                if (dh->read(p, long(len)) != long(len)) {
+                    err = errno ? errno : EIO;
+                }
+            }
+            catch (Exception&) {
+                err = errno ? errno : EIO;
+            }
+        }
+
+        // n.b. after a read error, the root still takes part in the remaining broadcasts
+        MPI_Request next;
+        MPI_CALL(MPI_Ibcast(p, int(len), MPI_BYTE, root, comm, &next));
+        MPI_CALL(MPI_Wait(&request, MPI_STATUS_IGNORE));
+        request = next;
     }
+    MPI_CALL(MPI_Wait(&request, MPI_STATUS_IGNORE));
+
+    MPI_CALL(MPI_Bcast(&err, 1, MPI_INT, root, comm));
+    return err;
+}
+
+/// File mapped in memory shared by the tasks of a node
+class SharedMemory : public NodeBufferContent {
+public:
+    SharedMemory(void* address, size_t size) :
+        address_(address), size_(size) {}
+
+    ~SharedMemory() override { MMap::munmap(address_, size_); }
+
+    const void* data() const override { return address_; }
+    size_t size() const override { return size_; }
+
+private:
+    void* address_;
+    size_t size_;
+};
+
+}  // namespace
+
+eckit::SharedBuffer Parallel::broadcastFile(const PathName& filepath, size_t root) const {
+
+    ASSERT(root < size());
+
+    size_t length                  = 0;
+    size_t chunk                   = 0;
+    std::unique_ptr<DataHandle> dh = openFile(comm_, rank() == root, int(root), filepath, length, chunk);
+    std::unique_ptr<AutoClose> closer(dh ? new AutoClose(*dh) : nullptr);
 
-    broadcast(*buffer, op.len_, Data::BYTE, root);
+    eckit::SharedBuffer buffer(length);
+
+    errno = broadcastChunks(comm_, int(root), dh.get(), static_cast<char*>(buffer.data()), length, chunk);
+    if (errno) {
+        throw ReadError(filepath);
+    }
+
+    return buffer;
+}
+
+NodeBuffer Parallel::broadcastFileShared(const PathName& filepath, size_t root) const {
+
+    ASSERT(root < size());
+
+    // The tasks of each node, and a leader per node (the root leads its node)
+    const int key = rank() == root ? -1 : int(rank());
+
+    TemporaryComm node;
+    MPI_CALL(MPI_Comm_split_type(comm_, MPI_COMM_TYPE_SHARED, key, MPI_INFO_NULL, &node.comm_));
+
+    int nodeRank = 0;
+    MPI_CALL(MPI_Comm_rank(node.comm_, &nodeRank));
+    const bool leader = nodeRank == 0;
+
+    TemporaryComm leaders;
+    MPI_CALL(MPI_Comm_split(comm_, leader ? 0 : MPI_UNDEFINED, key, &leaders.comm_));
+
+    size_t length                  = 0;
+    size_t chunk                   = 0;
+    std::unique_ptr<DataHandle> dh = openFile(comm_, rank() == root, int(root), filepath, length, chunk);
+    std::unique_ptr<AutoClose> closer(dh ? new AutoClose(*dh) : nullptr);
+
+    // Memory shared by the tasks of the node, created by the leader and unlinked once mapped by all
+    static size_t count = 0;
+
+    char name[256] = {};
+    void* address  = MAP_FAILED;
+    int err        = 0;
+
+    if (leader) {
+        ::snprintf(name, sizeof(name), "/eckit-broadcast-%ld-%zu", long(::getpid()), count++);
+
+        int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0 || ::ftruncate(fd, off_t(length)) != 0
+            || (address = MMap::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+            err = errno;
+            Log::error() << "Parallel::broadcastFileShared(" << name << ')' << Log::syserr << std::endl;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    MPI_CALL(MPI_Bcast(name, sizeof(name), MPI_CHAR, 0, node.comm_));
+
+    if (!leader) {
+        int fd = ::shm_open(name, O_RDONLY, 0);
+        if (fd < 0 || (address = MMap::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+            err = errno;
+            Log::error() << "Parallel::broadcastFileShared(" << name << ')' << Log::syserr << std::endl;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    MPI_CALL(MPI_Allreduce(MPI_IN_PLACE, &err, 1, MPI_INT, MPI_MAX, comm_));
+
+    if (leader) {
+        ::shm_unlink(name);
+    }
+
+    if (err) {
+        if (address != MAP_FAILED) {
+            MMap::munmap(address, length);
+        }
+        errno = err;
+        throw FailedSystemCall("Parallel::broadcastFileShared: cannot share memory on node", Here());
+    }
+
+    NodeBuffer buffer(new SharedMemory(address, length));
+
+    // Leaders receive the file, then let the tasks of their node know that it is there
+    if (leader) {
+        err = broadcastChunks(leaders.comm_, 0, dh.get(), static_cast<char*>(address), length, chunk);
+    }
+
+    MPI_CALL(MPI_Bcast(&err, 1, MPI_INT, 0, node.comm_));
+
+    errno = err;
+    if (errno) {
+        throw ReadError(filepath);
+    }
 
-    return eckit::SharedBuffer(buffer);
+    return buffer;
 }
 
 static CommBuilder<Parallel> ParallelBuilder("parallel");
@@ -119,6 +119,8 @@ protected:  // methods
 
     eckit::SharedBuffer broadcastFile(const eckit::PathName& filepath, size_t root) const override;
 
+    NodeBuffer broadcastFileShared(const eckit::PathName& filepath, size_t root) const override;
+
     Comm& split(int color, const std::string& name) const override;
 
     void free() override;
@@ -10,6 +10,10 @@
 
 
 #include "eckit/net/Connector.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "eckit/config/Resource.h"
 #include "eckit/io/cluster/ClusterNodes.h"
 #include "eckit/net/TCPClient.h"
@@ -66,6 +70,7 @@ TCPSocket& Connector::socket() {
             TCPClient client(SocketOptions::control());
             Log::info() << "Connector::stream connecting to " << host_ << ":" << port_ << std::endl;
             socket_ = client.connect(host_, port_, -1);
+            inPos_ = inEnd_ = 0;
             InstantTCPStream s(socket_);
 
             // Login
@@ -246,6 +251,7 @@ void Connector::reset() {
     in_.reset();
     out_.reset();
     cache_.clear();
+    outPos_ = inPos_ = inEnd_ = 0;
 
     try {
         socket_.close();
@@ -262,24 +268,78 @@ std::string Connector::name() const {
     return os.str();
 }
 
+void Connector::socketError(long got, long len, const char* msg) {
+    reset();
+    ConnectorCache::instance().reset();
+    NodeInfoCache::instance().reset();
+    std::ostringstream os;
+    os << "Connector::socketIo(" << name() << ") only " << got << " byte(s) " << msg << " intead of " << len
+       << Log::syserr;
+    // throw ConnectorException(std::string(os));
+    throw Retry(os.str());
+}
+
 template <class T, class F>
 long Connector::socketIo(F proc, T buf, long len, const char* msg, time_t& last) {
     TCPSocket& s = socket();
     last = ::time(0);
     long l       = (s.*proc)(buf, len);
     if (l != len) {
-        reset();
-        ConnectorCache::instance().reset();
-        NodeInfoCache::instance().reset();
-        std::ostringstream os;
-        os << "Connector::socketIo(" << name() << ") only " << l << " byte(s) " << msg << " intead of " << len
-           << Log::syserr;
-        // throw ConnectorException(std::string(os));
-        throw Retry(os.str());
+        socketError(l, len, msg);
     }
     return l;
 }
 
+void Connector::buffered(size_t size) {
+    flush();
+    ASSERT(inPos_ == inEnd_);  // n.b. would lose the bytes read ahead
+
+    outBuffer_.resize(size);
+    inBuffer_.resize(size);
+    outPos_ = inPos_ = inEnd_ = 0;
+}
+
+void Connector::flush() {
+    if (outPos_ > 0) {
+        const long len = long(outPos_);
+        outPos_        = 0;
+        socketIo(&TCPSocket::write, static_cast<const void*>(outBuffer_.data()), len, "written", last_);
+    }
+}
+
+long Connector::bufferedRead(void* buf, long len) {
+    char* p       = static_cast<char*>(buf);
+    long received = 0;
+
+    while (received < len) {
+        if (inPos_ == inEnd_) {
+            const auto left = size_t(len - received);
+
+            // Large reads bypass the buffer
+            if (left >= inBuffer_.size()) {
+                socketIo(&TCPSocket::read, static_cast<void*>(p + received), long(left), "read", last_);
+                return len;
+            }
+
+            TCPSocket& s = socket();
+            last_        = ::time(0);
+            long n       = s.readSome(inBuffer_.data(), long(inBuffer_.size()));
+            if (n <= 0) {
+                socketError(received, len, "read");
+            }
+            inPos_ = 0;
+            inEnd_ = size_t(n);
+        }
+
+        const auto n = std::min(size_t(len - received), inEnd_ - inPos_);
+        ::memcpy(p + received, inBuffer_.data() + inPos_, n);
+        inPos_ += n;
+        received += long(n);
+    }
+
+    return received;
+}
+
 long Connector::write(const void* buf, long len) {
     if (in_.count()) {
         in_.reset();
@@ -294,6 +354,17 @@ long Connector::write(const void* buf, long len) {
         return len;
     }
 
+    if (!outBuffer_.empty() && len > 0) {
+        if (outPos_ + size_t(len) > outBuffer_.size()) {
+            flush();
+        }
+        if (size_t(len) < outBuffer_.size()) {
+            ::memcpy(outBuffer_.data() + outPos_, buf, size_t(len));
+            outPos_ += size_t(len);
+            return len;
+        }
+    }
+
     return socketIo(&TCPSocket::write, buf, len, "written", last_);
 }
 
@@ -350,7 +421,9 @@ long Connector::read(void* buf, long len) {
     }
 
     try {
-        len = socketIo(&TCPSocket::read, buf, len, "read", last_);
+        // n.b. the peer may be waiting for these before replying
+        flush();
+        len = inBuffer_.empty() ? socketIo(&TCPSocket::read, buf, len, "read", last_) : bufferedRead(buf, len);
     }
     catch (...) {
         reset();
@@ -371,6 +444,9 @@ void Connector::memoize(bool on, unsigned long life) {
     life_    = life;
 
     if (on) {
+        // n.b. the memoized requests are sent directly, after what was written before
+        flush();
+
         ASSERT(in_.count() == 0);
         ASSERT(out_.count() == 0);
         sent_ = false;
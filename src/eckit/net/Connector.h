@@ -15,6 +15,8 @@
 #ifndef eckit_net_Connector_h
 #define eckit_net_Connector_h
 
+#include <vector>
+
 #include "eckit/io/BufferCache.h"
 #include "eckit/io/Length.h"
 #include "eckit/io/cluster/NodeInfo.h"
@@ -58,6 +60,15 @@ public:
 
     void memoize(bool on, unsigned long time);
 
+    /// Buffer the writes and the reads, in buffers of size bytes (0: unbuffered, the default), as TCPStreamBase does
+    ///
+    /// Writes are sent when the buffer is full, on flush() and before reading. Reads take whatever the socket has, up
+    /// to the size of the buffer. Writes not yet sent and bytes read ahead are discarded by reset() and on destruction
+    void buffered(size_t size);
+
+    /// Send the buffered writes
+    void flush();
+
     static Connector& service(const NodeInfo& node);
     static Connector& service(const std::string& name, const std::string& node);
 
@@ -109,12 +120,21 @@ private:
         size_t size_;
     } cached_;
 
+    std::vector<char> outBuffer_;
+    size_t outPos_ = 0;
+
+    std::vector<char> inBuffer_;
+    size_t inPos_ = 0;
+    size_t inEnd_ = 0;
+
     // -- Methods
     // None
 
     TCPSocket& socket();
     template <class T, class F>
     long socketIo(F proc, T buf, long len, const char*, time_t&);
+    [[noreturn]] void socketError(long got, long len, const char*);
+    long bufferedRead(void* buf, long len);
 
     // -- Overridden methods
     // None
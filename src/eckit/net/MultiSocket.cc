@@ -8,9 +8,15 @@
  * does it submit to any jurisdiction.
  */
 
+#include <poll.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#include <chrono>
+#include <cstring>
 #include <memory>
+#include <sstream>
 
+#include "eckit/log/Statistics.h"
 #include "eckit/net/MultiSocket.h"
 #include "eckit/net/TCPClient.h"
 #include "eckit/net/TCPServer.h"
@@ -19,7 +25,42 @@
 
 namespace eckit::net {
 
-const size_t VERSION = 1;
+// Version 1: chunks sent round-robin over the sockets
+// Version 2: chunks prefixed with a header (sequence number and length) and sent on any socket
+const size_t VERSION_ROUND_ROBIN = 1;
+const size_t VERSION_ADAPTIVE    = 2;
+
+namespace {
+
+// Big-endian sequence number (8 bytes) and length (4 bytes)
+constexpr size_t HEADER_SIZE = 12;
+
+void encodeHeader(unsigned char* h, unsigned long long sequence, size_t length) {
+    for (int i = 7; i >= 0; --i, sequence >>= 8) {
+        h[i] = static_cast<unsigned char>(sequence & 0xff);
+    }
+    for (int i = 11; i >= 8; --i, length >>= 8) {
+        h[i] = static_cast<unsigned char>(length & 0xff);
+    }
+}
+
+void decodeHeader(const unsigned char* h, unsigned long long& sequence, size_t& length) {
+    sequence = 0;
+    for (int i = 0; i < 8; ++i) {
+        sequence = (sequence << 8) | h[i];
+    }
+    length = 0;
+    for (int i = 8; i < 12; ++i) {
+        length = (length << 8) | h[i];
+    }
+}
+
+double since(const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
 // Server
 
 MultiSocket::MultiSocket(int port) {
@@ -36,9 +77,33 @@ MultiSocket::MultiSocket(size_t streams, size_t messageSize) :
 
 
 MultiSocket::~MultiSocket() {
+    try {
+        flush();
+    }
+    catch (std::exception& e) {
+        Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
+        Log::error() << "** Exception is ignored" << std::endl;
+    }
     cleanup();
 }
 
+void MultiSocket::reset() {
+    out_.clear();
+    outPos_          = 0;
+    writeSequence_   = 0;
+    lastWriteSocket_ = 0;
+
+    pending_.clear();
+    inPos_        = 0;
+    readSequence_ = 0;
+    readNext_.assign(streams_, 0);
+    eof_.assign(streams_, false);
+    reordered_ = 0;
+
+    sent_.assign(streams_, StreamStatistics());
+    received_.assign(streams_, StreamStatistics());
+}
+
 void MultiSocket::cleanup() {
     delete accept_;
     accept_ = nullptr;
@@ -50,6 +115,7 @@ void MultiSocket::cleanup() {
 }
 
 void MultiSocket::close() {
+    flush();
     if (accept_) {
         select_.remove(*accept_);
         accept_->close();
@@ -62,6 +128,260 @@ void MultiSocket::close() {
 }
 
 long MultiSocket::write(const void* buf, long length) {
+    if (!adaptive_) {
+        return writeRoundRobin(buf, length);
+    }
+
+    ASSERT(messageSize_);
+
+    if (out_.size() != messageSize_) {
+        out_.resize(messageSize_);
+    }
+
+    const char* p = reinterpret_cast<const char*>(buf);
+    long written  = 0;
+
+    while (length > 0) {
+
+        // Whole chunks are sent from the caller's buffer
+        if (outPos_ == 0 && size_t(length) >= messageSize_) {
+            sendChunk(p, messageSize_);
+            p += messageSize_;
+            length -= long(messageSize_);
+            written += long(messageSize_);
+            continue;
+        }
+
+        size_t len = std::min(messageSize_ - outPos_, size_t(length));
+        ::memcpy(out_.data() + outPos_, p, len);
+        outPos_ += len;
+        p += len;
+        length -= long(len);
+        written += long(len);
+
+        if (outPos_ == messageSize_) {
+            flush();
+        }
+    }
+
+    return written;
+}
+
+void MultiSocket::flush() {
+    if (adaptive_ && outPos_ > 0) {
+        size_t len = outPos_;
+        outPos_    = 0;
+        sendChunk(out_.data(), len);
+    }
+}
+
+size_t MultiSocket::waitForSocket(short events, bool restrict) {
+    const bool reading = (events & POLLIN) != 0;
+    const size_t n     = sockets_.size();
+
+    std::vector<struct pollfd> fds;
+    std::vector<size_t> index;
+    fds.reserve(n);
+    index.reserve(n);
+
+    // n.b. start after the last socket used, so that the sockets that are ready share the chunks
+    const size_t start = reading ? size_t(readSequence_ % n) : lastWriteSocket_ + 1;
+    for (size_t k = 0; k < n; ++k) {
+        size_t i = (start + k) % n;
+        if (reading && (eof_[i] || (restrict && readNext_[i] > readSequence_))) {
+            continue;
+        }
+        fds.push_back({sockets_[i]->socket(), events, 0});
+        index.push_back(i);
+    }
+
+    if (fds.empty()) {
+        return n;
+    }
+
+    for (;;) {
+        int ready = ::poll(fds.data(), fds.size(), -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw FailedSystemCall("poll");
+        }
+
+        for (size_t k = 0; k < fds.size(); ++k) {
+            // n.b. errors and hang-ups are reported by the read or write that follows
+            if (fds[k].revents != 0) {
+                return index[k];
+            }
+        }
+    }
+}
+
+void MultiSocket::sendChunk(const char* buf, size_t length) {
+    ASSERT(length <= messageSize_);
+
+    size_t i = waitForSocket(POLLOUT, false);
+    ASSERT(i < sockets_.size());
+
+    unsigned char header[HEADER_SIZE];
+    encodeHeader(header, writeSequence_, length);
+
+    struct iovec iov[2];
+    iov[0].iov_base = header;
+    iov[0].iov_len  = HEADER_SIZE;
+    iov[1].iov_base = const_cast<char*>(buf);
+    iov[1].iov_len  = length;
+
+    auto start = std::chrono::steady_clock::now();
+
+    long len = sockets_[i]->writev(iov, 2);
+    if (len != long(HEADER_SIZE + length)) {
+        std::ostringstream oss;
+        oss << "MultiSocket: failed to send chunk " << writeSequence_ << " on stream " << i;
+        throw WriteError(oss.str());
+    }
+
+    StreamStatistics& stats = sent_[i];
+    stats.chunks_++;
+    stats.bytes_ += length;
+    stats.elapsed_ += since(start);
+
+    writeSequence_++;
+    lastWriteSocket_ = i;
+}
+
+long MultiSocket::read(void* buf, long length) {
+    if (!adaptive_) {
+        return readRoundRobin(buf, length);
+    }
+
+    ASSERT(messageSize_);
+
+    // The peer may be waiting for what has been written so far
+    flush();
+
+    char* p   = reinterpret_cast<char*>(buf);
+    long read = 0;
+
+    while (length > 0) {
+        auto j = pending_.begin();
+        if (j != pending_.end() && j->first == readSequence_) {
+            const std::vector<char>& chunk = j->second;
+
+            size_t len = std::min(chunk.size() - inPos_, size_t(length));
+            ::memcpy(p, chunk.data() + inPos_, len);
+            inPos_ += len;
+            p += len;
+            length -= long(len);
+            read += long(len);
+
+            if (inPos_ == chunk.size()) {
+                pending_.erase(j);
+                inPos_ = 0;
+                readSequence_++;
+            }
+            continue;
+        }
+
+        long direct = 0;
+        if (!receiveChunk(p, length, direct)) {
+            break;
+        }
+
+        p += direct;
+        length -= direct;
+        read += direct;
+    }
+
+    return read;
+}
+
+bool MultiSocket::receiveChunk(char* buf, long length, long& direct) {
+
+    // Chunks are received in order on each socket, so when too many chunks are waiting for an earlier one, only the
+    // sockets that may carry it are read, which holds back the others
+    const bool restrict = pending_.size() >= 4 * streams_;
+
+    size_t i = waitForSocket(POLLIN, restrict);
+    if (i == sockets_.size()) {
+        if (pending_.empty()) {
+            return false;
+        }
+        std::ostringstream oss;
+        oss << "MultiSocket: end of data, but chunk " << readSequence_ << " not received";
+        throw ReadError(oss.str());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    unsigned char header[HEADER_SIZE];
+    long len = sockets_[i]->read(header, HEADER_SIZE);
+    if (len == 0) {
+        eof_[i] = true;
+        return true;
+    }
+
+    if (len != long(HEADER_SIZE)) {
+        std::ostringstream oss;
+        oss << "MultiSocket: failed to receive chunk header on stream " << i;
+        throw ReadError(oss.str());
+    }
+
+    unsigned long long sequence = 0;
+    size_t size                 = 0;
+    decodeHeader(header, sequence, size);
+
+    ASSERT(size <= messageSize_);
+    ASSERT(sequence >= readNext_[i]);
+    readNext_[i] = sequence + 1;
+
+    char* p = buf;
+    if (sequence == readSequence_ && size <= size_t(length)) {
+        direct = long(size);
+        readSequence_++;
+    }
+    else {
+        if (sequence > readSequence_) {
+            reordered_++;
+        }
+        std::vector<char>& chunk = pending_[sequence];
+        chunk.resize(size);
+        p = chunk.data();
+    }
+
+    if (sockets_[i]->read(p, long(size)) != long(size)) {
+        std::ostringstream oss;
+        oss << "MultiSocket: failed to receive chunk " << sequence << " on stream " << i;
+        throw ReadError(oss.str());
+    }
+
+    StreamStatistics& stats = received_[i];
+    stats.chunks_++;
+    stats.bytes_ += size;
+    stats.elapsed_ += since(start);
+
+    return true;
+}
+
+void MultiSocket::report(std::ostream& out, const char* indent) const {
+    for (size_t i = 0; i < sent_.size(); ++i) {
+        std::string title = "Stream " + std::to_string(i);
+        Statistics::reportCount(out, (title + " chunks sent").c_str(), sent_[i].chunks_, indent);
+        Statistics::reportBytes(out, (title + " bytes sent").c_str(), sent_[i].bytes_, indent);
+        Statistics::reportRate(out, title + " send rate", sent_[i].bytes_, sent_[i].elapsed_, indent);
+    }
+    for (size_t i = 0; i < received_.size(); ++i) {
+        std::string title = "Stream " + std::to_string(i);
+        Statistics::reportCount(out, (title + " chunks received").c_str(), received_[i].chunks_, indent);
+        Statistics::reportBytes(out, (title + " bytes received").c_str(), received_[i].bytes_, indent);
+        Statistics::reportRate(out, title + " receive rate", received_[i].bytes_, received_[i].elapsed_, indent);
+    }
+    if (adaptive_ && !received_.empty()) {
+        Statistics::reportCount(out, "Chunks received out of order", reordered_, indent);
+    }
+}
+
+long MultiSocket::writeRoundRobin(const void* buf, long length) {
     // Log::info() << "MultiSocket::write length=" << length << std::endl;
 
     ASSERT(messageSize_);
@@ -90,7 +410,7 @@ long MultiSocket::write(const void* buf, long length) {
     return written;
 }
 
-long MultiSocket::read(void* buf, long length) {
+long MultiSocket::readRoundRobin(void* buf, long length) {
 
     // Log::info() << "MultiSocket::read length=" << length << std::endl;
 
@@ -140,13 +460,17 @@ MultiSocket& MultiSocket::connect(const std::string& host, int port, int retries
 
     id_ = md5.digest();
 
+    reset();
+
+    const size_t version = adaptive_ ? VERSION_ADAPTIVE : VERSION_ROUND_ROBIN;
+
     for (size_t i = 0; i < streams_; ++i) {
         std::unique_ptr<TCPClient> p(new TCPClient());
         p->bufferSize(bufferSize_);
         p->connect(host, port, retries, timeout);
 
         InstantTCPStream s(*p);
-        s << VERSION;
+        s << version;
         s << id_;
         s << i;
         s << streams_;
@@ -166,6 +490,7 @@ MultiSocket& MultiSocket::accept() {
     messageSize_ = 0;
     id_          = "";
     streams_     = 0;
+    adaptive_    = false;
 
     size_t count = 0;
     size_t i     = 0;
@@ -175,7 +500,7 @@ MultiSocket& MultiSocket::accept() {
 
         size_t version = 0;
         s >> version;
-        ASSERT(version == VERSION);
+        ASSERT(version == VERSION_ROUND_ROBIN || version == VERSION_ADAPTIVE);
 
         size_t streams     = 0;
         size_t messageSize = 0;
@@ -211,6 +536,14 @@ MultiSocket& MultiSocket::accept() {
             Log::info() << "MultiSocket::accept messageSize=" << messageSize << std::endl;
         }
 
+        if (count) {
+            ASSERT(adaptive_ == (version == VERSION_ADAPTIVE));
+        }
+        else {
+            adaptive_ = version == VERSION_ADAPTIVE;
+            Log::info() << "MultiSocket::accept adaptive=" << adaptive_ << std::endl;
+        }
+
         ASSERT(i < streams_);
         ASSERT(sockets_[i] == nullptr);
         sockets_[i] = p.release();
@@ -222,14 +555,50 @@ MultiSocket& MultiSocket::accept() {
         }
     }
 
+    reset();
+
     return *this;
 }
 
+in_addr MultiSocket::remoteAddr() const {
+    ASSERT(!sockets_.empty());
+    return sockets_[0]->remoteAddr();
+}
+
+const std::string& MultiSocket::remoteHost() const {
+    ASSERT(!sockets_.empty());
+    return sockets_[0]->remoteHost();
+}
+
+int MultiSocket::remotePort() const {
+    ASSERT(!sockets_.empty());
+    return sockets_[0]->remotePort();
+}
+
+in_addr MultiSocket::localAddr() const {
+    return sockets_.empty() ? listener().localAddr() : sockets_[0]->localAddr();
+}
+
+const std::string& MultiSocket::localHost() const {
+    return sockets_.empty() ? listener().localHost() : sockets_[0]->localHost();
+}
+
+int MultiSocket::localPort() const {
+    return sockets_.empty() ? listener().localPort() : sockets_[0]->localPort();
+}
+
+const TCPSocket& MultiSocket::listener() const {
+    ASSERT(accept_);
+    return *accept_;
+}
+
 MultiSocket::MultiSocket(MultiSocket& other) :
-    streams_(other.streams_), messageSize_(other.messageSize_) {
+    streams_(other.streams_), messageSize_(other.messageSize_), adaptive_(other.adaptive_) {
     ASSERT(messageSize_);
+    ASSERT(other.outPos_ == 0);
     std::swap(sockets_, other.sockets_);
     ASSERT(sockets_.size() == streams_);
+    reset();
 }
 
 }  // namespace eckit::net
@@ -12,6 +12,8 @@
 #define eckit_net_MultiSocket_h
 
 #include <netinet/in.h>
+#include <iosfwd>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -22,7 +24,22 @@ namespace eckit::net {
 class TCPServer;
 class TCPSocket;
 
+/// Transfer over several TCP connections in parallel, in chunks of up to messageSize bytes.
+///
+/// By default the client uses the original protocol, which sends the chunks round-robin over the sockets, so that it
+/// can talk to older servers. With adaptive(true), the chunks are striped adaptively instead: each chunk is sent, with
+/// a sequence number, on a socket that has room in its send buffer, so that a slow or congested stream takes fewer
+/// chunks rather than stalling the transfer, and the receiver puts the chunks back in order. Servers accept both.
+
 class MultiSocket {
+public:
+    /// Use of a stream, in one direction
+    struct StreamStatistics {
+        size_t chunks_            = 0;
+        unsigned long long bytes_ = 0;
+        double elapsed_           = 0;  // time spent sending (resp. receiving) the chunks
+    };
+
 public:
     MultiSocket(size_t streams, size_t messageSize);  // Client
     MultiSocket(int port);                            // Server
@@ -51,6 +68,22 @@ public:
 
     void bufferSize(int n) { bufferSize_ = n; }
 
+    /// Adaptive striping (client, before connecting), which the server must support
+    void adaptive(bool on) { adaptive_ = on; }
+    bool adaptive() const { return adaptive_; }
+
+    /// Send the chunk being filled, if any (see write)
+    void flush();
+
+    const std::vector<StreamStatistics>& sendStatistics() const { return sent_; }
+    const std::vector<StreamStatistics>& receiveStatistics() const { return received_; }
+
+    /// Chunks received ahead of an earlier one, with adaptive striping
+    size_t reordered() const { return reordered_; }
+
+    /// Per-stream throughput of the transfers so far
+    void report(std::ostream& out, const char* indent = "") const;
+
     void closeOutput();
     void closeInput();
 
@@ -62,6 +95,15 @@ private:  // methods
 
     void print(std::ostream& s) const;
     void cleanup();
+    const TCPSocket& listener() const;
+    void reset();
+
+    long writeRoundRobin(const void* buf, long length);
+    long readRoundRobin(void* buf, long length);
+
+    void sendChunk(const char* buf, size_t length);
+    bool receiveChunk(char* buf, long length, long& direct);
+    size_t waitForSocket(short events, bool restrict);
 
     // ---
 
@@ -82,6 +124,25 @@ private:  // methods
 
     int bufferSize_ = 0;
 
+    // Adaptive striping
+
+    bool adaptive_ = false;
+
+    std::vector<char> out_;
+    size_t outPos_                    = 0;
+    unsigned long long writeSequence_ = 0;
+    size_t lastWriteSocket_           = 0;
+
+    std::map<unsigned long long, std::vector<char>> pending_;  // received out of order, or partially consumed
+    size_t inPos_                    = 0;                      // within the first pending chunk
+    unsigned long long readSequence_ = 0;
+    std::vector<unsigned long long> readNext_;  // per socket, lower bound of the sequence of its next chunk
+    std::vector<bool> eof_;
+    size_t reordered_ = 0;
+
+    std::vector<StreamStatistics> sent_;
+    std::vector<StreamStatistics> received_;
+
     friend std::ostream& operator<<(std::ostream& s, const MultiSocket& socket) {
         socket.print(s);
         return s;
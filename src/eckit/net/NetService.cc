@@ -10,12 +10,26 @@
 
 
 #include "eckit/net/NetService.h"
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include "eckit/config/Resource.h"
 #include "eckit/io/Select.h"
 #include "eckit/log/Log.h"
+#include "eckit/memory/NonCopyable.h"
 #include "eckit/net/NetUser.h"
 #include "eckit/runtime/Monitor.h"
 #include "eckit/runtime/ProcessControler.h"
+#include "eckit/thread/Executor.h"
 #include "eckit/thread/ThreadControler.h"
 
 namespace eckit::net {
@@ -55,6 +69,11 @@ void NetService::run() {
     Monitor::instance().name(name());
     Monitor::instance().kind(name());
 
+    if (runAsEventLoop()) {
+        runEventLoop();
+        return;
+    }
+
     std::ostringstream oss;
     oss << "Waiting on port " << port();
 
@@ -95,10 +114,156 @@ bool NetService::preferToRunAsProcess() const {
     return false;
 }
 
+bool NetService::preferEventLoop() const {
+    return false;
+}
+
+bool NetService::runAsEventLoop() const {
+#if defined(__linux__)
+    return Resource<bool>(name() + "NetServiceEventLoop", preferEventLoop());
+#else
+    return false;  // n.b. requires epoll
+#endif
+}
+
+size_t NetService::workers() const {
+    return Resource<size_t>(name() + "NetServiceWorkers", 0);
+}
+
 long NetService::timeout() const {
     return 0;
 }
 
+#if defined(__linux__)
+
+namespace {
+
+/// An epoll instance, closed on destruction
+class EPoll : private NonCopyable {
+public:
+    EPoll() { SYSCALL(fd_ = ::epoll_create1(EPOLL_CLOEXEC)); }
+    ~EPoll() { ::close(fd_); }
+
+    int fd() const { return fd_; }
+
+private:
+    int fd_;
+};
+
+}  // namespace
+
+void NetService::runEventLoop() {
+    EPoll poll;
+    const int epoll = poll.fd();
+
+    // n.b. events without a user are of the listening socket
+    struct epoll_event listen = {};
+    listen.events             = EPOLLIN;
+    SYSCALL(::epoll_ctl(epoll, EPOLL_CTL_ADD, server_.socket(), &listen));
+
+    // The connections, waiting for a request or being served. Each is served by one worker at a time, its events
+    // being disabled until the worker re-arms them (EPOLLONESHOT)
+    std::mutex mutex;
+    std::map<NetUser*, std::unique_ptr<NetUser>> users;
+
+    auto watch = [epoll](NetUser* user, int op) {
+        struct epoll_event ev = {};
+        ev.events             = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        ev.data.ptr           = user;
+        if (::epoll_ctl(epoll, op, user->protocol_.socket(), &ev) != 0) {
+            Log::error() << "epoll_ctl(" << user->protocol_ << ")" << Log::syserr << std::endl;
+            return false;
+        }
+        return true;
+    };
+
+    auto close = [&](NetUser* user) {
+        ::epoll_ctl(epoll, EPOLL_CTL_DEL, user->protocol_.socket(), nullptr);
+        std::unique_ptr<NetUser> closed;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto j = users.find(user);
+            ASSERT(j != users.end());
+            closed = std::move(j->second);
+            users.erase(j);
+        }
+    };
+
+    auto serve = [&](NetUser* user) {
+        bool more = false;
+        try {
+            // n.b. pipelined requests already read are not signalled by epoll
+            do {
+                more = user->next();
+            } while (more && user->pending());
+        }
+        catch (std::exception& e) {
+            Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
+            Log::error() << "** Exception is handled" << std::endl;
+            more = false;
+        }
+
+        if (!more || !watch(user, EPOLL_CTL_MOD)) {
+            close(user);
+        }
+    };
+
+    std::ostringstream oss;
+    oss << "Waiting on port " << port();
+
+    {
+        Executor executor(name(), workers());
+
+        std::vector<struct epoll_event> events(64);
+        const int wait = timeout() > 0 ? int(timeout() * 1000) : -1;
+
+        while (!stopped()) {
+            Log::status() << oss.str() << std::endl;
+
+            int n = ::epoll_wait(epoll, events.data(), int(events.size()), wait);
+            if (n < 0 && errno != EINTR) {
+                throw FailedSystemCall("epoll_wait");
+            }
+
+            for (int i = 0; i < n; ++i) {
+                auto* user = static_cast<NetUser*>(events[i].data.ptr);
+
+                if (user == nullptr) {
+                    try {
+                        std::unique_ptr<NetUser> accepted(newUser(server_.accept(oss.str())));
+                        user = accepted.get();
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            users[user] = std::move(accepted);
+                        }
+                    }
+                    catch (std::exception& e) {
+                        // e.g. out of file descriptors: the connection stays pending, back off rather than spin
+                        Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
+                        Log::error() << "** Exception is handled" << std::endl;
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                        continue;
+                    }
+                    if (!watch(user, EPOLL_CTL_ADD)) {
+                        close(user);
+                    }
+                    continue;
+                }
+
+                executor.post([&serve, user]() { serve(user); });
+            }
+        }
+    }  // n.b. the requests queued are served before the workers stop, then the users left are closed
+}
+
+#else
+
+void NetService::runEventLoop() {
+    NOTIMP;
+}
+
+#endif
+
 //----------------------------------------------------------------------------------------------------------------------
 
 NetServiceProcessControler::NetServiceProcessControler(const std::string& name, NetUser* user, TCPServer& server,
@@ -48,7 +48,18 @@ private:
     virtual bool preferToRunAsProcess() const;
     virtual bool runAsProcess() const;
 
+    /// Serve the connections from one event loop (epoll) and a pool of workers, rather than a thread or a process per
+    /// connection. The users serve a request at a time (see NetUser::serveRequest), the connections kept alive
+    /// waiting for the next ones in the event loop
+    virtual bool preferEventLoop() const;
+    virtual bool runAsEventLoop() const;
+
+    /// Number of workers of the event loop (0: hardware concurrency)
+    virtual size_t workers() const;
+
     virtual long timeout() const;
+
+    void runEventLoop();
 };
 
 }  // namespace eckit::net
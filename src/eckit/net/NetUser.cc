@@ -10,11 +10,25 @@
 
 
 #include "eckit/net/NetUser.h"
+
+#include <istream>
+#include <ostream>
+
 #include "eckit/io/SockBuf.h"
 #include "eckit/net/TCPStream.h"
 
 namespace eckit::net {
 
+struct NetUser::Streams {
+    explicit Streams(TCPSocket& protocol) :
+        buf_(protocol), out_(&buf_), in_(&buf_), stream_(protocol) {}
+
+    SockBuf buf_;
+    std::ostream out_;
+    std::istream in_;
+    InstantTCPStream stream_;
+};
+
 NetUser::NetUser(net::TCPSocket& protocol) :
     protocol_(protocol) {
     Log::status() << "New connection from " << protocol_.remoteHost() << std::endl;
@@ -33,4 +47,23 @@ void NetUser::run() {
     serve(stream, in, out);
 }
 
+bool NetUser::serveRequest(Stream& stream, std::istream& in, std::ostream& out) {
+    serve(stream, in, out);
+    return false;
+}
+
+bool NetUser::next() {
+    if (!streams_) {
+        streams_ = std::make_unique<Streams>(protocol_);
+    }
+
+    bool more = serveRequest(streams_->stream_, streams_->in_, streams_->out_);
+    streams_->out_.flush();
+    return more && streams_->in_.good();
+}
+
+bool NetUser::pending() const {
+    return streams_ && streams_->buf_.in_avail() > 0;
+}
+
 }  // namespace eckit::net
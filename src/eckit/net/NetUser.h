@@ -11,6 +11,9 @@
 #ifndef eckit_NetUser_h
 #define eckit_NetUser_h
 
+#include <iosfwd>
+#include <memory>
+
 #include "eckit/net/TCPSocket.h"
 #include "eckit/thread/Thread.h"
 
@@ -33,9 +36,24 @@ protected:
 private:
     virtual void serve(Stream&, std::istream&, std::ostream&) = 0;
 
+    /// Serve the next request of the connection, on the event loop of a NetService, and return whether to keep the
+    /// connection for more requests. By default, serves the whole connection (see serve()), taking up a worker
+    /// until the peer closes it.
+    virtual bool serveRequest(Stream&, std::istream&, std::ostream&);
+
     void run() override;
 
+    /// Serve the next request, the streams being kept from request to request
+    bool next();
+
+    /// Whether bytes of the next requests have been read already
+    bool pending() const;
+
+    struct Streams;
+    std::unique_ptr<Streams> streams_;
+
     friend class NetServiceProcessControler;
+    friend class NetService;
 };
 
 
@@ -22,6 +22,7 @@
 #include <unistd.h>
 
 #include <cstring>
+#include <vector>
 
 #include "eckit/config/Resource.h"
 #include "eckit/exception/Exceptions.h"
@@ -201,111 +202,179 @@ long TCPSocket::write(const void* buf, long length) {
     return sent;
 }
 
+long TCPSocket::writev(const struct iovec* iov, int count) {
+
+    // n.b. the debug output is per buffer
+    if (debug_) {
+        long sent = 0;
+        for (int i = 0; i < count; ++i) {
+            long len = write(iov[i].iov_base, long(iov[i].iov_len));
+            if (len < 0) {
+                return len;
+            }
+            sent += len;
+            if (len != long(iov[i].iov_len)) {
+                break;
+            }
+        }
+        return sent;
+    }
+
+    std::vector<struct iovec> v(iov, iov + count);
+    struct iovec* p = v.data();
+    long sent       = 0;
+
+    while (count > 0) {
+        errno    = 0;
+        long len = ::writev(socket_, p, count);
+
+        if (len < 0) {
+            Log::error() << "Socket writev failed (" << *this << ")" << Log::syserr << std::endl;
+            return len;
+        }
+
+        if (len == 0) {
+            Log::warning() << "Socket writev incomplete (" << *this << ") " << sent << " bytes" << std::endl;
+            return sent;
+        }
+
+        sent += len;
+
+        // Skip what has been written, resuming from within a buffer if partially written
+        while (count > 0 && size_t(len) >= p->iov_len) {
+            len -= long(p->iov_len);
+            ++p;
+            --count;
+        }
+        if (count > 0) {
+            p->iov_base = static_cast<char*>(p->iov_base) + len;
+            p->iov_len -= size_t(len);
+        }
+    }
+
+    return sent;
+}
+
 long TCPSocket::read(void* buf, long length) {
     if (length <= 0) {
         return length;
     }
 
+    long received = 0;
+    char* p       = static_cast<char*>(buf);
+
+    while (length > 0) {
+        long len = readSome(p, length);
+
+        if (len < 0) {
+            return len;
+        }
+
+        if (len == 0) {
+            return received;
+        }
+
+        received += len;
+        length -= len;
+        p += len;
+    }
+
+    return received;
+}
+
+long TCPSocket::readSome(void* buf, long length) {
+    if (length <= 0) {
+        return length;
+    }
+
     static bool useSelectOnTCPSocket = Resource<bool>("useSelectOnTCPSocket", false);
-    long received                    = 0;
     char* p                          = static_cast<char*>(buf);
     bool nonews                      = false;
 
-    while (length > 0) {
-        long len;
-        if (useSelectOnTCPSocket) {
-            static long socketSelectTimeout = Resource<long>("socketSelectTimeout", 0);
-            Select select(socket_);
-            bool more = socketSelectTimeout > 0;
-            while (more) {
-                more = false;
-                if (!select.ready(socketSelectTimeout)) {
-                    SavedStatus save;
-
-                    Log::warning() << "No news from " << remoteHost() << " from " << Seconds(socketSelectTimeout)
-                                   << std::endl;
-
-                    Log::status() << "No news from " << remoteHost() << " from " << Seconds(socketSelectTimeout)
-                                  << std::endl;
-
-                    // FIXME: enable the nonews flag here?
-                    // nonews = true;
-
-                    // Time out, write 0 bytes to check that peer is alive
-                    if (::write(socket_, nullptr, 0) != 0) {
-                        Log::error() << "TCPSocket::read write" << Log::syserr << std::endl;
-                        return -1;
-                    }
-                    more = true;
-                    break;
+    long len;
+    if (useSelectOnTCPSocket) {
+        static long socketSelectTimeout = Resource<long>("socketSelectTimeout", 0);
+        Select select(socket_);
+        bool more = socketSelectTimeout > 0;
+        while (more) {
+            more = false;
+            if (!select.ready(socketSelectTimeout)) {
+                SavedStatus save;
+
+                Log::warning() << "No news from " << remoteHost() << " from " << Seconds(socketSelectTimeout)
+                               << std::endl;
+
+                Log::status() << "No news from " << remoteHost() << " from " << Seconds(socketSelectTimeout)
+                              << std::endl;
+
+                // FIXME: enable the nonews flag here?
+                // nonews = true;
+
+                // Time out, write 0 bytes to check that peer is alive
+                if (::write(socket_, nullptr, 0) != 0) {
+                    Log::error() << "TCPSocket::read write" << Log::syserr << std::endl;
+                    return -1;
                 }
+                more = true;
+                break;
             }
+        }
 
-            len = -1;
+        len = -1;
 
-            if (nonews) {
-                AutoAlarm alarm(60, true);
-                Log::status() << "Resuming transfer" << std::endl;
-                len = ::read(socket_, p, length);
-            }
-            else {
-                len = ::read(socket_, p, length);
-            }
+        if (nonews) {
+            AutoAlarm alarm(60, true);
+            Log::status() << "Resuming transfer" << std::endl;
+            len = ::read(socket_, p, length);
         }
         else {
             len = ::read(socket_, p, length);
         }
+    }
+    else {
+        len = ::read(socket_, p, length);
+    }
 
-        if (len < 0) {
-            Log::error() << "Socket read failed (" << *this << ")" << Log::syserr << std::endl;
-            return len;
-        }
+    if (len < 0) {
+        Log::error() << "Socket read failed (" << *this << ")" << Log::syserr << std::endl;
+        return len;
+    }
 
-        if (len == 0) {
-            return received;
-        }
+    if (debug_ && len > 0) {
 
-        if (debug_) {
+        if (mode_ != 'r') {
+            newline_ = true;
+            std::cout << std::endl
+                      << std::endl;
+            mode_ = 'r';
+        }
 
-            if (mode_ != 'r') {
-                newline_ = true;
-                std::cout << std::endl
-                          << std::endl;
-                mode_ = 'r';
+        for (long i = 0; i < std::min(len, 512L); i++) {
+            if (newline_) {
+                std::cout << "<<< ";
+                newline_ = false;
             }
 
-            for (long i = 0; i < std::min(len, 512L); i++) {
-                if (newline_) {
-                    std::cout << "<<< ";
-                    newline_ = false;
-                }
-
-                if (p[i] == '\r') {
-                    std::cout << "\\r";
-                }
-                else if (p[i] == '\n') {
-                    std::cout << "\\n"
-                              << std::endl;
-                    newline_ = true;
-                }
-                else {
-                    std::cout << (isprint(p[i]) ? p[i] : '.');
-                }
+            if (p[i] == '\r') {
+                std::cout << "\\r";
             }
-
-            if (len > 512) {
-                std::cout << "..." << std::endl;
+            else if (p[i] == '\n') {
+                std::cout << "\\n"
+                          << std::endl;
                 newline_ = true;
             }
+            else {
+                std::cout << (isprint(p[i]) ? p[i] : '.');
+            }
         }
 
-
-        received += len;
-        length -= len;
-        p += len;
+        if (len > 512) {
+            std::cout << "..." << std::endl;
+            newline_ = true;
+        }
     }
 
-    return received;
+    return len;
 }
 
 void TCPSocket::close() {
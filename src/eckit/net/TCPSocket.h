@@ -12,6 +12,7 @@
 #define eckit_net_TCPSocket_h
 
 #include <netinet/in.h>
+#include <sys/uio.h>
 
 #include "eckit/eckit.h"
 #include "eckit/exception/Exceptions.h"
@@ -49,6 +50,11 @@ public:  // methods
 
     long write(const void* buf, long length);
 
+    /// Write the buffers described by iov, in as few system calls as possible (see writev(2))
+    ///
+    /// \return the number of bytes written, or a negative value on error
+    long writev(const struct iovec* iov, int count);
+
     /// Read from a TCP socket
     ///
     /// \param buf The buffer to read into
@@ -61,6 +67,9 @@ public:  // methods
     ///   (only if **useSelectOnTCPSocket** is enabled)
     long read(void* buf, long length);
 
+    /// Read what is available, up to length bytes, in one read(2): 0 at the end of the data, -1 on error
+    long readSome(void* buf, long length);
+
     long rawRead(void*, long);  // Non-blocking version
 
     bool isConnected() const { return socket_ != -1; }
@@ -10,16 +10,132 @@
 
 #include "eckit/net/TCPStream.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include "eckit/log/Log.h"
+
 namespace eckit::net {
 
+//----------------------------------------------------------------------------------------------------------------------
+
+void TCPStreamBase::buffered(size_t size) {
+    flush();
+    ASSERT(inPos_ == inEnd_);  // n.b. would lose the bytes read ahead
+
+    out_.resize(size);
+    in_.resize(size);
+    outPos_ = inPos_ = inEnd_ = 0;
+}
+
+void TCPStreamBase::flush() {
+    if (outPos_ > 0) {
+        long len = socket().write(out_.data(), long(outPos_));
+        if (len != long(outPos_)) {
+            throw WriteError(name());
+        }
+        outPos_ = 0;
+    }
+}
+
+void TCPStreamBase::flushNoThrow() {
+    try {
+        flush();
+    }
+    catch (std::exception& e) {
+        Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
+        Log::error() << "** Exception is ignored" << std::endl;
+    }
+}
+
+long TCPStreamBase::write(const void* buf, long len) {
+    if (out_.empty()) {
+        return socket().write(buf, len);
+    }
+
+    if (len <= 0) {
+        return len;
+    }
+
+    if (outPos_ + size_t(len) <= out_.size()) {
+        ::memcpy(out_.data() + outPos_, buf, size_t(len));
+        outPos_ += size_t(len);
+        return len;
+    }
+
+    // The buffer and the bytes that do not fit in it, in one system call
+    struct iovec iov[2];
+    iov[0].iov_base = out_.data();
+    iov[0].iov_len  = outPos_;
+    iov[1].iov_base = const_cast<void*>(buf);
+    iov[1].iov_len  = size_t(len);
+
+    const auto pending = long(outPos_);
+    outPos_            = 0;
+
+    const long sent = socket().writev(iov, 2);
+    return sent < 0 ? sent : std::max(0L, sent - pending);
+}
+
+long TCPStreamBase::read(void* buf, long len) {
+    if (in_.empty()) {
+        return socket().read(buf, len);
+    }
+
+    // n.b. the peer may be waiting for these before replying
+    flush();
+
+    char* p       = static_cast<char*>(buf);
+    long received = 0;
+
+    while (received < len) {
+        if (inPos_ == inEnd_) {
+            const auto left = size_t(len - received);
+
+            // Large reads bypass the buffer
+            if (left >= in_.size()) {
+                long n = socket().read(p + received, long(left));
+                return n < 0 && received == 0 ? n : received + std::max(0L, n);
+            }
+
+            long n = socket().readSome(in_.data(), long(in_.size()));
+            if (n <= 0) {
+                return n < 0 && received == 0 ? n : received;
+            }
+            inPos_ = 0;
+            inEnd_ = size_t(n);
+        }
+
+        const auto n = std::min(size_t(len - received), inEnd_ - inPos_);
+        ::memcpy(p + received, in_.data() + inPos_, n);
+        inPos_ += n;
+        received += long(n);
+    }
+
+    return received;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 TCPStream::TCPStream(net::TCPSocket& socket) :
     socket_(socket) {}
 
-TCPStream::~TCPStream() {}
+TCPStream::~TCPStream() {
+    flushNoThrow();
+}
 
 void TCPStream::closeOutput() {
+    flush();
     socket_.closeOutput();
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+
+InstantTCPStream::~InstantTCPStream() {
+    flushNoThrow();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------------------------
 // Tricky solution to be removed when 'mutable' is available
 //
@@ -14,6 +14,8 @@
 #ifndef eckit_TCPStream_h
 #define eckit_TCPStream_h
 
+#include <vector>
+
 #include "eckit/memory/Counted.h"
 #include "eckit/net/TCPSocket.h"
 #include "eckit/serialisation/Stream.h"
@@ -30,17 +32,40 @@ public:
 
     in_addr remoteAddr() { return socket().remoteAddr(); }
 
-    long write(const void* buf, long len) override { return socket().write(buf, len); }
+    long write(const void* buf, long len) override;
+
+    long read(void* buf, long len) override;
+
+    /// Buffer the writes and the reads, in buffers of size bytes (0: unbuffered, the default)
+    ///
+    /// Writes are sent when the buffer is full, on flush(), before reading and when the stream is destroyed. Writes
+    /// that do not fit are sent together with the buffer, in one system call. Reads take whatever the socket has, up
+    /// to the size of the buffer, so the stream may read ahead of the message being decoded.
+    ///
+    /// @note As the bytes read ahead are lost with the stream, only buffer the reads of a stream that reads all the
+    /// messages from its socket (not of a temporary InstantTCPStream sharing the socket with other streams)
+    void buffered(size_t size);
 
-    long read(void* buf, long len) override { return socket().read(buf, len); }
+    /// Send the buffered writes
+    void flush();
 
 protected:
     std::string name() const override;
 
+    /// Flush, from the destructors of the subclasses (which own or refer to the socket), logging errors
+    void flushNoThrow();
 
 private:  // methods
     std::string nonConstName();
     virtual TCPSocket& socket() = 0;
+
+private:  // members
+    std::vector<char> out_;
+    size_t outPos_ = 0;
+
+    std::vector<char> in_;
+    size_t inPos_ = 0;
+    size_t inEnd_ = 0;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -72,6 +97,8 @@ public:
     InstantTCPStream(net::TCPSocket& socket) :
         socket_(socket) {}
 
+    ~InstantTCPStream() override;
+
     TCPSocket& socket() override { return socket_; }
 
 private:
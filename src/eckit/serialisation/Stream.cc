@@ -17,12 +17,20 @@
 #include <cassert>
 #include <cstring>
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <tmmintrin.h>
+#define ECKIT_STREAM_SSSE3
+#endif
+
+#include "eckit/eckit.h"
+
 #include "eckit/exception/Exceptions.h"
 #include "eckit/io/Buffer.h"
 #include "eckit/log/Log.h"
 #include "eckit/maths/Functions.h"
 #include "eckit/os/BackTrace.h"
 #include "eckit/serialisation/BadTag.h"
+#include "eckit/utils/ByteSwap.h"
 
 namespace eckit {
 
@@ -58,7 +66,8 @@ static const char* tag_names[] = {"0",
                                   "start of record",
                                   "end of record",
                                   "end of file",
-                                  "large blob"};
+                                  "large blob",
+                                  "array"};
 
 const int tag_count = sizeof(tag_names) / sizeof(tag_names[0]);
 
@@ -568,6 +577,137 @@ void Stream::readLargeBlob(void* buffer, size_t size) {
     }
 }
 
+namespace {
+
+#if eckit_LITTLE_ENDIAN
+constexpr unsigned char byteOrder = 1;
+#else
+constexpr unsigned char byteOrder = 0;
+#endif
+
+void swapBytesScalar(char* array, size_t size, size_t n) {
+    switch (size) {
+        case 1:
+            return;
+        case 2:
+            return byteswap(reinterpret_cast<std::uint16_t*>(array), n);
+        case 4:
+            return byteswap(reinterpret_cast<std::uint32_t*>(array), n);
+        case 8:
+            return byteswap(reinterpret_cast<std::uint64_t*>(array), n);
+        default:
+            throw BadValue("Stream: cannot swap the bytes of elements of size " + std::to_string(size));
+    }
+}
+
+#if defined(ECKIT_STREAM_SSSE3)
+/// Swap the bytes of the elements 16 bytes at a time, by shuffling them
+__attribute__((target("ssse3"))) void swapBytesSSSE3(char* array, size_t size, size_t n) {
+    const __m128i mask = size == 2   ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+                         : size == 4 ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                                     : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+    const size_t bytes = size * n;
+    size_t i           = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        auto* p = reinterpret_cast<__m128i*>(array + i);
+        _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+    }
+
+    swapBytesScalar(array + i, size, (bytes - i) / size);
+}
+#endif
+
+void swapBytes(void* array, size_t size, size_t n) {
+    auto* p = static_cast<char*>(array);
+#if defined(ECKIT_STREAM_SSSE3)
+    static const bool ssse3 = __builtin_cpu_supports("ssse3") != 0;
+    if (ssse3 && (size == 2 || size == 4 || size == 8)) {
+        return swapBytesSSSE3(p, size, n);
+    }
+#endif
+    swapBytesScalar(p, size, n);
+}
+
+}  // namespace
+
+void Stream::writeArray(char kind, size_t size, const void* array, size_t n) {
+    T("w array", n);
+    writeTag(tag_array);
+
+    putChar(static_cast<unsigned char>(kind));
+    putChar(static_cast<unsigned char>(size));
+    putChar(byteOrder);
+
+    unsigned long long len = n;
+    putLong(len >> 32);
+    putLong(len & 0xffffffff);
+
+    size_t bytes  = n * size;
+    long chunk    = 0x80000000;
+    const char* p = static_cast<const char*>(array);
+    while (bytes > 0) {
+        long l = bytes > size_t(chunk) ? chunk : bytes;
+        putBytes(p, l);
+        p += l;
+        bytes -= l;
+    }
+}
+
+void Stream::readArray(char kind, size_t size, void* array, size_t n) {
+    tag t;
+    while ((t = nextTag()) == tag_end_obj) {
+        ;
+    }
+
+    if (t == tag_blob || t == tag_large_blob) {
+        lastTag_ = t;
+        if (t == tag_blob) {
+            readBlob(array, n * size);
+        }
+        else {
+            readLargeBlob(array, n * size);
+        }
+        return;
+    }
+
+    if (t != tag_array) {
+        lastTag_ = t;
+        readTag(tag_array);  // n.b. throws
+    }
+
+    const auto k    = static_cast<char>(getChar());
+    const auto s    = static_cast<size_t>(getChar());
+    const auto swap = getChar() != byteOrder;
+
+    unsigned long long u1  = getLong();
+    unsigned long long u2  = getLong();
+    unsigned long long len = (u1 << 32) | u2;
+
+    if (k != kind || s != size || len != n) {
+        std::ostringstream os;
+        os << "Stream: expecting an array of " << n << " '" << kind << "' of size " << size << ", got " << len
+           << " '" << k << "' of size " << s << " in " << name();
+        throw BadValue(os.str());
+    }
+
+    size_t bytes = n * size;
+    long chunk   = 0x80000000;
+    char* p      = static_cast<char*>(array);
+    while (bytes > 0) {
+        long l = bytes > size_t(chunk) ? chunk : bytes;
+        getBytes(p, l);
+        p += l;
+        bytes -= l;
+    }
+
+    if (swap) {
+        swapBytes(array, size, n);
+    }
+
+    T("r array", n);
+}
+
 void Stream::rewind() {
     NOTIMP;
 }
@@ -14,8 +14,10 @@
 #ifndef eckit_Stream_h
 #define eckit_Stream_h
 
+#include <cstddef>
 #include <map>
 #include <string>
+#include <type_traits>
 
 #include "eckit/memory/NonCopyable.h"
 #include "eckit/thread/Mutex.h"
@@ -114,6 +116,21 @@ public:
     void writeLargeBlob(const void*, size_t);
     void readLargeBlob(void*, size_t);
 
+    /// Arrays of numbers, with a single tag, the kind and size of the elements, the byte order and the number of
+    /// elements, followed by the elements as they are in memory. The bytes are only swapped by a reader of the
+    /// other byte order.
+    template <typename T>
+    void writeArray(const T* array, size_t n) {
+        writeArray(arrayKind<T>(), sizeof(T), array, n);
+    }
+
+    /// Read an array of n numbers, of the kind and size written. Also reads (blob or large blob) arrays written in
+    /// the same byte order, as they were before arrays were typed.
+    template <typename T>
+    void readArray(T* array, size_t n) {
+        readArray(arrayKind<T>(), sizeof(T), array, n);
+    }
+
     virtual void rewind();
     virtual void closeOutput();
     virtual void closeInput();
@@ -169,6 +186,7 @@ private:
         tag_end_rec,
         tag_eof,
         tag_large_blob,  // For blobs >= 2Gb
+        tag_array,
         last_tag
     };
 
@@ -199,6 +217,15 @@ private:
     void getBytes(void*, long);
     void putBytes(const void*, long);
 
+    template <typename T>
+    static constexpr char arrayKind() {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Stream: arrays are of numbers");
+        return std::is_floating_point_v<T> ? 'f' : std::is_signed_v<T> ? 'i' : 'u';
+    }
+
+    void writeArray(char kind, size_t size, const void*, size_t n);
+    void readArray(char kind, size_t size, void*, size_t n);
+
     friend std::ostream& operator<<(std::ostream&, tag);
 
     friend class BufferedWriter<Stream>;
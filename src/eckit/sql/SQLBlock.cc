@@ -0,0 +1,135 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "eckit/sql/SQLBlock.h"
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/sql/SelectOneTable.h"
+
+namespace eckit::sql {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool ValueBlock::anyMissing() const {
+    for (uint64_t word : missing_) {
+        if (word) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ValueBlock::mergeMissing(const ValueBlock& other) {
+    ASSERT(other.missing_.size() == missing_.size());
+    for (size_t i = 0; i < missing_.size(); ++i) {
+        missing_[i] |= other.missing_[i];
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+SQLBlock::SQLBlock(size_t capacity) :
+    capacity_(capacity), size_(0), selected_(false) {
+    ASSERT(capacity_ > 0);
+}
+
+void SQLBlock::addColumn(ValueLookup& lookup) {
+    ASSERT(size_ == 0);
+    columns_.push_back(Column{lookup, lookup, ValueBlock()});
+    columns_.back().values_.resize(capacity_);
+}
+
+void SQLBlock::clear() {
+    for (Column& c : columns_) {
+        c.values_.clearMissing();
+    }
+    size_ = 0;
+}
+
+void SQLBlock::append(const SelectOneTable& table) {
+    ASSERT(size_ < capacity_);
+    ASSERT(!selected_);
+    ASSERT(table.values_.size() == columns_.size());
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        Column& c(columns_[i]);
+        c.values_[size_] = *c.lookup_.first;
+        if (table.isMissingValue(i)) {
+            c.values_.setMissing(size_);
+        }
+    }
+    size_++;
+}
+
+const ValueBlock* SQLBlock::column(const ValueLookup* lookup) const {
+    for (const Column& c : columns_) {
+        if (&c.lookup_ == lookup) {
+            return &c.values_;
+        }
+    }
+    return nullptr;
+}
+
+void SQLBlock::select(size_t row) const {
+    ASSERT(row < size_);
+    if (!selected_) {
+        // The table iterator may have moved its buffer since the block was filled, so save the lookups now
+        for (const Column& c : columns_) {
+            c.saved_ = c.lookup_;
+        }
+        selected_ = true;
+    }
+    for (const Column& c : columns_) {
+        c.lookup_.first  = c.values_.data() + row;
+        c.lookup_.second = c.values_.missing(row);
+    }
+}
+
+void SQLBlock::restore() const {
+    if (selected_) {
+        for (const Column& c : columns_) {
+            c.lookup_ = c.saved_;
+        }
+        selected_ = false;
+    }
+}
+
+void SQLBlock::filter(const ValueBlock& condition) {
+    ASSERT(condition.size() == size_);
+
+    size_t kept = 0;
+    for (size_t row = 0; row < size_; ++row) {
+        if (condition[row] && !condition.missing(row)) {
+            if (kept != row) {
+                for (Column& c : columns_) {
+                    ValueBlock& v(c.values_);
+                    v[kept] = v[row];
+                    uint64_t& word = v.bitmap()[kept / 64];
+                    uint64_t bit   = uint64_t(1) << (kept % 64);
+                    word           = v.missing(row) ? (word | bit) : (word & ~bit);
+                }
+            }
+            kept++;
+        }
+    }
+
+    // Rows past the end must not be seen as missing when the block is refilled
+    for (Column& c : columns_) {
+        ValueBlock& v(c.values_);
+        for (size_t row = kept; row < size_; ++row) {
+            v.bitmap()[row / 64] &= ~(uint64_t(1) << (row % 64));
+        }
+    }
+
+    size_ = kept;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::sql
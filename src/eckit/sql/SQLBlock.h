@@ -0,0 +1,119 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#ifndef eckit_sql_SQLBlock_H
+#define eckit_sql_SQLBlock_H
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace eckit::sql {
+
+struct SelectOneTable;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// The values of an expression for a block of rows, with a bitmap flagging the missing ones.
+/// The value of a missing row is unspecified.
+
+class ValueBlock {
+public:
+    ValueBlock() = default;
+
+    /// Resizes the block, and clears the bitmap
+    void resize(size_t n) {
+        values_.resize(n);
+        missing_.assign((n + 63) / 64, 0);
+    }
+
+    size_t size() const { return values_.size(); }
+
+    double* data() { return values_.data(); }
+    const double* data() const { return values_.data(); }
+
+    double& operator[](size_t i) { return values_[i]; }
+    double operator[](size_t i) const { return values_[i]; }
+
+    bool missing(size_t i) const { return (missing_[i / 64] >> (i % 64)) & 1; }
+    void setMissing(size_t i) { missing_[i / 64] |= uint64_t(1) << (i % 64); }
+    void clearMissing() { missing_.assign(missing_.size(), 0); }
+    bool anyMissing() const;
+
+    /// One bit per row, 64 rows per word
+    uint64_t* bitmap() { return missing_.data(); }
+    const uint64_t* bitmap() const { return missing_.data(); }
+    size_t bitmapWords() const { return missing_.size(); }
+
+    /// Flags as missing the rows missing in other, which must be of the same size
+    void mergeMissing(const ValueBlock& other);
+
+private:
+    std::vector<double> values_;
+    std::vector<uint64_t> missing_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// A block of rows read from one table, stored column by column, for SQLExpression::evalBlock().
+///
+/// Only columns holding one double per row can be buffered. The block is bound to the (value, missing) pairs
+/// through which SQLSelect exposes the current row to the expressions, select() points them at one row of the
+/// block so that expressions without a block implementation can still be evaluated one row at a time.
+
+class SQLBlock {
+public:
+    typedef std::pair<const double*, bool> ValueLookup;
+
+    explicit SQLBlock(size_t capacity);
+
+    void addColumn(ValueLookup&);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool full() const { return size_ == capacity_; }
+
+    void clear();
+
+    /// Copies the current row, as exposed through the lookups. The columns must have been added in the order
+    /// they are fetched from the table, which knows their missing values.
+    void append(const SelectOneTable&);
+
+    /// The values of a column of the block, nullptr if the lookup is not buffered
+    const ValueBlock* column(const ValueLookup*) const;
+
+    /// Makes a row of the block the current row for eval(bool&)
+    void select(size_t row) const;
+
+    /// Points the lookups back to where they were before select()
+    void restore() const;
+
+    /// Only keeps the rows for which the condition is true and not missing
+    void filter(const ValueBlock& condition);
+
+private:
+    struct Column {
+        ValueLookup& lookup_;
+        mutable ValueLookup saved_;
+        ValueBlock values_;
+    };
+
+    std::vector<Column> columns_;
+    size_t capacity_;
+    size_t size_;
+    mutable bool selected_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::sql
+
+#endif
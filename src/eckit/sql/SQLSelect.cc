@@ -13,8 +13,10 @@
 #include <algorithm>
 
 #include "eckit/config/LibEcKit.h"
+#include "eckit/config/Resource.h"
 #include "eckit/log/BigNum.h"
 #include "eckit/log/Log.h"
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/SQLColumn.h"
 #include "eckit/sql/SQLDatabase.h"
 #include "eckit/sql/SQLOutput.h"
@@ -24,6 +26,9 @@
 #include "eckit/sql/expression/OrderByExpressions.h"
 #include "eckit/sql/expression/SQLExpressionEvaluated.h"
 #include "eckit/sql/expression/SQLExpressions.h"
+#include "eckit/thread/AutoLock.h"
+#include "eckit/thread/ParallelFor.h"
+#include "eckit/thread/StaticMutex.h"
 
 namespace eckit::sql {
 
@@ -45,7 +50,11 @@ SQLSelect::SQLSelect(const Expressions& columns, const std::vector<std::referenc
     skips_(0),
     aggregate_(false),
     mixedAggregatedAndScalar_(false),
-    doOutputCached_(false) {
+    doOutputCached_(false),
+    blockable_(false),
+    scanned_(false),
+    matched_(false),
+    partition_(-1) {
     // TODO: Convert tables_, allTables_ to use references rather than pointers.
     for (const SQLTable& t : tables) {
         tables_.push_back(&t);
@@ -126,6 +135,41 @@ const type::SQLType* SQLSelect::typeOf(const std::string& name, const SQLTable*
     return type.subType(name);  // This should take care of bitfields
 }
 
+/// Number of rows evaluated at once by processBlocks(), 0 to evaluate one row at a time
+static size_t blockSize() {
+    static size_t size = Resource<size_t>("sqlBlockSize;$ECKIT_SQL_BLOCK_SIZE", 1024);
+    return size;
+}
+
+/// Number of threads reading the partitions of a table, 0 for as many as the workers (see parallelFor)
+static size_t threads() {
+    static size_t n = Resource<size_t>("sqlThreads;$ECKIT_SQL_THREADS", 0);
+    return n;
+}
+
+/// Guards the columns of the tables, which are updated by the selects reading them
+static StaticMutex tablesMutex;
+
+namespace {
+
+/// The output of the selects reading one partition of a table, whose results are merged instead
+class PartitionOutput : public SQLOutput {
+    void prepare(SQLSelect&) override {}
+    void cleanup(SQLSelect&) override {}
+    void reset() override {}
+    void flush() override {}
+    bool output(const expression::Expressions&) override { return false; }
+    void outputReal(double, bool) override { NOTIMP; }
+    void outputDouble(double, bool) override { NOTIMP; }
+    void outputInt(double, bool) override { NOTIMP; }
+    void outputUnsignedInt(double, bool) override { NOTIMP; }
+    void outputString(const char*, size_t, bool) override { NOTIMP; }
+    void outputBitfield(double, bool) override { NOTIMP; }
+    unsigned long long count() override { return 0; }
+};
+
+}  // namespace
+
 static bool compareTables(SelectOneTable* a, SelectOneTable* b) {
     // #if 1
     //	if(&(a->table_->owner()) != &(b->table_->owner()))
@@ -182,8 +226,9 @@ void SQLSelect::prepareExecute() {
         // n.b. tablePair.first is only const to enable other functions to be const. But
         //      it belongs to this structure, and we are a non-const fn, so this is ok.
         SQLTable* sqlTable = const_cast<SQLTable*>(tablePair.first);
-        cursors_.emplace_back(tbl.table_->iterator(
-            tbl.fetch_, [this, sqlTable](SQLTableIterator& cursor) { refreshCursorMetadata(sqlTable, cursor); }));
+        auto callback = [this, sqlTable](SQLTableIterator& cursor) { refreshCursorMetadata(sqlTable, cursor); };
+        cursors_.emplace_back(partition_ < 0 ? tbl.table_->iterator(tbl.fetch_, callback)
+                                             : tbl.table_->partitionIterator(partition_, tbl.fetch_, callback));
         cursors_.back()->rewind();
 
         refreshCursorMetadata(sqlTable, *cursors_.back());
@@ -442,6 +487,12 @@ void SQLSelect::postExecute() {
 
 void SQLSelect::refreshCursorMetadata(SQLTable* table, SQLTableIterator& cursor) {
 
+    // The rows already buffered must be evaluated with the metadata they were read with
+
+    if (block_ && block_->size()) {
+        processBlock();
+    }
+
     auto it = tablesToFetch_.find(table);
 
     ASSERT(it != tablesToFetch_.end());
@@ -453,6 +504,15 @@ void SQLSelect::refreshCursorMetadata(SQLTable* table, SQLTableIterator& cursor)
     const std::vector<char> hasMissing(cursor.columnsHaveMissing());
     const std::vector<double> missingValues(cursor.missingValues());
 
+    tbl.hasMissing_    = hasMissing;
+    tbl.missingValues_ = missingValues;
+
+    // The selects reading the partitions of a table concurrently update the same columns
+
+    AutoLock<StaticMutex> lock(tablesMutex);
+
+    blockable_ = std::all_of(doublesSizes.begin(), doublesSizes.end(), [](size_t n) { return n == 1; });
+
     for (size_t i = 0; i < tbl.fetch_.size(); i++) {
         std::string fullname(tbl.fetch_[i].get().fullName());
 
@@ -491,6 +551,10 @@ void SQLSelect::reset() {
     aggregate_                = false;
     mixedAggregatedAndScalar_ = false;
     doOutputCached_           = false;
+    blockable_                = false;
+    scanned_                  = false;
+    matched_                  = false;
+    block_.reset();
 
     aggregated_.clear();
     nonAggregated_.clear();
@@ -518,47 +582,52 @@ bool SQLSelect::writeOutput() {
     std::shared_ptr<SQLExpression>& where(simplifiedWhere_);
     // if (where) Log::info() << "SQLSelect::output: where: " << *where << std::endl;
 
-    bool newRow  = false;
     bool missing = false;
     double value;
     if (!where || (((value = where->eval(missing)) || !value)  // !value for the 'WHERE 0' case, ODB-106
                    && !missing)) {
-        if (!aggregate_) {
-            newRow = resultsOut();
-        }
-        else {
-            size_t n = select_.size();
-            if (!mixedAggregatedAndScalar_) {
-                for (size_t i = 0; i < n; i++) {
-                    select_[i]->partialResult();
-                }
-            }
-            else {
+        return outputRow();
+    }
+    return false;
+}
 
-                // For each set of non-aggregated values, keep track of the aggregated values
-                // n.b. newRow=false, as we are accumulating the values
 
-                OrderByExpressions nonAggregatedValues;
-                for (size_t i = 0; i < nonAggregated_.size(); ++i) {
-                    nonAggregatedValues.emplace_back(std::make_shared<SQLExpressionEvaluated>(*nonAggregated_[i]));
-                }
+bool SQLSelect::outputRow() {
 
-                AggregatedResults::iterator results = aggregatedResults_.find(nonAggregatedValues);
-                if (results == aggregatedResults_.end()) {
-                    Expressions& aggregated = aggregatedResults_[nonAggregatedValues];
-                    for (const auto& expr : aggregated_) {
-                        aggregated.emplace_back(expr->clone());
-                    }
-                }
+    if (!aggregate_) {
+        return resultsOut();
+    }
 
-                Expressions& aggregated = aggregatedResults_[nonAggregatedValues];
-                for (size_t i = 0; i < aggregated.size(); ++i) {
-                    aggregated[i]->partialResult();
-                }
+    size_t n = select_.size();
+    if (!mixedAggregatedAndScalar_) {
+        for (size_t i = 0; i < n; i++) {
+            select_[i]->partialResult();
+        }
+    }
+    else {
+
+        // For each set of non-aggregated values, keep track of the aggregated values
+        // n.b. newRow=false, as we are accumulating the values
+
+        OrderByExpressions nonAggregatedValues;
+        for (size_t i = 0; i < nonAggregated_.size(); ++i) {
+            nonAggregatedValues.emplace_back(std::make_shared<SQLExpressionEvaluated>(*nonAggregated_[i]));
+        }
+
+        AggregatedResults::iterator results = aggregatedResults_.find(nonAggregatedValues);
+        if (results == aggregatedResults_.end()) {
+            Expressions& aggregated = aggregatedResults_[nonAggregatedValues];
+            for (const auto& expr : aggregated_) {
+                aggregated.emplace_back(expr->clone());
             }
         }
+
+        Expressions& aggregated = aggregatedResults_[nonAggregatedValues];
+        for (size_t i = 0; i < aggregated.size(); ++i) {
+            aggregated[i]->partialResult();
+        }
     }
-    return newRow;
+    return false;
 }
 
 
@@ -567,6 +636,15 @@ unsigned long long SQLSelect::process() {
     ASSERT(cursors_.size() != 0);
     ASSERT(count_ == 0);
 
+    if (usePartitions()) {
+        if (!processPartitions()) {
+            return count_;
+        }
+    }
+    else if (useBlocks() && !processBlocks()) {
+        return count_;
+    }
+
     while (processOneRow()) {
         /* Intentionally blank */;
     }
@@ -588,36 +666,247 @@ bool SQLSelect::processNextTableRow(size_t tableIndex) {
 
     while (cursors_[tableIndex]->next()) {
 
-        // Extract the missing values
+        if (checkRow(fetchTable)) {
+            return true;
+        }
+
+        skips_++;
+        total_++;
+    }
 
-        for (size_t i = 0; i < fetchTable.fetch_.size(); i++) {
-            fetchTable.values_[i]->second = fetchTable.fetch_[i].get().isMissingValue(fetchTable.values_[i]->first);
+    // If no row was found, then ensure total_ was not incremented.
+    total_--;
+
+    return false;
+}
+
+
+bool SQLSelect::checkRow(SelectOneTable& fetchTable) {
+
+    // Extract the missing values
+
+    for (size_t i = 0; i < fetchTable.fetch_.size(); i++) {
+        fetchTable.values_[i]->second = fetchTable.isMissingValue(i);
+    }
+
+    // Test the returned row against the validation conditions.
+
+    for (auto& check : fetchTable.check_) {
+        bool missing = false;
+        if (!check->eval(missing) || missing) {
+            return false;
         }
+    }
 
-        // Test thereturned row against the validation conditions.
+    return true;
+}
 
-        bool ok = true;
 
-        for (auto& check : fetchTable.check_) {
-            bool missing = false;
-            if (!check->eval(missing) || missing) {
-                ok = false;
-                break;
+bool SQLSelect::useBlocks() const {
+
+    // Joins, and expressions that depend on the order the rows are processed in, are evaluated one row at a time
+
+    if (blockSize() == 0 || !blockable_ || cursors_.size() != 1 || sortedTables_.size() != 1) {
+        return false;
+    }
+
+    auto stateful = [](const std::shared_ptr<SQLExpression>& e) { return e && e->isStateful(); };
+
+    return std::none_of(select_.begin(), select_.end(), stateful) && !stateful(simplifiedWhere_)
+           && std::none_of(sortedTables_[0]->check_.begin(), sortedTables_[0]->check_.end(), stateful);
+}
+
+
+bool SQLSelect::processBlocks() {
+
+    /// Reads the whole table a block of rows at a time. The WHERE conditions filter the block column-wise,
+    /// and (non-mixed) aggregates consume it at once. Returns false if no row matched.
+
+    SelectOneTable& fetchTable(*sortedTables_[0]);
+    SQLTableIterator& cursor(*cursors_[0]);
+
+    block_.reset(new SQLBlock(blockSize()));
+    for (size_t i = 0; i < fetchTable.fetch_.size(); i++) {
+        block_->addColumn(*fetchTable.values_[i]);
+    }
+
+    scanned_ = true;
+    matched_ = false;
+
+    bool more = true;
+    while (more) {
+        while (!block_->full() && (more = cursor.next()) && blockable_) {
+            block_->append(fetchTable);
+        }
+
+        processBlock();
+
+        if (more && !blockable_) {
+
+            // The cursor now returns columns wider than a double (e.g. longer strings). Carry on
+            // one row at a time, starting with the row it is on.
+
+            total_++;
+            if (checkRow(fetchTable)) {
+                matched_ = true;
+                if (writeOutput()) {
+                    count_++;
+                }
+            }
+            else {
+                skips_++;
+            }
+
+            while (processNextTableRow(0)) {
+                matched_ = true;
+                if (writeOutput()) {
+                    count_++;
+                }
             }
+            break;
         }
+    }
 
-        if (ok) {
-            return true;
+    block_.reset();
+
+    Log::debug<LibEcKit>() << "SQLSelect::processBlocks: " << BigNum(total_) << " row(s) read" << std::endl;
+
+    return matched_;
+}
+
+
+void SQLSelect::processBlock() {
+
+    SQLBlock& block(*block_);
+    size_t rows = block.size();
+    total_ += rows;
+
+    ValueBlock condition;
+    for (auto& check : sortedTables_[0]->check_) {
+        if (block.size() == 0) {
+            break;
         }
+        check->evalBlock(block, condition);
+        block.filter(condition);
+    }
 
-        skips_++;
-        total_++;
+    skips_ += rows - block.size();
+
+    if (block.size() != 0) {
+        matched_ = true;
+
+        if (aggregate_ && !mixedAggregatedAndScalar_) {
+            for (auto& e : select_) {
+                e->partialResultBlock(block);
+            }
+        }
+        else {
+            for (size_t i = 0; i < block.size(); ++i) {
+                block.select(i);
+                if (outputRow()) {
+                    count_++;
+                }
+            }
+            block.restore();
+        }
     }
 
-    // If no row was found, then ensure total_ was not incremented.
-    total_--;
+    block.clear();
+}
 
-    return false;
+
+bool SQLSelect::usePartitions() const {
+
+    // Only aggregates whose partial results can be merged are computed part by part. The other results
+    // depend on the order of the rows.
+
+    if (partition_ >= 0 || !aggregate_ || mixedAggregatedAndScalar_ || cursors_.size() != 1
+        || sortedTables_.size() != 1 || sortedTables_[0]->table_->partitions() < 2) {
+        return false;
+    }
+
+    auto stateful  = [](const std::shared_ptr<SQLExpression>& e) { return e && e->isStateful(); };
+    auto mergeable = [](const std::shared_ptr<SQLExpression>& e) { return e->canMergePartialResults(); };
+
+    return std::all_of(select_.begin(), select_.end(), mergeable)
+           && std::none_of(select_.begin(), select_.end(), stateful) && !stateful(simplifiedWhere_);
+}
+
+
+bool SQLSelect::processPartitions() {
+
+    /// Each partition of the table is read by a select of its own, with its own copy of the expressions, in
+    /// parallel. Their partial aggregates are then merged into ours. Returns false if no row matched.
+
+    const SQLTable& table(*sortedTables_[0]->table_);
+    size_t partitions = table.partitions();
+
+    PartitionOutput discard;
+    std::vector<std::unique_ptr<SQLSelect>> parts;
+
+    // n.b. preparing binds the expressions to the columns of the table, one select at a time
+
+    for (size_t i = 0; i < partitions; ++i) {
+        Expressions select;
+        for (const auto& e : select_) {
+            select.push_back(e->deepClone());
+        }
+        std::shared_ptr<SQLExpression> where(simplifiedWhere_ ? simplifiedWhere_->deepClone() : nullptr);
+
+        parts.emplace_back(new SQLSelect(select, {table}, where, discard));
+        parts.back()->partition_ = i;
+        parts.back()->prepareExecute();
+    }
+
+    {
+        parallelFor(partitions, 1, threads(), [&parts](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                parts[i]->scanPartition();
+            }
+        });
+    }
+
+    scanned_ = true;
+    matched_ = false;
+
+    for (auto& part : parts) {
+        total_ += part->total_;
+        skips_ += part->skips_;
+
+        if (part->matched_) {
+            matched_ = true;
+            ASSERT(part->select_.size() == select_.size());
+            for (size_t i = 0; i < select_.size(); ++i) {
+                select_[i]->mergePartialResult(*part->select_[i]);
+            }
+        }
+
+        part->postExecute();
+    }
+
+    Log::debug<LibEcKit>() << "SQLSelect::processPartitions: " << BigNum(total_) << " row(s) read from "
+                           << partitions << " partition(s)" << std::endl;
+
+    return matched_;
+}
+
+
+void SQLSelect::scanPartition() {
+
+    ASSERT(partition_ >= 0);
+
+    if (useBlocks()) {
+        processBlocks();
+        return;
+    }
+
+    scanned_ = true;
+    matched_ = false;
+
+    while (processNextTableRow(0)) {
+        matched_ = true;
+        writeOutput();
+    }
 }
 
 
@@ -641,7 +930,7 @@ bool SQLSelect::processOneRow() {
 
     // If this is the first retrieve, we need to initialise all tables
 
-    if (count_ == 0) {
+    if (count_ == 0 && !scanned_) {
         for (size_t idx = 0; idx < cursors_.size(); idx++) {
             if (!processNextTableRow(idx)) {
                 return false;  // If false, there is no data
@@ -659,7 +948,7 @@ bool SQLSelect::processOneRow() {
     // and increment the second, and continue until we have enumerated all possible combinations
     // of valid data across the tables.
 
-    if (!mixedAggregatedAndScalar_ || aggregatedResultsIterator_ == aggregatedResults_.end()) {
+    if (!scanned_ && (!mixedAggregatedAndScalar_ || aggregatedResultsIterator_ == aggregatedResults_.end())) {
 
         for (size_t idx = 0; idx < cursors_.size(); idx++) {
 
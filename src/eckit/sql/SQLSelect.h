@@ -27,6 +27,7 @@
 #include "eckit/sql/expression/OrderByExpressions.h"
 
 namespace eckit::sql {
+class SQLBlock;
 class SQLTableIterator;
 namespace expression::function {
 class FunctionROWNUMBER;
@@ -120,6 +121,11 @@ private:
     bool aggregate_;
     bool mixedAggregatedAndScalar_;
     bool doOutputCached_;
+    bool blockable_;  ///< All the fetched columns hold one double per row
+    bool scanned_;    ///< All the rows have been read by processBlocks()
+    bool matched_;    ///< At least one row has matched in processBlocks()
+    std::unique_ptr<SQLBlock> block_;
+    int partition_;  ///< The part of the table read by this select, -1 for the whole table
     Expressions aggregated_;
     Expressions nonAggregated_;
     std::vector<bool> mixedResultColumnIsAggregated_;
@@ -130,9 +136,19 @@ private:
     void reset();
     bool resultsOut();
     bool writeOutput();
+    bool outputRow();
     std::shared_ptr<SQLExpression> findAliasedExpression(const std::string& alias);
 
     bool processNextTableRow(size_t tableIndex);
+    bool checkRow(SelectOneTable&);
+
+    bool useBlocks() const;
+    bool processBlocks();
+    void processBlock();
+
+    bool usePartitions() const;
+    bool processPartitions();
+    void scanPartition();
 
     friend class expression::function::FunctionROWNUMBER;  // needs access to count_
     friend class expression::function::FunctionTHIN;       // needs access to count_
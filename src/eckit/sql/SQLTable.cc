@@ -196,6 +196,13 @@ void SQLTable::updateColumnMissingValues(const std::string& name, bool hasMissin
     j->second->missingValue(missingValue);
 }
 
+SQLTableIterator* SQLTable::partitionIterator(size_t partition,
+                                             const std::vector<std::reference_wrapper<const SQLColumn>>& columns,
+                                             std::function<void(SQLTableIterator&)> metadataUpdateCallback) const {
+    ASSERT(partition == 0);
+    return iterator(columns, metadataUpdateCallback);
+}
+
 void SQLTable::addLinkFrom(const SQLTable& from) {
     linksFrom_.insert(from);
 }
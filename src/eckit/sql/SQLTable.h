@@ -87,6 +87,15 @@ public:
                                        std::function<void(SQLTableIterator&)> metadataUpdateCallback) const
         = 0;
 
+    /// The number of parts of the table that can be read independently. SQLSelect reads them concurrently
+    /// when computing aggregates, so the iterators over different parts must not share any state.
+    virtual size_t partitions() const { return 1; }
+
+    /// Iterates over the rows of one part of the table, 0 <= partition < partitions()
+    virtual SQLTableIterator* partitionIterator(size_t partition,
+                                                const std::vector<std::reference_wrapper<const SQLColumn>>&,
+                                                std::function<void(SQLTableIterator&)> metadataUpdateCallback) const;
+
 protected:
     std::string path_;
     std::string name_;
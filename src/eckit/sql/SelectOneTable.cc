@@ -11,6 +11,9 @@
 
 #include "eckit/sql/SelectOneTable.h"
 
+#include <cstdint>
+#include <cstring>
+
 namespace eckit::sql {
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -22,6 +25,18 @@ SelectOneTable::SelectOneTable(const SQLTable* table) :
 
 SelectOneTable::~SelectOneTable() {}
 
+bool SelectOneTable::isMissingValue(size_t i) const {
+    if (!hasMissing_[i]) {
+        return false;
+    }
+    // n.b. compare the bit patterns, as in SQLColumn::isMissingValue
+    uint64_t value;
+    uint64_t missing;
+    std::memcpy(&value, values_[i]->first, sizeof(value));
+    std::memcpy(&missing, &missingValues_[i], sizeof(missing));
+    return value == missing;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::sql
@@ -41,6 +41,15 @@ struct SelectOneTable {
     // How do we find the data inside the allocated buffer in SQLSelect?
     //    std::vector<size_t> fetchSizeDoubles_;
 
+    // Missing values of the fetched columns, as last reported by the cursor. n.b. these are not read back from
+    // the SQLColumns, which are shared with the other selects reading the table (possibly concurrently)
+
+    std::vector<char> hasMissing_;
+    std::vector<double> missingValues_;
+
+    /// Whether the current value of the i-th fetched column is missing
+    bool isMissingValue(size_t i) const;
+
     Expressions check_;
     Expressions index_;
 
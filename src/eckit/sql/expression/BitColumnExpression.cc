@@ -14,6 +14,7 @@
 
 #include "eckit/filesystem/PathName.h"
 #include "eckit/os/BackTrace.h"
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/SQLColumn.h"
 #include "eckit/sql/SQLSelect.h"
 #include "eckit/sql/SQLTable.h"
@@ -95,6 +96,15 @@ double BitColumnExpression::eval(bool& missing) const {
     return (x & mask_) >> bitShift_;
 }
 
+void BitColumnExpression::evalBlock(const SQLBlock& block, ValueBlock& out) const {
+    ColumnExpression::evalBlock(block, out);
+    double* v = out.data();
+    for (size_t i = 0; i < out.size(); ++i) {
+        unsigned long x = static_cast<unsigned long>(v[i]);
+        v[i]            = (x & mask_) >> bitShift_;
+    }
+}
+
 void BitColumnExpression::expandStars(const std::vector<std::reference_wrapper<const SQLTable>>& tables,
                                       expression::Expressions& e) {
     using namespace eckit;
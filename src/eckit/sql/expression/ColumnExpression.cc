@@ -13,6 +13,7 @@
 #include <cstring>
 #include <ostream>
 
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/SQLColumn.h"
 #include "eckit/sql/SQLSelect.h"
 #include "eckit/sql/SQLTable.h"
@@ -69,6 +70,18 @@ void ColumnExpression::eval(double* out, bool& missing) const {
     ::memcpy(out, value_->first, type_->size());
 }
 
+void ColumnExpression::evalBlock(const SQLBlock& block, ValueBlock& out) const {
+    const ValueBlock* values = block.column(value_);
+    if (!values) {
+        SQLExpression::evalBlock(block, out);
+        return;
+    }
+
+    out.resize(block.size());
+    ::memcpy(out.data(), values->data(), block.size() * sizeof(double));
+    ::memcpy(out.bitmap(), values->bitmap(), out.bitmapWords() * sizeof(uint64_t));
+}
+
 std::string ColumnExpression::evalAsString(bool& missing) const {
     if (value_->second) {
         missing = true;
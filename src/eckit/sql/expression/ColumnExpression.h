@@ -63,6 +63,7 @@ protected:
     void cleanup(SQLSelect& sql) override;
     double eval(bool& missing) const override;
     void eval(double* out, bool& missing) const override;
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override;
     std::string evalAsString(bool& missing) const override;
     bool isConstant() const override { return false; }
     void output(SQLOutput& s) const override;
@@ -10,6 +10,10 @@
 
 #include "eckit/sql/expression/ConstantExpression.h"
 
+#include <algorithm>
+
+#include "eckit/sql/SQLBlock.h"
+
 namespace eckit::sql::expression {
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -28,6 +32,16 @@ ConstantExpression::ConstantExpression(const ConstantExpression& rhs, const Cons
 
 ConstantExpression::~ConstantExpression() {}
 
+void ConstantExpression::evalBlock(const SQLBlock& block, ValueBlock& out) const {
+    out.resize(block.size());
+    std::fill(out.data(), out.data() + out.size(), value_);
+    if (missing_) {
+        for (size_t i = 0; i < out.size(); ++i) {
+            out.setMissing(i);
+        }
+    }
+}
+
 void ConstantExpression::output(SQLOutput& o) const {
     type_.output(o, value_, missing_);
 }
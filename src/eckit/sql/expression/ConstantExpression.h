@@ -48,6 +48,8 @@ public:
         return value_;
     }
 
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override;
+
     bool isConstant() const override { return true; }
     bool isNumber() const override { NOTIMP; }
 
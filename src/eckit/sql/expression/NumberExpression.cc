@@ -10,8 +10,11 @@
 
 #include "eckit/sql/expression/NumberExpression.h"
 
+#include <algorithm>
 #include <ostream>
 
+#include "eckit/sql/SQLBlock.h"
+
 namespace eckit::sql::expression {
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -40,6 +43,11 @@ double NumberExpression::eval(bool& missing) const {
     return value_;
 }
 
+void NumberExpression::evalBlock(const SQLBlock& block, ValueBlock& out) const {
+    out.resize(block.size());
+    std::fill(out.data(), out.data() + out.size(), value_);
+}
+
 void NumberExpression::prepare(SQLSelect& sql) {}
 
 void NumberExpression::cleanup(SQLSelect& sql) {}
@@ -45,6 +45,7 @@ private:
 
     const type::SQLType* type() const override;
     double eval(bool& missing) const override;
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override;
     bool isConstant() const override { return true; }
     bool isNumber() const override { return true; }
 };
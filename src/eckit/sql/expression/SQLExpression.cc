@@ -12,6 +12,7 @@
 
 #include "eckit/config/LibEcKit.h"
 #include "eckit/exception/Exceptions.h"
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/SQLOutput.h"
 #include "eckit/sql/expression/NumberExpression.h"
 #include "eckit/sql/expression/SQLExpressions.h"
@@ -35,6 +36,31 @@ void SQLExpression::eval(double* out, bool& missing) const {
     *out = eval(missing);
 }
 
+void SQLExpression::evalBlock(const SQLBlock& block, ValueBlock& out) const {
+    out.resize(block.size());
+    for (size_t i = 0; i < block.size(); ++i) {
+        block.select(i);
+        bool missing = false;
+        out[i]       = eval(missing);
+        if (missing) {
+            out.setMissing(i);
+        }
+    }
+    block.restore();
+}
+
+void SQLExpression::partialResultBlock(const SQLBlock& block) {
+    for (size_t i = 0; i < block.size(); ++i) {
+        block.select(i);
+        partialResult();
+    }
+    block.restore();
+}
+
+void SQLExpression::mergePartialResult(const SQLExpression&) {
+    NOTIMP;
+}
+
 std::shared_ptr<SQLExpression> SQLExpression::number(double value) {
     return std::make_shared<NumberExpression>(value);
 }
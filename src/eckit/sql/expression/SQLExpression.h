@@ -23,9 +23,11 @@
 namespace eckit::sql {
 // Forward declarations
 
+class SQLBlock;
 class SQLSelect;
 class SQLTable;
 class SQLOutput;
+class ValueBlock;
 
 namespace expression {
 
@@ -54,6 +56,16 @@ public:
     virtual void eval(double* out, bool& missing) const;
     virtual std::string evalAsString(bool& missing) const;
 
+    // Evaluates all the rows of a block at once. The default implementation selects the rows one
+    // after the other and calls eval(bool&), so it is only worth overriding where the work can be
+    // done column-wise.
+
+    virtual void evalBlock(const SQLBlock&, ValueBlock& out) const;
+
+    /// Whether the value depends on more than the current row (e.g. on the rows already seen or output),
+    /// in which case the rows must be evaluated in order, one at a time
+    virtual bool isStateful() const { return false; }
+
     virtual bool andSplit(expression::Expressions&) { return false; }
     virtual void tables(std::set<const SQLTable*>&) {}
 
@@ -71,11 +83,22 @@ public:
     virtual std::shared_ptr<SQLExpression> clone() const                     = 0;
     virtual std::shared_ptr<SQLExpression> reshift(int minColumnShift) const = 0;
 
+    /// A copy sharing no sub-expression with this one (clone() may share them), so that both can be
+    /// prepared and evaluated independently
+    virtual std::shared_ptr<SQLExpression> deepClone() const { return clone(); }
+
     virtual bool isAggregate() const { return false; }
     // For select expression
 
     virtual void output(SQLOutput&) const;
     virtual void partialResult() {}
+    virtual void partialResultBlock(const SQLBlock&);
+
+    /// Whether mergePartialResult() is implemented, i.e. whether the aggregate can be computed over
+    /// separate sets of rows and the results combined
+    virtual bool canMergePartialResults() const { return false; }
+    /// Adds the rows accumulated by a deepClone() of this expression to the partial result
+    virtual void mergePartialResult(const SQLExpression&);
     virtual void expandStars(const std::vector<std::reference_wrapper<const SQLTable>>&, expression::Expressions&);
 
     virtual bool isBitfield() const { return isBitfield_; }
@@ -68,6 +68,10 @@ protected:
     double eval(bool& missing) const override;
     void output(SQLOutput& s) const override;
 
+    // The values of the previous rows are kept as the rows are evaluated
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override { SQLExpression::evalBlock(block, out); }
+    bool isStateful() const override { return true; }
+
 private:
     ShiftedColumnExpression& operator=(const ShiftedColumnExpression&);
 
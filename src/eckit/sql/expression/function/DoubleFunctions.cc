@@ -9,6 +9,7 @@
  */
 
 
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/expression/function/FunctionFactory.h"
 
 #include <float.h>
@@ -26,6 +27,28 @@ class ArityFunction : public FunctionExpression {
 public:
     using FunctionExpression::FunctionExpression;
     static int arity() { return ARITY; }
+
+protected:
+    /// Evaluates the arguments for a block of rows, and flags in out the rows where any of them is missing
+    void evalArgs(const SQLBlock& block, ValueBlock (&args)[ARITY], ValueBlock& out) const {
+        out.resize(block.size());
+        for (int i = 0; i < ARITY; ++i) {
+            this->args_[i]->evalBlock(block, args[i]);
+            out.mergeMissing(args[i]);
+        }
+    }
+
+    /// As eval(), the result is the missing value where an argument is missing
+    void setMissingValues(ValueBlock& out) const {
+        if (!out.anyMissing()) {
+            return;
+        }
+        for (size_t i = 0; i < out.size(); ++i) {
+            if (out.missing(i)) {
+                out[i] = this->missingValue_;
+            }
+        }
+    }
 };
 
 
@@ -42,6 +65,19 @@ class UnaryFunction : public ArityFunction<UnaryFunction<FN>, 1> {
         return FN(a0);
     }
 
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override {
+        ValueBlock a[1];
+        this->evalArgs(block, a, out);
+
+        const double* a0 = a[0].data();
+        double* r        = out.data();
+        for (size_t i = 0; i < out.size(); ++i) {
+            r[i] = FN(a0[i]);
+        }
+
+        this->setMissingValues(out);
+    }
+
 public:
     using ArityFunction<UnaryFunction<FN>, 1>::ArityFunction;
 };
@@ -63,6 +99,20 @@ class BinaryFunction : public ArityFunction<BinaryFunction<FN>, 2> {
         return FN(a0, a1);
     }
 
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override {
+        ValueBlock a[2];
+        this->evalArgs(block, a, out);
+
+        const double* a0 = a[0].data();
+        const double* a1 = a[1].data();
+        double* r        = out.data();
+        for (size_t i = 0; i < out.size(); ++i) {
+            r[i] = FN(a0[i], a1[i]);
+        }
+
+        this->setMissingValues(out);
+    }
+
 public:
     using ArityFunction<BinaryFunction<FN>, 2>::ArityFunction;
 };
@@ -88,6 +138,17 @@ class TertiaryFunction : public ArityFunction<TertiaryFunction<FN>, 3> {
         return FN(a0, a1, a2);
     }
 
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override {
+        ValueBlock a[3];
+        this->evalArgs(block, a, out);
+
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = FN(a[0][i], a[1][i], a[2][i]);
+        }
+
+        this->setMissingValues(out);
+    }
+
 public:
     using ArityFunction<TertiaryFunction<FN>, 3>::ArityFunction;
 };
@@ -117,6 +178,17 @@ class QuaternaryFunction : public ArityFunction<QuaternaryFunction<FN>, 4> {
         return FN(a0, a1, a2, a3);
     }
 
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override {
+        ValueBlock a[4];
+        this->evalArgs(block, a, out);
+
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = FN(a[0][i], a[1][i], a[2][i], a[3][i]);
+        }
+
+        this->setMissingValues(out);
+    }
+
 public:
     using ArityFunction<QuaternaryFunction<FN>, 4>::ArityFunction;
 };
@@ -150,6 +222,17 @@ class QuinaryFunction : public ArityFunction<QuinaryFunction<FN>, 5> {
         return FN(a0, a1, a2, a3, a4);
     }
 
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override {
+        ValueBlock a[5];
+        this->evalArgs(block, a, out);
+
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = FN(a[0][i], a[1][i], a[2][i], a[3][i], a[4][i]);
+        }
+
+        this->setMissingValues(out);
+    }
+
 public:
     using ArityFunction<QuinaryFunction<FN>, 5>::ArityFunction;
 };
@@ -383,6 +466,29 @@ class MultiplyFunction : public ArityFunction<MultiplyFunction, 2> {
         return a0 * a1;
     }
 
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override {
+        ValueBlock a[2];
+        out.resize(block.size());
+        args_[0]->evalBlock(block, a[0]);
+        args_[1]->evalBlock(block, a[1]);
+
+        for (size_t i = 0; i < out.size(); ++i) {
+            bool m0 = a[0].missing(i);
+            bool m1 = a[1].missing(i);
+
+            if ((a[0][i] == 0 || a[1][i] == 0) && !(m0 && m1)) {
+                out[i] = 0;
+            }
+            else if (m0 || m1) {
+                out[i] = this->missingValue_;
+                out.setMissing(i);
+            }
+            else {
+                out[i] = a[0][i] * a[1][i];
+            }
+        }
+    }
+
 public:
     using ArityFunction<MultiplyFunction, 2>::ArityFunction;
 };
@@ -10,6 +10,7 @@
 
 #include "eckit/sql/expression/function/FunctionAVG.h"
 
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/expression/function/FunctionFactory.h"
 
 namespace eckit::sql::expression::function {
@@ -68,4 +69,24 @@ void FunctionAVG::partialResult() {
     //	else cout << "missing" << std::endl;
 }
 
+void FunctionAVG::partialResultBlock(const SQLBlock& block) {
+    ValueBlock values;
+    args_[0]->evalBlock(block, values);
+
+    double sum = value_;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!values.missing(i)) {
+            sum += values[i];
+            count_++;
+        }
+    }
+    value_ = sum;
+}
+
+void FunctionAVG::mergePartialResult(const SQLExpression& other) {
+    const FunctionAVG& o = dynamic_cast<const FunctionAVG&>(other);
+    value_ += o.value_;
+    count_ += o.count_;
+}
+
 }  // namespace eckit::sql::expression::function
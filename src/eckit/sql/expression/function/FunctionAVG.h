@@ -42,6 +42,9 @@ private:
     void prepare(SQLSelect&) override;
     void cleanup(SQLSelect&) override;
     void partialResult() override;
+    void partialResultBlock(const SQLBlock&) override;
+    bool canMergePartialResults() const override { return true; }
+    void mergePartialResult(const SQLExpression&) override;
     double eval(bool& missing) const override;
 
     bool isAggregate() const override { return true; }
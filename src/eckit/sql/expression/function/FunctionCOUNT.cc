@@ -10,6 +10,7 @@
 
 #include "eckit/sql/expression/function/FunctionCOUNT.h"
 
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/expression/function/FunctionFactory.h"
 
 namespace eckit::sql::expression::function {
@@ -59,4 +60,19 @@ void FunctionCOUNT::partialResult() {
     // cout << "FunctionCOUNT::partialResult " << count_ << std::endl;
 }
 
+void FunctionCOUNT::partialResultBlock(const SQLBlock& block) {
+    ValueBlock values;
+    args_[0]->evalBlock(block, values);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!values.missing(i)) {
+            count_++;
+        }
+    }
+}
+
+void FunctionCOUNT::mergePartialResult(const SQLExpression& other) {
+    count_ += dynamic_cast<const FunctionCOUNT&>(other).count_;
+}
+
 }  // namespace eckit::sql::expression::function
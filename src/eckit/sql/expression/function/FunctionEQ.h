@@ -40,6 +40,7 @@ private:
     // -- Overridden methods
     const eckit::sql::type::SQLType* type() const override;
     double eval(bool& missing) const override;
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override;
     std::shared_ptr<SQLExpression> simplify(bool&) override;
 
     // -- Friends
@@ -34,6 +34,15 @@ std::shared_ptr<SQLExpression> FunctionExpression::reshift(int minColumnShift) c
     return shifted;
 }
 
+std::shared_ptr<SQLExpression> FunctionExpression::deepClone() const {
+    // n.b. the copy constructors share the arguments
+    std::shared_ptr<SQLExpression> copy = clone();
+    for (std::shared_ptr<SQLExpression>& arg : static_cast<FunctionExpression&>(*copy).args_) {
+        arg = arg->deepClone();
+    }
+    return copy;
+}
+
 FunctionExpression::~FunctionExpression() {}
 
 void FunctionExpression::preprepare(SQLSelect& sql) {
@@ -92,6 +101,15 @@ bool FunctionExpression::isConstant() const {
     return true;
 }
 
+bool FunctionExpression::isStateful() const {
+    for (expression::Expressions::const_iterator j = args_.begin(); j != args_.end(); ++j) {
+        if ((*j)->isStateful()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool FunctionExpression::isAggregate() const {
     for (expression::Expressions::const_iterator j = args_.begin(); j != args_.end(); ++j) {
         if ((*j)->isAggregate()) {
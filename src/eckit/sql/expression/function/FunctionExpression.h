@@ -33,6 +33,7 @@ public:
     void updateType(SQLSelect& sql) override;
     void cleanup(SQLSelect& sql) override;
     bool isConstant() const override;
+    bool isStateful() const override;
     std::shared_ptr<SQLExpression> simplify(bool&) override;
 
     // double eval() const override;
@@ -41,6 +42,7 @@ public:
 
     const type::SQLType* type() const override;
     std::shared_ptr<SQLExpression> reshift(int minColumnShift) const override;
+    std::shared_ptr<SQLExpression> deepClone() const override;
 
     // For SQLSelectFactory (maybe it should just friend SQLSelectFactory).
     expression::Expressions& args() { return args_; }
@@ -11,6 +11,7 @@
 #include <cfloat>
 #include <climits>
 
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/expression/function/FunctionFactory.h"
 #include "eckit/sql/expression/function/FunctionMAX.h"
 
@@ -70,4 +71,24 @@ void FunctionMAX::partialResult() {
     }
 }
 
+void FunctionMAX::partialResultBlock(const SQLBlock& block) {
+    ValueBlock values;
+    args_[0]->evalBlock(block, values);
+
+    double value = value_;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!values.missing(i) && values[i] > value) {
+            value = values[i];
+        }
+    }
+    value_ = value;
+}
+
+void FunctionMAX::mergePartialResult(const SQLExpression& other) {
+    const FunctionMAX& o = dynamic_cast<const FunctionMAX&>(other);
+    if (o.value_ > value_) {
+        value_ = o.value_;
+    }
+}
+
 }  // namespace eckit::sql::expression::function
@@ -11,6 +11,7 @@
 #include <cfloat>
 #include <climits>
 
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/expression/function/FunctionFactory.h"
 #include "eckit/sql/expression/function/FunctionMIN.h"
 
@@ -70,4 +71,24 @@ void FunctionMIN::partialResult() {
     }
 }
 
+void FunctionMIN::partialResultBlock(const SQLBlock& block) {
+    ValueBlock values;
+    args_[0]->evalBlock(block, values);
+
+    double value = value_;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!values.missing(i) && values[i] < value) {
+            value = values[i];
+        }
+    }
+    value_ = value;
+}
+
+void FunctionMIN::mergePartialResult(const SQLExpression& other) {
+    const FunctionMIN& o = dynamic_cast<const FunctionMIN&>(other);
+    if (o.value_ < value_) {
+        value_ = o.value_;
+    }
+}
+
 }  // namespace eckit::sql::expression::function
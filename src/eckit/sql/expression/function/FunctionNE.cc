@@ -9,6 +9,7 @@
  */
 
 #include "eckit/sql/expression/function/FunctionNE.h"
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/expression/ColumnExpression.h"
 #include "eckit/sql/expression/function/FunctionFactory.h"
 #include "eckit/sql/type/SQLType.h"
@@ -61,4 +62,23 @@ double FunctionNE::eval(bool& missing) const {
     return equal(*args_[0], *args_[1], missing);
 }
 
+void FunctionNE::evalBlock(const SQLBlock& block, ValueBlock& out) const {
+    if (args_[0]->type()->getKind() == SQLType::stringType) {
+        SQLExpression::evalBlock(block, out);
+        return;
+    }
+
+    ValueBlock l;
+    ValueBlock r;
+    args_[0]->evalBlock(block, l);
+    args_[1]->evalBlock(block, r);
+
+    out.resize(block.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = l[i] != r[i];
+    }
+    out.mergeMissing(l);
+    out.mergeMissing(r);
+}
+
 }  // namespace eckit::sql::expression::function
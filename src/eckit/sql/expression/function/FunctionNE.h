@@ -39,6 +39,7 @@ private:
     // -- Overridden methods
     const eckit::sql::type::SQLType* type() const override;
     double eval(bool& missing) const override;
+    void evalBlock(const SQLBlock& block, ValueBlock& out) const override;
 
     // -- Friends
     // friend std::ostream& operator<<(std::ostream& s,const FunctionNE& p)
@@ -37,6 +37,7 @@ protected:
     void prepare(SQLSelect&) override;
     void cleanup(SQLSelect&) override;
     bool isConstant() const override;
+    bool isStateful() const override { return true; }
     void partialResult() override;
     double eval(bool& missing) const override;
     std::shared_ptr<SQLExpression> simplify(bool&) override;
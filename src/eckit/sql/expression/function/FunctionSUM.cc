@@ -9,6 +9,7 @@
  */
 
 #include "eckit/sql/expression/function/FunctionSUM.h"
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/expression/function/FunctionFactory.h"
 
 namespace eckit::sql::expression::function {
@@ -59,4 +60,27 @@ void FunctionSUM::partialResult() {
     }
 }
 
+void FunctionSUM::partialResultBlock(const SQLBlock& block) {
+    ValueBlock values;
+    args_[0]->evalBlock(block, values);
+
+    // n.b. accumulate in row order, so that the result is the same as with partialResult()
+    double sum = value_;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!values.missing(i)) {
+            sum += values[i];
+            resultNULL_ = false;
+        }
+    }
+    value_ = sum;
+}
+
+void FunctionSUM::mergePartialResult(const SQLExpression& other) {
+    const FunctionSUM& o = dynamic_cast<const FunctionSUM&>(other);
+    if (!o.resultNULL_) {
+        value_ += o.value_;
+        resultNULL_ = false;
+    }
+}
+
 }  // namespace eckit::sql::expression::function
@@ -9,6 +9,7 @@
  */
 
 #include "eckit/sql/expression/function/FunctionVAR.h"
+#include "eckit/sql/SQLBlock.h"
 #include "eckit/sql/expression/function/FunctionFactory.h"
 
 namespace eckit::sql::expression::function {
@@ -77,4 +78,28 @@ void FunctionVAR::partialResult() {
     //	else cout << "missing" << std::endl;
 }
 
+void FunctionVAR::partialResultBlock(const SQLBlock& block) {
+    ValueBlock values;
+    args_[0]->evalBlock(block, values);
+
+    double sum     = value_;
+    double squares = squares_;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!values.missing(i)) {
+            sum += values[i];
+            squares += values[i] * values[i];
+            count_++;
+        }
+    }
+    value_   = sum;
+    squares_ = squares;
+}
+
+void FunctionVAR::mergePartialResult(const SQLExpression& other) {
+    const FunctionVAR& o = dynamic_cast<const FunctionVAR&>(other);
+    value_ += o.value_;
+    squares_ += o.squares_;
+    count_ += o.count_;
+}
+
 }  // namespace eckit::sql::expression::function
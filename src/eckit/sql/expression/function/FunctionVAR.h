@@ -29,6 +29,9 @@ public:
     void prepare(SQLSelect&) override;
     void cleanup(SQLSelect&) override;
     void partialResult() override;
+    void partialResultBlock(const SQLBlock&) override;
+    bool canMergePartialResults() const override { return true; }
+    void mergePartialResult(const SQLExpression&) override;
 
     bool isAggregate() const override { return true; }
 
@@ -0,0 +1,457 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cerrno>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
+#include "eckit/thread/Executor.h"
+#include "eckit/thread/Thread.h"
+#include "eckit/thread/ThreadControler.h"
+
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+thread_local Executor* currentExecutor = nullptr;
+thread_local size_t currentWorker      = 0;
+
+Executor* sharedExecutor = nullptr;
+std::mutex sharedMutex;
+
+void sharedPrepare() {
+    sharedMutex.lock();
+}
+
+void sharedParent() {
+    sharedMutex.unlock();
+}
+
+void sharedChild() {
+    // The workers of the parent are not running in the child: abandon (leak) its executor, the child creates its own
+    sharedExecutor  = nullptr;
+    currentExecutor = nullptr;
+    sharedMutex.unlock();
+}
+
+#if defined(__linux__)
+
+/// Parse a kernel cpu list, such as "0-3,8-11"
+std::vector<int> parseCPUList(const std::string& list) {
+    std::vector<int> cpus;
+    std::istringstream in(list);
+    std::string range;
+    while (std::getline(in, range, ',')) {
+        auto dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+/// CPUs of each NUMA node, as far as the process is allowed to use them
+std::vector<std::vector<int>> numaNodes(const cpu_set_t& allowed) {
+    std::vector<std::vector<int>> nodes;
+    for (size_t node = 0;; ++node) {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string list;
+        if (!in || !std::getline(in, list)) {
+            break;
+        }
+        std::vector<int> cpus;
+        for (int cpu : parseCPUList(list)) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            nodes.push_back(cpus);
+        }
+    }
+    return nodes;
+}
+
+void pin(const std::string& name, size_t index, Executor::Affinity affinity) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return;
+    }
+
+    std::vector<int> cpus;
+
+    if (affinity == Executor::Affinity::NumaNode) {
+        auto nodes = numaNodes(allowed);
+        if (!nodes.empty()) {
+            cpus = nodes[index % nodes.size()];
+        }
+    }
+
+    if (cpus.empty()) {
+        std::vector<int> all;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                all.push_back(cpu);
+            }
+        }
+        if (all.empty()) {
+            return;
+        }
+        cpus.push_back(all[index % all.size()]);
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+
+    if (int err = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set)) {
+        errno = err;
+        Log::warning() << "Executor " << name << ": cannot pin worker " << index << Log::syserr << std::endl;
+    }
+}
+
+#else
+
+void pin(const std::string& name, size_t index, Executor::Affinity) {
+    Log::warning() << "Executor " << name << ": thread affinity not supported on this platform" << std::endl;
+}
+
+#endif
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct alignas(64) Executor::Worker {
+    std::mutex mutex_;
+    std::deque<Task> tasks_;
+};
+
+class Executor::WorkerThread : public Thread {
+public:
+    WorkerThread(Executor& owner, size_t index) :
+        owner_(owner), index_(index) {}
+
+private:
+    void run() override { owner_.run(index_); }
+
+    Executor& owner_;
+    size_t index_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Executor::Executor(const std::string& name, size_t threads, Affinity affinity, size_t stack) :
+    name_(name), affinity_(affinity) {
+
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back(new Worker);
+    }
+
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back(new ThreadControler(new WorkerThread(*this, i), false, stack));
+        threads_.back()->start();
+    }
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wakeup_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread->wait();
+    }
+}
+
+Executor* Executor::current() {
+    return currentExecutor;
+}
+
+Executor& Executor::shared() {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+
+    if (sharedExecutor == nullptr) {
+        static const bool atfork = [] {
+            THRCALL(::pthread_atfork(sharedPrepare, sharedParent, sharedChild));
+            return true;
+        }();
+        (void)atfork;
+
+        // n.b. never destroyed, so that it can be used until the end of the process
+        sharedExecutor = new Executor("eckit");
+    }
+
+    return *sharedExecutor;
+}
+
+void Executor::post(Task task) {
+    active_++;
+
+    // n.b. counted before the task is visible, so that a thief popping it cannot take queued_ below zero
+    queued_++;
+
+    size_t index = (currentExecutor == this) ? currentWorker : next_++ % workers_.size();
+    {
+        Worker& worker = *workers_[index];
+        std::lock_guard<std::mutex> lock(worker.mutex_);
+        worker.tasks_.push_back(std::move(task));
+    }
+
+    // Sleepers register under mutex_ before checking queued_, so either they see this task or we see them
+    if (sleeping_ > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wakeup_.notify_one();
+    }
+}
+
+bool Executor::pop(Task& task) {
+    const size_t n = workers_.size();
+    size_t self    = next_ % n;
+
+    if (currentExecutor == this) {
+        self           = currentWorker;
+        Worker& worker = *workers_[self];
+        std::lock_guard<std::mutex> lock(worker.mutex_);
+        if (!worker.tasks_.empty()) {
+            task = std::move(worker.tasks_.back());
+            worker.tasks_.pop_back();
+            queued_--;
+            return true;
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        Worker& victim = *workers_[(self + i) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex_);
+        if (!victim.tasks_.empty()) {
+            task = std::move(victim.tasks_.front());
+            victim.tasks_.pop_front();
+            queued_--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Executor::execute(Task& task) {
+    try {
+        task();
+    }
+    catch (std::exception& e) {
+        Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
+        Log::error() << "** Exception is ignored" << std::endl;
+    }
+
+    // Release what the task holds before anyone is told it is finished
+    task = nullptr;
+
+    if (--active_ == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.notify_all();
+    }
+}
+
+void Executor::run(size_t index) {
+    currentExecutor = this;
+    currentWorker   = index;
+
+    if (affinity_ != Affinity::None) {
+        pin(name_, index, affinity_);
+    }
+
+    Task task;
+    for (;;) {
+        if (pop(task)) {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleeping_++;
+        wakeup_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        sleeping_--;
+
+        if (stop_ && queued_ == 0) {
+            break;
+        }
+    }
+
+    currentExecutor = nullptr;
+}
+
+bool Executor::runPending() {
+    Task task;
+    if (pop(task)) {
+        execute(task);
+        return true;
+    }
+    return false;
+}
+
+void Executor::wait() {
+    ASSERT_MSG(currentExecutor != this, "Executor::wait() called from one of its tasks, use a TaskGroup");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return active_ == 0; });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct TaskGroup::Slot {
+    std::atomic<bool> taken{false};
+    Executor::Task task;
+};
+
+TaskGroup::TaskGroup(Executor& executor, size_t limit) :
+    executor_(executor), limit_(limit) {}
+
+TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    }
+    catch (std::exception& e) {
+        Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
+        Log::error() << "** Exception is ignored" << std::endl;
+    }
+}
+
+void TaskGroup::post(Executor::Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (limit_ > 0 && posted_ >= limit_) {
+            held_.push_back(std::move(task));
+            return;
+        }
+        posted_++;
+    }
+    queue(std::move(task));
+}
+
+void TaskGroup::queue(Executor::Task task) {
+    auto slot  = std::make_shared<Slot>();
+    slot->task = std::move(task);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!queued_.empty() && queued_.front()->taken) {
+            queued_.pop_front();
+        }
+        queued_.push_back(slot);
+        done_.notify_all();
+    }
+
+    // n.b. a waiting thread may take it first, then the executor only drops the slot
+    executor_.post([slot] {
+        if (!slot->taken.exchange(true)) {
+            Executor::Task task = std::move(slot->task);
+            task();
+        }
+    });
+}
+
+bool TaskGroup::take(Executor::Task& task) {
+    // n.b. called with mutex_ held
+    while (!queued_.empty()) {
+        std::shared_ptr<Slot> slot = queued_.front();
+        queued_.pop_front();
+        if (!slot->taken.exchange(true)) {
+            task = std::move(slot->task);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskGroup::finished(std::exception_ptr error) {
+    Executor::Task next;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error && !error_) {
+            error_ = error;
+        }
+        if (held_.empty()) {
+            posted_--;
+        }
+        else {
+            next = std::move(held_.front());
+            held_.pop_front();
+        }
+        if (--pending_ == 0) {
+            done_.notify_all();
+        }
+    }
+
+    // n.b. the group is still pending on that task, so it is alive
+    if (next) {
+        queue(std::move(next));
+    }
+}
+
+void TaskGroup::wait() {
+
+    if (Executor::current() == &executor_) {
+        // Called from a task: help rather than block, so that nested groups cannot starve the workers
+        while (pending_ > 0) {
+            if (!executor_.runPending()) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                done_.wait_for(lock, std::chrono::milliseconds(1), [this] { return pending_ == 0; });
+            }
+        }
+    }
+    else {
+        // Not a worker: run the tasks of the group the workers have not started, block only for the others
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (pending_ > 0) {
+            Executor::Task task;
+            if (take(task)) {
+                lock.unlock();
+                task();
+                task = nullptr;
+                lock.lock();
+                continue;
+            }
+            done_.wait(lock);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_                   = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
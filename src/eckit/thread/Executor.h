@@ -0,0 +1,188 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#ifndef eckit_Executor_h
+#define eckit_Executor_h
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "eckit/memory/NonCopyable.h"
+
+
+namespace eckit {
+
+class ThreadControler;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Work-stealing thread pool.
+///
+/// Each worker thread owns a deque of tasks. Tasks posted from a worker go to its own deque and are run
+/// most-recent first, tasks posted from other threads are spread over the workers. An idle worker steals
+/// the oldest task of another worker before going to sleep, so there is no lock shared by all threads.
+///
+/// Tasks are copyable callables. Blocking inside a task on a std::future of the same executor may
+/// deadlock, use a TaskGroup instead, which then runs pending tasks while it waits.
+
+class Executor : private NonCopyable {
+public:  // types
+    using Task = std::function<void()>;
+
+    enum class Affinity
+    {
+        None,      ///< Leave placement to the scheduler
+        Core,      ///< Pin each worker to one CPU, in turn
+        NumaNode,  ///< Pin each worker to all the CPUs of one NUMA node, in turn
+    };
+
+public:  // methods
+    /// @param threads number of workers, 0 for one per hardware thread
+    explicit Executor(const std::string& name, size_t threads = 0, Affinity = Affinity::None, size_t stack = 0);
+
+    /// Runs the tasks still queued, then stops the workers
+    ~Executor();
+
+    /// Queue a task, exceptions it throws are logged and ignored
+    void post(Task);
+
+    /// Queue a callable, its result or exception is delivered through the future
+    template <typename F>
+    auto submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>>;
+
+    /// Run one queued task on the calling thread. Returns false if there was none
+    bool runPending();
+
+    /// Wait until all the tasks posted so far, and those they post, have run
+    void wait();
+
+    size_t size() const { return workers_.size(); }
+    const std::string& name() const { return name_; }
+
+    /// The executor the calling thread is a worker of, if any
+    static Executor* current();
+
+    /// Process-wide executor, with one worker per hardware thread, created on first use. A child process (fork)
+    /// does not inherit it, but creates its own on first use
+    static Executor& shared();
+
+private:  // types
+    struct Worker;
+    class WorkerThread;
+
+private:  // methods
+    bool pop(Task&);
+    void execute(Task&);
+    void run(size_t index);
+
+private:  // members
+    std::string name_;
+    Affinity affinity_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::unique_ptr<ThreadControler>> threads_;
+
+    std::atomic<size_t> next_{0};     ///< Round-robin for tasks posted from outside
+    std::atomic<size_t> queued_{0};   ///< Tasks in the deques
+    std::atomic<size_t> active_{0};   ///< Tasks queued or running
+    std::atomic<size_t> sleeping_{0};
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable idle_;
+    bool stop_ = false;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Tasks submitted to an Executor that can be waited upon independently of the other tasks of the executor.
+/// The first exception thrown by a task of the group is rethrown by wait().
+/// With a limit, at most that many tasks of the group are queued or running on the executor at a time, the others
+/// are held by the group until then.
+
+class TaskGroup : private NonCopyable {
+public:  // methods
+    explicit TaskGroup(Executor&, size_t limit = 0);
+
+    /// Waits for the outstanding tasks, errors are logged
+    ~TaskGroup();
+
+    template <typename F>
+    void run(F&& f);
+
+    /// Waits for the tasks of the group, running in the meantime those of its tasks no worker has started yet, and from
+    /// within a task of the executor, any queued task
+    void wait();
+
+    bool done() const { return pending_ == 0; }
+
+    Executor& executor() { return executor_; }
+
+private:  // types
+    struct Slot;
+
+private:  // methods
+    void post(Executor::Task);
+    void queue(Executor::Task);
+    bool take(Executor::Task&);
+    void finished(std::exception_ptr);
+
+private:  // members
+    Executor& executor_;
+    size_t limit_;
+    size_t posted_ = 0;
+    std::deque<Executor::Task> held_;
+    std::deque<std::shared_ptr<Slot>> queued_;  ///< Tasks posted to the executor, run by whoever takes them first
+    std::atomic<size_t> pending_{0};
+    std::mutex mutex_;
+    std::condition_variable done_;
+    std::exception_ptr error_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <typename F>
+auto Executor::submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using R     = std::invoke_result_t<std::decay_t<F>>;
+    auto task   = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+    auto result = task->get_future();
+    post([task] { (*task)(); });
+    return result;
+}
+
+template <typename F>
+void TaskGroup::run(F&& f) {
+    pending_++;
+    post([this, f = std::forward<F>(f)]() mutable {
+        std::exception_ptr error;
+        try {
+            f();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        finished(error);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#ifndef eckit_ParallelFor_h
+#define eckit_ParallelFor_h
+
+#include <algorithm>
+#include <atomic>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/thread/Executor.h"
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Executor of the parallel algorithms: that of the calling thread if it is a worker (so that nested algorithms share
+/// its workers), otherwise Executor::shared(). No threads are created per call.
+inline Executor& parallelExecutor() {
+    Executor* current = Executor::current();
+    return current ? *current : Executor::shared();
+}
+
+/// Call f(begin, end) over the ranges of [0, n) of grain elements, by up to threads tasks at a time (0: as many as
+/// the workers of parallelExecutor()), the calling thread being one of them. With one thread, or one range, f is
+/// called on the calling thread only.
+template <typename F>
+void parallelFor(size_t n, size_t grain, size_t threads, F&& f) {
+    ASSERT(grain > 0);
+
+    const size_t ranges = (n + grain - 1) / grain;
+    if (threads == 1 || ranges <= 1) {
+        if (n > 0) {
+            f(size_t(0), n);
+        }
+        return;
+    }
+
+    Executor& executor = parallelExecutor();
+    const size_t tasks = std::min(ranges, threads == 0 ? executor.size() : threads);
+
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        try {
+            for (size_t i = next++; i < ranges; i = next++) {
+                f(i * grain, std::min(n, (i + 1) * grain));
+            }
+        }
+        catch (...) {
+            next = ranges;  // the other tasks stop at their next range
+            throw;
+        }
+    };
+
+    // n.b. the group is destroyed first, waiting for the tasks, if work() throws
+    TaskGroup group(executor);
+    for (size_t t = 1; t < tasks; ++t) {
+        group.run(work);
+    }
+    work();
+    group.wait();
+}
+
+/// Call f(group), with a TaskGroup of parallelExecutor() running up to threads of its tasks at a time (0: no
+/// limit other than the workers), then wait for the tasks. With one thread, the group is null and f should do all
+/// the work on the calling thread.
+template <typename F>
+void parallelTasks(size_t threads, F&& f) {
+    if (threads == 1) {
+        f(static_cast<TaskGroup*>(nullptr));
+        return;
+    }
+
+    TaskGroup group(parallelExecutor(), threads);
+    f(&group);
+    group.wait();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
+
+#endif
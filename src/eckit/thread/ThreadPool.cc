@@ -12,10 +12,10 @@
 // Baudouin Raoult - (c) ECMWF Feb 12
 
 #include "eckit/thread/ThreadPool.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
 #include "eckit/runtime/Monitor.h"
 #include "eckit/thread/AutoLock.h"
-#include "eckit/thread/Thread.h"
-#include "eckit/thread/ThreadControler.h"
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -23,71 +23,12 @@ namespace eckit {
 
 //----------------------------------------------------------------------------------------------------------------------
 
-class ThreadPoolThread : public Thread {
-    ThreadPool& owner_;
-    void run();
-
-public:
-    ThreadPoolThread(ThreadPool& owner) :
-        owner_(owner) {}
-};
-
-void ThreadPoolThread::run() {
-    owner_.notifyStart();
-
-    Monitor::instance().name(owner_.name());
-
-    // Log::info() << "Start of ThreadPoolThread " << std::endl;
-
-
-    for (;;) {
-        Monitor::instance().show(false);
-        Log::status() << "-" << std::endl;
-        ThreadPoolTask* r = owner_.next();
-        if (!r) {
-            break;
-        }
-        Monitor::instance().show(true);
-
-        r->pool_ = &owner_;
-
-
-        try {
-            r->execute();
-        }
-        catch (std::exception& e) {
-            Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
-            Log::error() << "** Exception is reported" << std::endl;
-            owner_.error(e.what());
-        }
-
-        try {
-            delete r;
-        }
-        catch (std::exception& e) {
-            Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
-            Log::error() << "** Exception is reported" << std::endl;
-            owner_.error(e.what());
-        }
-
-        owner_.endTask();
-    }
-
-
-    // Log::info() << "End of ThreadPoolThread " << std::endl;
-
-    owner_.notifyEnd();
-}
-
 ThreadPool::ThreadPool(const std::string& name, size_t count, size_t stack) :
-    count_(0), stack_(stack), running_(0), tasks_(0), name_(name), error_(false) {
-    // Log::info() << "ThreadPool::ThreadPool " << nme_ << " " << count << std::endl;
+    stack_(stack), name_(name), error_(false) {
     resize(count);
 }
 
 ThreadPool::~ThreadPool() {
-    // Log::info() << "ThreadPool::~ThreadPool " << name_ << std::endl;
-
     try {
         waitForThreads();
     }
@@ -95,59 +36,28 @@ ThreadPool::~ThreadPool() {
         Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
         Log::error() << "** Exception is ignored" << std::endl;
     }
-}
-
-void ThreadPool::waitForThreads() {
 
-    for (size_t i = 0; i < count_; i++) {
-        push(0);
+    // Tasks pushed while there were no threads
+    for (ThreadPoolTask* r : queue_) {
+        delete r;
     }
+}
 
+void ThreadPool::waitForThreads() {
 
-    AutoLock<MutexCond> lock(done_);
-    // Log::info() << "ThreadPool::waitForThreads " << name_ << " running: " << running_ << std::endl;
-    while (running_) {
-        // Log::info() << "ThreadPool::waitForThreads " << name_ << " running: " << running_ << std::endl;
-        done_.wait();
-    }
+    wait();
 
+    AutoLock<Mutex> lock(mutex_);
     if (error_) {
         error_ = false;
-        throw SeriousBug(std::string("ThreadPool::waitForThreads: ") + errorMessage_);
+        std::string msg;
+        std::swap(msg, errorMessage_);
+        throw SeriousBug(std::string("ThreadPool::waitForThreads: ") + msg);
     }
 }
 
-void ThreadPool::notifyStart() {
-    AutoLock<MutexCond> lock(done_);
-    running_++;
-    done_.signal();
-    // Log::info() << "ThreadPool::notifyStart " << name_ << " running: " << running_ << std::endl;
-}
-
-void ThreadPool::notifyEnd() {
-    AutoLock<MutexCond> lock(done_);
-    running_--;
-    done_.signal();
-    // Log::info() << "ThreadPool::notifyEnd " << name_ << " running: " << running_ << std::endl;
-}
-
-
-void ThreadPool::startTask() {
-    AutoLock<MutexCond> lock(active_);
-    tasks_++;
-    active_.signal();
-    // Log::info() << "ThreadPool::notifyStart " << name_ << " running: " << running_ << std::endl;
-}
-
-void ThreadPool::endTask() {
-    AutoLock<MutexCond> lock(active_);
-    tasks_--;
-    active_.signal();
-    // Log::info() << "ThreadPool::notifyStart " << name_ << " running: " << running_ << std::endl;
-}
-
 void ThreadPool::error(const std::string& msg) {
-    AutoLock<MutexCond> lock(done_);
+    AutoLock<Mutex> lock(mutex_);
     if (error_) {
         errorMessage_ += " | ";
     }
@@ -156,65 +66,97 @@ void ThreadPool::error(const std::string& msg) {
 }
 
 void ThreadPool::push(ThreadPoolTask* r) {
-    if (r) {
-        startTask();
+    if (!r) {
+        return;
     }
 
-    AutoLock<MutexCond> lock(ready_);
-    queue_.push_back(r);
-    ready_.signal();
-}
+    r->pool_ = this;
 
-void ThreadPool::push(std::list<ThreadPoolTask*>& l) {
-    AutoLock<MutexCond> lock(ready_);
-
-    for (std::list<ThreadPoolTask*>::iterator j = l.begin(); j != l.end(); ++j) {
-        queue_.push_back((*j));
+    if (!tasks_) {
+        AutoLock<Mutex> lock(mutex_);
+        queue_.push_back(r);
+        return;
     }
 
-    l.clear();
-    ready_.signal();
+    post(r);
 }
 
-ThreadPoolTask* ThreadPool::next() {
-    AutoLock<MutexCond> lock(ready_);
-    while (queue_.empty()) {
-        ready_.wait();
-    }
+void ThreadPool::post(ThreadPoolTask* r) {
+    tasks_->run([this, r] {
+        static thread_local bool named = false;
+        if (!named) {
+            Monitor::instance().name(name_);
+            named = true;
+        }
 
-    ThreadPoolTask* r = queue_.front();
-    queue_.pop_front();
+        Monitor::instance().show(true);
 
-    if (!queue_.empty()) {
-        ready_.signal();
-    }
+        try {
+            r->execute();
+        }
+        catch (std::exception& e) {
+            Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
+            Log::error() << "** Exception is reported" << std::endl;
+            error(e.what());
+        }
 
-    return r;
+        try {
+            delete r;
+        }
+        catch (std::exception& e) {
+            Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
+            Log::error() << "** Exception is reported" << std::endl;
+            error(e.what());
+        }
+
+        Monitor::instance().show(false);
+        Log::status() << "-" << std::endl;
+    });
+}
+
+void ThreadPool::push(std::list<ThreadPoolTask*>& l) {
+    for (ThreadPoolTask* r : l) {
+        push(r);
+    }
+    l.clear();
 }
 
 bool ThreadPool::done() {
-    return (queue_.empty() && !tasks_);
+    AutoLock<Mutex> lock(mutex_);
+    return queue_.empty() && (!tasks_ || tasks_->done());
 }
 
 void ThreadPool::wait() {
-    AutoLock<MutexCond> lock(active_);
-
-    while (tasks_) {
-        active_.wait();
+    if (tasks_) {
+        tasks_->wait();
     }
 }
 
 void ThreadPool::resize(size_t size) {
+    if ((executor_ ? executor_->size() : 0) == size) {
+        return;
+    }
+
+    wait();
+
+    tasks_.reset();
+    executor_.reset();
 
-    while (count_ > size) {
-        push(0);
-        count_--;
+    // n.b. Executor would take 0 to mean one thread per core
+    if (size == 0) {
+        return;
     }
 
-    while (count_ < size) {
-        ThreadControler c(new ThreadPoolThread(*this), true, stack_);
-        c.start();
-        count_++;
+    executor_.reset(new Executor(name_, size, Executor::Affinity::None, stack_));
+    tasks_.reset(new TaskGroup(*executor_));
+
+    std::list<ThreadPoolTask*> queued;
+    {
+        AutoLock<Mutex> lock(mutex_);
+        std::swap(queued, queue_);
+    }
+    for (ThreadPoolTask* r : queued) {
+        post(r);
     }
 }
 
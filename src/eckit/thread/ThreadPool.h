@@ -12,9 +12,12 @@
 #define eckit_ThreadPool_h
 
 #include <list>
+#include <memory>
 #include <string>
 
-#include "eckit/thread/MutexCond.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/thread/Executor.h"
+#include "eckit/thread/Mutex.h"
 
 
 namespace eckit {
@@ -29,7 +32,7 @@ public:
     virtual ~ThreadPoolTask();
     virtual void execute() = 0;
 
-    friend class ThreadPoolThread;
+    friend class ThreadPool;
 
 protected:
     ThreadPool& pool() { return *pool_; }
@@ -40,6 +43,10 @@ private:
 
 //-----------------------------------------------------------------------------
 
+/// Pool of threads running ThreadPoolTask objects, on top of an Executor
+/// Errors raised by the tasks are reported by waitForThreads()
+/// Tasks pushed while the pool has no threads (size 0) are queued until resize() adds some
+
 class ThreadPool : private NonCopyable {
 
 public:  // methods
@@ -47,34 +54,38 @@ public:  // methods
 
     ~ThreadPool();
 
+    /// Takes ownership of the task
     void push(ThreadPoolTask*);
     void push(std::list<ThreadPoolTask*>&);
-    ThreadPoolTask* next();
-    void notifyStart();
-    void notifyEnd();
     void waitForThreads();
     const std::string& name() const { return name_; }
     void error(const std::string&);
 
     void wait();
     bool done();
+
+    /// Waits for the pending tasks before changing the number of threads
     void resize(size_t);
 
-    void startTask();
-    void endTask();
+    /// @pre the pool has threads
+    Executor& executor() {
+        ASSERT(executor_);
+        return *executor_;
+    }
+
+private:  // methods
+    void post(ThreadPoolTask*);
 
 private:  // members
-    MutexCond ready_;
-    MutexCond done_;
-    MutexCond active_;
+    Mutex mutex_;
 
-    size_t count_;
     size_t stack_;
-    size_t running_;
-    size_t tasks_;
 
     std::string errorMessage_;
     std::string name_;
+
+    std::unique_ptr<Executor> executor_;
+    std::unique_ptr<TaskGroup> tasks_;
     std::list<ThreadPoolTask*> queue_;
 
     bool error_;
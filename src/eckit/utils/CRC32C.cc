@@ -0,0 +1,197 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "eckit/utils/CRC32C.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <nmmintrin.h>
+#define ECKIT_CRC32C_SSE42
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define ECKIT_CRC32C_ARM
+#endif
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+/// Slicing-by-8 tables of the reflected polynomial 0x82F63B78
+struct Tables {
+    std::uint32_t t[8][256];
+
+    Tables() {
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c >> 1) ^ ((c & 1) != 0 ? 0x82F63B78U : 0);
+            }
+            t[0][i] = c;
+        }
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            for (int s = 1; s < 8; ++s) {
+                t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+std::uint32_t crc_software(std::uint32_t crc, const unsigned char* p, size_t len) {
+    static const Tables tables;
+    const auto& t = tables.t;
+
+    for (; len >= 8; p += 8, len -= 8) {
+        std::uint32_t lo;
+        std::uint32_t hi;
+        ::memcpy(&lo, p, 4);
+        ::memcpy(&hi, p + 4, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        lo = __builtin_bswap32(lo);
+        hi = __builtin_bswap32(hi);
+#endif
+        lo ^= crc;
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+              ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+    }
+    for (; len > 0; ++p, --len) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(ECKIT_CRC32C_SSE42)
+
+__attribute__((target("sse4.2"))) std::uint32_t crc_hardware(std::uint32_t crc, const unsigned char* p, size_t len) {
+    std::uint64_t c = crc;
+    for (; len >= 8; p += 8, len -= 8) {
+        std::uint64_t v;
+        ::memcpy(&v, p, 8);
+        c = _mm_crc32_u64(c, v);
+    }
+    auto c32 = static_cast<std::uint32_t>(c);
+    for (; len > 0; ++p, --len) {
+        c32 = _mm_crc32_u8(c32, *p);
+    }
+    return c32;
+}
+
+bool has_hardware() {
+    static const bool sse42 = __builtin_cpu_supports("sse4.2") != 0;
+    return sse42;
+}
+
+#elif defined(ECKIT_CRC32C_ARM)
+
+std::uint32_t crc_hardware(std::uint32_t crc, const unsigned char* p, size_t len) {
+    for (; len >= 8; p += 8, len -= 8) {
+        std::uint64_t v;
+        ::memcpy(&v, p, 8);
+        crc = __crc32cd(crc, v);
+    }
+    for (; len > 0; ++p, --len) {
+        crc = __crc32cb(crc, *p);
+    }
+    return crc;
+}
+
+bool has_hardware() {
+    return true;
+}
+
+#else
+
+std::uint32_t crc_hardware(std::uint32_t crc, const unsigned char* p, size_t len) {
+    return crc_software(crc, p, len);
+}
+
+bool has_hardware() {
+    return false;
+}
+
+#endif
+
+std::string toString(std::uint32_t crc) {
+    static const char* hex = "0123456789abcdef";
+    char buffer[8];
+    for (int i = 8; i--;) {
+        buffer[i] = hex[crc & 15];
+        crc >>= 4;
+    }
+    return std::string(buffer, buffer + 8);
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::uint32_t CRC32C::crc(const void* buffer, size_t length, std::uint32_t crc) {
+    const auto* p = static_cast<const unsigned char*>(buffer);
+    crc           = ~crc;
+    crc           = has_hardware() ? crc_hardware(crc, p, length) : crc_software(crc, p, length);
+    return ~crc;
+}
+
+bool CRC32C::hardware() {
+    return has_hardware();
+}
+
+CRC32C::CRC32C() : crc_(0) {}
+
+CRC32C::CRC32C(const char* s) : crc_(0) {
+    add(s, strlen(s));
+}
+
+CRC32C::CRC32C(const std::string& s) : crc_(0) {
+    add(s.c_str(), s.size());
+}
+
+CRC32C::CRC32C(const void* data, size_t len) : crc_(0) {
+    add(data, len);
+}
+
+CRC32C::~CRC32C() = default;
+
+void CRC32C::reset() const {
+    crc_ = 0;
+    digest_.clear();
+}
+
+Hash::digest_t CRC32C::compute(const void* buffer, long size) {
+    return toString(crc(buffer, size_t(size)));
+}
+
+void CRC32C::update(const void* buffer, long length) {
+    if (length > 0) {
+        crc_ = crc(buffer, size_t(length), crc_);
+        if (!digest_.empty()) {
+            digest_ = digest_t();  // reset the digest
+        }
+    }
+}
+
+CRC32C::digest_t CRC32C::digest() const {
+    if (digest_.empty()) {  // recompute the digest
+        digest_ = toString(crc_);
+    }
+    return digest_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+HashBuilder<CRC32C> builder("crc32c");
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
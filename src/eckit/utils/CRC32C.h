@@ -0,0 +1,64 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#ifndef eckit_utils_CRC32C_H
+#define eckit_utils_CRC32C_H
+
+#include <cstdint>
+
+#include "eckit/utils/Hash.h"
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// CRC-32C (Castagnoli), computed by the CPU where it has instructions for it (SSE4.2 on x86-64, CRC32 on ARMv8),
+/// by table lookups (slicing-by-8) otherwise. The digest is the 32-bit CRC in hexadecimal.
+class CRC32C : public Hash {
+
+public:  // methods
+    CRC32C();
+
+    explicit CRC32C(const char*);
+    explicit CRC32C(const std::string&);
+
+    CRC32C(const void* data, size_t len);
+
+    ~CRC32C() override;
+
+    void reset() const override;
+
+    digest_t compute(const void*, long) override;
+
+    void update(const void*, long) override;
+
+    digest_t digest() const override;
+
+    template <class T>
+    CRC32C& operator<<(const T& x) {
+        add(x);
+        return *this;
+    }
+
+    /// CRC of a buffer, continuing the CRC of preceding data (0 if none)
+    static std::uint32_t crc(const void*, size_t, std::uint32_t crc = 0);
+
+    /// If the CRC is computed by CPU instructions
+    static bool hardware();
+
+private:  // members
+    mutable std::uint32_t crc_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // end namespace eckit
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "eckit/utils/TreeHash.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "eckit/eckit.h"
+
+#include "eckit/thread/ParallelFor.h"
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+TreeHash::TreeHash(const std::string& leaf, size_t threads) :
+    leaf_(leaf), threads_(threads) {}
+
+TreeHash::~TreeHash() = default;
+
+Hash& TreeHash::hash() const {
+    // n.b. built on first use, as the factory is locked while building this
+    if (!hash_) {
+        hash_.reset(HashFactory::instance().build(leaf_));
+    }
+    return *hash_;
+}
+
+std::string TreeHash::leaves(const char* data, size_t length) const {
+    const size_t n = (length + leafSize - 1) / leafSize;
+
+    if (threads_ == 1 || n <= 1) {
+        std::string digests;
+        for (size_t i = 0; i < n; ++i) {
+            digests += hash().compute(data + i * leafSize, long(std::min(leafSize, length - i * leafSize)));
+        }
+        return digests;
+    }
+
+    std::vector<std::string> digests(n);
+
+    parallelFor(n, 1, threads_, [&](size_t begin, size_t end) {
+        std::unique_ptr<Hash> h(HashFactory::instance().build(leaf_));
+        for (size_t i = begin; i < end; ++i) {
+            digests[i] = h->compute(data + i * leafSize, long(std::min(leafSize, length - i * leafSize)));
+        }
+    });
+
+    std::string all;
+    for (const auto& d : digests) {
+        all += d;
+    }
+    return all;
+}
+
+void TreeHash::reset() const {
+    digests_.clear();
+    pending_.clear();
+    digest_.clear();
+}
+
+Hash::digest_t TreeHash::compute(const void* buffer, long size) {
+    const auto digests = leaves(static_cast<const char*>(buffer), size_t(size));
+    return hash().compute(digests.data(), long(digests.size()));
+}
+
+void TreeHash::update(const void* buffer, long length) {
+    if (length <= 0) {
+        return;
+    }
+
+    const auto* p = static_cast<const char*>(buffer);
+    auto len      = size_t(length);
+
+    if (!pending_.empty()) {
+        const size_t n = std::min(len, leafSize - pending_.size());
+        pending_.append(p, n);
+        p += n;
+        len -= n;
+
+        if (pending_.size() < leafSize) {
+            digest_.clear();
+            return;
+        }
+        digests_ += leaves(pending_.data(), pending_.size());
+        pending_.clear();
+    }
+
+    // n.b. complete leaves are hashed in place, the rest is kept until completed
+    const size_t complete = len - len % leafSize;
+    digests_ += leaves(p, complete);
+    pending_.assign(p + complete, len - complete);
+
+    digest_.clear();
+}
+
+TreeHash::digest_t TreeHash::digest() const {
+    if (digest_.empty()) {  // recompute the digest
+        const auto digests = digests_ + leaves(pending_.data(), pending_.size());
+        digest_            = hash().compute(digests.data(), long(digests.size()));
+    }
+    return digest_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+class TreeHashBuilder : public HashBuilderBase {
+    std::string leaf_;
+
+    Hash* make() override { return new TreeHash(leaf_); }
+
+    Hash* make(const std::string& param) override {
+        auto* hash = new TreeHash(leaf_);
+        hash->add(param);
+        return hash;
+    }
+
+public:
+    explicit TreeHashBuilder(const std::string& leaf) : HashBuilderBase(leaf + "-tree"), leaf_(leaf) {}
+};
+
+TreeHashBuilder crc32c_builder("crc32c");
+#if eckit_HAVE_XXHASH
+TreeHashBuilder xxh64_builder("xxh64");
+TreeHashBuilder xxh3_builder("xxh3");
+#endif
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit
@@ -0,0 +1,73 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#ifndef eckit_utils_TreeHash_H
+#define eckit_utils_TreeHash_H
+
+#include <memory>
+#include <string>
+
+#include "eckit/utils/Hash.h"
+
+namespace eckit {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Tree hash over a leaf hash function, for large buffers: the data is cut into leaves of leafSize bytes, hashed
+/// independently over threads, and the digest is the leaf hash of the leaf digests. The digest depends neither on the
+/// number of threads nor on how the data is added, but differs from the leaf hash of the data.
+///
+/// Registered as "<leaf>-tree", e.g. "crc32c-tree" or "xxh3-tree".
+class TreeHash : public Hash {
+
+public:  // types
+    static constexpr size_t leafSize = 1024 * 1024;
+
+public:  // methods
+    /// @param leaf    name of the leaf hash function (see HashFactory)
+    /// @param threads number of threads hashing the leaves (0: as many as the workers, see parallelFor)
+    explicit TreeHash(const std::string& leaf, size_t threads = 0);
+
+    ~TreeHash() override;
+
+    void reset() const override;
+
+    digest_t compute(const void*, long) override;
+
+    void update(const void*, long) override;
+
+    digest_t digest() const override;
+
+    template <class T>
+    TreeHash& operator<<(const T& x) {
+        add(x);
+        return *this;
+    }
+
+private:  // methods
+    /// Digests of the n leaves of data, the last one possibly shorter, concatenated
+    std::string leaves(const char* data, size_t length) const;
+
+    Hash& hash() const;
+
+private:  // members
+    std::string leaf_;
+    size_t threads_;
+
+    mutable std::unique_ptr<Hash> hash_;
+    mutable std::string digests_;  ///< of the leaves completed
+    mutable std::string pending_;  ///< data of the leaf being completed
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // end namespace eckit
+
+#endif
@@ -21,6 +21,22 @@ namespace eckit {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+namespace {
+
+std::string toString(XXH64_hash_t hash) {
+    static const char* hex = "0123456789abcdef";
+    char buffer[16];
+    for (int i = 16; i--;) {
+        buffer[i] = hex[hash & 15];
+        hash >>= 4;
+    }
+    return std::string(buffer, buffer + 16);
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
 struct xxHash::Context {
     XXH64_state_t* state_;
 
@@ -48,16 +64,6 @@ struct xxHash::Context {
     static std::string compute(const void* buffer, long length) {
         return toString(XXH64(buffer, size_t(length), 0));
     }
-
-    static std::string toString(XXH64_hash_t hash) {
-        static const char* hex = "0123456789abcdef";
-        char buffer[16];
-        for (int i = 16; i--;) {
-            buffer[i] = hex[hash & 15];
-            hash >>= 4;
-        }
-        return std::string(buffer, buffer + 16);
-    }
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -109,9 +115,89 @@ xxHash::digest_t xxHash::digest() const {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+struct xxHash3::Context {
+    XXH3_state_t* state_;
+
+    Context() {
+        state_ = XXH3_createState();
+        reset();
+    }
+
+    ~Context() {
+        XXH3_freeState(state_);
+    }
+
+    void reset() {
+        XXH3_64bits_reset(state_);
+    }
+
+    void update(const void* buffer, long length) {
+        XXH3_64bits_update(state_, buffer, size_t(length));
+    }
+
+    std::string digest() {
+        return toString(XXH3_64bits_digest(state_));
+    }
+
+    static std::string compute(const void* buffer, long length) {
+        return toString(XXH3_64bits(buffer, size_t(length)));
+    }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+xxHash3::xxHash3() {
+    ctx_.reset(new Context());
+}
+
+xxHash3::xxHash3(const char* s) {
+    ctx_.reset(new Context());
+    add(s, strlen(s));
+}
+
+xxHash3::xxHash3(const std::string& s) {
+    ctx_.reset(new Context());
+    add(s.c_str(), s.size());
+}
+
+xxHash3::xxHash3(const void* data, size_t len) {
+    ctx_.reset(new Context());
+    add(data, len);
+}
+
+xxHash3::~xxHash3() {}
+
+void xxHash3::reset() const {
+    ctx_->reset();
+    digest_.clear();
+}
+
+Hash::digest_t xxHash3::compute(const void* buffer, long size) {
+    return Context::compute(buffer, size);
+}
+
+void xxHash3::update(const void* buffer, long length) {
+    if (length > 0) {
+        ctx_->update(buffer, length);
+        if (!digest_.empty()) {
+            digest_ = digest_t();  // reset the digest
+        }
+    }
+}
+
+xxHash3::digest_t xxHash3::digest() const {
+    if (digest_.empty()) {  // recompute the digest
+        digest_ = ctx_->digest();
+    }
+    return digest_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 namespace {
 HashBuilder<xxHash> deprecated_builder("xxHash");
 HashBuilder<xxHash> builder("xxh64");
+HashBuilder<xxHash3> xxh3_builder("xxh3");
 }  // namespace
 
 //----------------------------------------------------------------------------------------------------------------------
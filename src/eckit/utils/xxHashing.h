@@ -51,4 +51,36 @@ private:  // members
     std::unique_ptr<Context> ctx_;
 };
 
+/// XXH3 (64 bits), several times faster than XXH64 on large buffers
+class xxHash3 : public Hash {
+
+public:  // types
+    xxHash3();
+
+    explicit xxHash3(const char*);
+    explicit xxHash3(const std::string&);
+
+    xxHash3(const void* data, size_t len);
+
+    ~xxHash3() override;
+
+    void reset() const override;
+
+    digest_t compute(const void*, long) override;
+
+    void update(const void*, long) override;
+
+    digest_t digest() const override;
+
+    template <class T>
+    xxHash3& operator<<(const T& x) {
+        add(x);
+        return *this;
+    }
+
+private:  // members
+    struct Context;
+    std::unique_ptr<Context> ctx_;
+};
+
 }  // end namespace eckit
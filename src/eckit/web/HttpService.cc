@@ -9,6 +9,11 @@
  */
 
 #include "eckit/web/HttpService.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
 #include "eckit/config/Resource.h"
 #include "eckit/io/TCPSocketHandle.h"
 #include "eckit/runtime/Monitor.h"
@@ -39,9 +44,21 @@ HttpUser::HttpUser(net::TCPSocket& protocol) :
 HttpUser::~HttpUser() {}
 
 void HttpUser::serve(eckit::Stream& s, std::istream& in, std::ostream& out) {
+    respond(s, in, out, false);
+}
+
+bool HttpUser::serveRequest(eckit::Stream& s, std::istream& in, std::ostream& out) {
+    return respond(s, in, out, true);
+}
+
+bool HttpUser::respond(eckit::Stream& s, std::istream& in, std::ostream& out, bool keepAlive) {
     static bool debug = Resource<bool>("-debug-http", false);
     protocol_.debug(debug);
 
+    if (keepAlive && in.peek() == std::char_traits<char>::eof()) {
+        return false;  // closed by the client
+    }
+
     HttpStream http;
 
     Url url(in);
@@ -54,14 +71,30 @@ void HttpUser::serve(eckit::Stream& s, std::istream& in, std::ostream& out) {
         Log::error() << "** " << e.what() << " Caught in " << Here() << std::endl;
         Log::error() << "** Exception is ignored" << std::endl;
         http << "Exception caught: " << e.what() << std::endl;
-        return;
+        return false;
     }
 
+    if (keepAlive) {
+        std::string connection = url.headerIn().getHeader("Connection");
+        std::transform(connection.begin(), connection.end(), connection.begin(), ::tolower);
+
+        keepAlive = connection == "keep-alive" || (url.version() == "HTTP/1.1" && connection != "close");
+
+        // n.b. the client finds the end of a streamed response by the connection closing, if its length is unknown
+        if (url.streamFrom() != nullptr && url.streamFrom()->estimate() <= 0) {
+            keepAlive = false;
+        }
+
+        if (keepAlive) {
+            url.headerOut().setHeader("Connection", "keep-alive");
+        }
+    }
 
     InstantTCPSocketHandle stream(protocol_);
     http.write(out, url, stream);
 
     Monitor::instance().show(false);
+    return keepAlive;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -29,6 +29,12 @@ public:
 
 private:
     void serve(eckit::Stream&, std::istream&, std::ostream&) override;
+
+    /// Keeps the connection alive if the client asks for it (HTTP/1.1 or "Connection: keep-alive")
+    bool serveRequest(eckit::Stream&, std::istream&, std::ostream&) override;
+
+    /// Returns whether the connection is kept alive
+    bool respond(eckit::Stream&, std::istream&, std::ostream&, bool keepAlive);
 };
 
 //-----------------------------------------------------------------------------
@@ -119,6 +119,9 @@ Url::Url(std::istream& in) {
     char c = 0;
     while (in.get(c) && c != '\n') {
         header(c);
+        if (c != ' ' && c != '\r') {
+            version_ += c;
+        }
     }
 
     parse(in);
@@ -59,6 +59,9 @@ public:
 
     const std::string& method() { return method_; }
 
+    /// Protocol version of the request, e.g. "HTTP/1.1"
+    const std::string& version() const { return version_; }
+
 
     HttpHeader& headerIn();
     HttpHeader& headerOut();
@@ -128,6 +131,7 @@ private:  // members
     HttpHeader out_;
 
     std::string method_;
+    std::string version_;
 
     std::vector<std::string> remaining_;
 };
@@ -10,15 +10,22 @@
 
 #include <string.h>
 #include <unistd.h>
+#include <chrono>
 #include <fstream>
+#include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include "eckit/config/Resource.h"
+#include "eckit/io/Buffer.h"
 #include "eckit/io/MultiSocketHandle.h"
 #include "eckit/io/PartFileHandle.h"
 #include "eckit/log/Bytes.h"
 #include "eckit/log/Timer.h"
 #include "eckit/net/MultiSocket.h"
+#include "eckit/net/TCPClient.h"
+#include "eckit/net/TCPServer.h"
 #include "eckit/runtime/Application.h"
 
 
@@ -30,6 +37,7 @@ class Client : public Application {
     void test(const std::string& host, int port);
     void send(const std::string& host, int port);
     void grid(const std::string& host, int port);
+    void benchmark(const std::string& host, int port);
 
 public:
     Client(int argc, char** argv) :
@@ -122,12 +130,98 @@ void Client::grid(const std::string& host, int port) {
     }
 }
 
+/// Relays the connections of a MultiSocket to the server, delaying some of them after each block forwarded, to
+/// emulate streams that are slower than others (e.g. congested)
+class Relay {
+public:
+    Relay(int port, const std::string& host, int serverPort, size_t streams, size_t slowStreams, int delay) :
+        server_(port) {
+        server_.socket();  // listen now, so that the client can connect straight away
+        thread_ = std::thread([=]() {
+            std::vector<std::thread> forwarders;
+            for (size_t i = 0; i < streams; ++i) {
+                auto in  = std::make_shared<net::TCPSocket>(server_.accept());
+                auto out = std::make_shared<net::TCPClient>();
+                out->connect(host, serverPort);
+                forwarders.emplace_back([in, out, i, slowStreams, delay]() {
+                    Buffer buffer(64 * 1024);
+                    long len;
+                    while ((len = in->rawRead(buffer, buffer.size())) > 0) {
+                        ASSERT(out->write(buffer, len) == len);
+                        if (i < slowStreams) {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+                        }
+                    }
+                    out->close();
+                });
+            }
+            for (auto& f : forwarders) {
+                f.join();
+            }
+        });
+    }
+
+    ~Relay() { wait(); }
+
+    void wait() {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+private:
+    net::TCPServer server_;
+    std::thread thread_;
+};
+
+void Client::benchmark(const std::string& host, int port) {
+    int streams     = Resource<int>("--streams", 10);
+    int messageSize = Resource<int>("--message-size", 64 * 1024);
+    long long size  = Resource<long long>("--size", 256 * 1024 * 1024);
+    int relayPort   = Resource<int>("--relay-port", port + 1);
+    int slowStreams = Resource<int>("--slow-streams", 1);
+    int delay       = Resource<int>("--delay", 10);  // milliseconds, per block of 64 KiB
+
+    Buffer buffer(1024 * 1024);
+    ::memset(buffer, 0, buffer.size());
+
+    for (bool adaptive : {false, true}) {
+        Log::info() << "Sending " << Bytes(size) << " over " << streams << " streams (" << slowStreams
+                    << " delayed by " << delay << "ms per 64 KiB), " << (adaptive ? "adaptive" : "round-robin")
+                    << std::endl;
+
+        Relay relay(relayPort, host, port, streams, slowStreams, delay);
+
+        Timer timer;
+        {
+            net::MultiSocket client(streams, messageSize);
+            client.adaptive(adaptive);
+            net::MultiSocket s(client.connect("localhost", relayPort));
+
+            long long left = size;
+            while (left > 0) {
+                long len = long(std::min(left, (long long)buffer.size()));
+                ASSERT(s.write(buffer, len) == len);
+                left -= len;
+            }
+
+            s.close();
+            s.report(Log::info(), "  ");
+        }
+        relay.wait();
+
+        Log::info() << (adaptive ? "Adaptive" : "Round-robin") << ": " << Bytes(size) << " at "
+                    << Bytes(size, timer) << std::endl;
+    }
+}
+
 void Client::run() {
 
     std::string host = Resource<std::string>("--host", "localhost");
     int port         = Resource<int>("--port", 9013);
     bool test        = Resource<bool>("--test", false);
     bool grid        = Resource<bool>("--grid", false);
+    bool benchmark   = Resource<bool>("--benchmark", false);
 
     if (test) {
         Client::test(host, port);
@@ -139,6 +233,11 @@ void Client::run() {
         return;
     }
 
+    if (benchmark) {
+        Client::benchmark(host, port);
+        return;
+    }
+
     Client::send(host, port);
 }
 
@@ -69,6 +69,7 @@ void Server::run() {
                 total += len;
             }
             Log::info() << "Received " << Bytes(total) << " at " << Bytes(total, timer) << std::endl;
+            s.report(Log::info(), "  ");
         }
         catch (std::exception& e) {
             Log::error() << e.what() << std::endl;
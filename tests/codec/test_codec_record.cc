@@ -10,14 +10,22 @@
  */
 
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <vector>
 
 #include "eckit/codec/codec.h"
 #include "eckit/exception/Exceptions.h"
+#include "eckit/io/Buffer.h"
 #include "eckit/io/MemoryHandle.h"
 #include "eckit/testing/Test.h"
+#include "eckit/thread/Executor.h"
+#include "eckit/utils/Compressor.h"
+#include "eckit/utils/Hash.h"
 
 namespace eckit::test {
 
@@ -451,6 +459,287 @@ CASE("Async read") {
 
 //-----------------------------------------------------------------------------
 
+CASE("Read many items at once") {
+    constexpr size_t N = 24;
+
+    std::vector<std::vector<double>> written(N);
+    {
+        codec::RecordWriter record;
+        for (size_t i = 0; i < N; ++i) {
+            written[i].assign(1000 * (i + 1), double(i));
+            record.set("v" + std::to_string(i), codec::ref(written[i]));
+        }
+        record.write("record_many.atlas" + suffix());
+    }
+
+    for (size_t threads : {1, 4}) {
+        SECTION("all items, threads=" + std::to_string(threads)) {
+            std::vector<std::vector<double>> read(N);
+            codec::RecordReader record("record_many.atlas" + suffix());
+            record.threads(threads);
+            record.checksum(true);
+            for (size_t i = 0; i < N; ++i) {
+                record.read("v" + std::to_string(i), read[i]);
+            }
+            record.wait();
+            EXPECT(read == written);
+        }
+
+        SECTION("some items, threads=" + std::to_string(threads)) {
+            std::vector<std::vector<double>> read(N);
+            codec::RecordReader record("record_many.atlas" + suffix());
+            record.threads(threads);
+            for (size_t i = 0; i < N; i += 3) {
+                record.read("v" + std::to_string(i), read[i]);
+            }
+            record.wait("v3");
+            EXPECT(read[3] == written[3]);
+            EXPECT(read[6].empty());
+
+            record.wait();
+            for (size_t i = 0; i < N; ++i) {
+                EXPECT(read[i] == (i % 3 == 0 ? written[i] : std::vector<double>{}));
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Checksum algorithm per record") {
+    std::vector<double> written(10000);
+    for (size_t i = 0; i < written.size(); ++i) {
+        written[i] = double(i) / 7.;
+    }
+
+    const std::vector<std::string> algorithms{"crc32c", "crc32c-tree", "xxh64", "xxh3"};
+    for (const auto& algorithm : algorithms) {
+        if (!eckit::HashFactory::instance().has(algorithm)) {
+            continue;
+        }
+        SECTION("checksum=" + algorithm) {
+            const std::string path = "record_checksum_" + algorithm + ".atlas" + suffix();
+            {
+                codec::RecordWriter record;
+                record.checksum_algorithm(algorithm);
+                record.set("v", codec::ref(written));
+                record.write(path);
+            }
+
+            std::vector<double> read;
+            codec::RecordReader reader(path);
+            reader.checksum(true);
+            reader.read("v", read).wait();
+            EXPECT(read == written);
+
+            codec::RecordItem item;
+            codec::RecordItemReader{"file:" + path + "?key=v"}.read(item);
+            EXPECT_EQUAL(item.metadata().data.checksum().algorithm(), algorithm);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/// Run-length encoding of bytes, so that compression in chunks is tested whichever compression libraries are built
+class RunLengthCompressor : public eckit::Compressor {
+public:
+    size_t compress(const void* in, size_t len, eckit::Buffer& out) const override {
+        const auto* p = static_cast<const unsigned char*>(in);
+        std::vector<unsigned char> runs;
+        for (size_t i = 0; i < len;) {
+            size_t n = 1;
+            while (i + n < len && n < 255 && p[i + n] == p[i]) {
+                ++n;
+            }
+            runs.push_back(static_cast<unsigned char>(n));
+            runs.push_back(p[i]);
+            i += n;
+        }
+        if (out.size() < runs.size()) {
+            out.resize(runs.size());
+        }
+        out.copy(runs.data(), runs.size());
+        return runs.size();
+    }
+
+    void uncompress(const void* in, size_t len, eckit::Buffer& out, size_t outlen) const override {
+        const auto* p = static_cast<const unsigned char*>(in);
+        if (out.size() < outlen) {
+            out.resize(outlen);
+        }
+        auto* o  = static_cast<unsigned char*>(out.data());
+        size_t k = 0;
+        for (size_t i = 0; i + 1 < len; i += 2) {
+            ASSERT(k + p[i] <= outlen);
+            ::memset(o + k, p[i + 1], p[i]);
+            k += p[i];
+        }
+        ASSERT(k == outlen);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+    }
+
+    /// Threads that have decompressed chunks
+    static std::mutex mutex;
+    static std::set<std::thread::id> threads;
+};
+
+std::mutex RunLengthCompressor::mutex;
+std::set<std::thread::id> RunLengthCompressor::threads;
+
+static eckit::CompressorBuilder<RunLengthCompressor> run_length_compressor("test-rle");
+
+CASE("Compress items in chunks") {
+    std::vector<double> written(100000);
+    for (size_t i = 0; i < written.size(); ++i) {
+        written[i] = double(i / 100);
+    }
+
+    for (const std::string& compression : {std::string("test-rle"), codec::defaults::compression_algorithm()}) {
+        SECTION("compression=" + compression) {
+            const std::string path = "record_chunks_" + compression + ".atlas" + suffix();
+            {
+                codec::RecordWriter record;
+                record.compression(compression);
+                record.chunk_size(10000);
+                record.threads(4);
+                record.set("v", codec::ref(written));
+                record.write(path);
+            }
+
+            std::vector<double> read;
+            codec::RecordReader reader(path);
+            reader.checksum(true);
+            reader.read("v", read).wait();
+            EXPECT(read == written);
+
+            codec::RecordItem item;
+            codec::RecordItemReader{"file:" + path + "?key=v"}.read(item);
+            const size_t chunk_size = compression == "none" ? 0 : 10000;
+            EXPECT_EQUAL(item.metadata().data.chunk_size(), chunk_size);
+
+            // a range over several chunks, starting and ending within chunks
+            std::vector<double> range(3000);
+            item.decompress(12345 * sizeof(double), range.size() * sizeof(double), range.data());
+            EXPECT(std::equal(range.begin(), range.end(), written.begin() + 12345));
+
+            // the last chunk, shorter than the others
+            item.decompress((written.size() - 1) * sizeof(double), sizeof(double), range.data());
+            EXPECT_EQUAL(range[0], written.back());
+
+            EXPECT_THROWS_AS(item.decompress(written.size() * sizeof(double), 1, range.data()), eckit::OutOfRange);
+
+            item.decompress();
+            EXPECT_EQUAL(item.data().size(), written.size() * sizeof(double));
+            EXPECT(::memcmp(item.data(), written.data(), item.data().size()) == 0);
+        }
+    }
+}
+
+CASE("Decompress chunks of items read in parallel on the shared workers") {
+    std::vector<double> written(50000);
+    for (size_t i = 0; i < written.size(); ++i) {
+        written[i] = double(i / 10);
+    }
+
+    const std::string path = "record_chunks_parallel.atlas" + suffix();
+    {
+        codec::RecordWriter record;
+        record.compression("test-rle");
+        record.chunk_size(1000);
+        for (const std::string key : {"a", "b", "c", "d"}) {
+            record.set(key, codec::ref(written));
+        }
+        record.write(path);
+    }
+
+    RunLengthCompressor::threads.clear();
+
+    std::vector<double> a, b, c, d;
+    codec::RecordReader reader(path);
+    reader.threads(4);
+    reader.read("a", a);
+    reader.read("b", b);
+    reader.read("c", c);
+    reader.read("d", d);
+    reader.wait();
+
+    EXPECT(a == written && b == written && c == written && d == written);
+
+    // the chunks of each item are not decompressed by threads of their own, but by the workers and the caller
+    EXPECT(RunLengthCompressor::threads.size() <= Executor::shared().size() + 1);
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Read items mapped in memory") {
+    std::vector<double> v1(10000);
+    std::vector<int> v2(333);
+    for (size_t i = 0; i < v1.size(); ++i) {
+        v1[i] = double(i) / 3.;
+    }
+    for (size_t i = 0; i < v2.size(); ++i) {
+        v2[i] = int(i % 7);
+    }
+
+    const std::string path = "record_mapped.atlas" + suffix();
+    {
+        eckit::LocalConfiguration rle;
+        rle.set("compression", "test-rle");
+
+        codec::RecordWriter record;
+        record.set("s", std::string("a string of odd length"), no_compression);
+        record.set("v1", codec::ref(v1), no_compression);
+        record.set("v2", codec::ref(v2), no_compression);
+        record.set("v3", codec::ref(v2), rle);
+        record.write(path);
+    }
+
+    codec::ArrayView view1;
+    codec::ArrayView view2;
+    codec::ArrayView view3;
+    std::vector<double> read1;
+    {
+        codec::RecordReader record(path);
+        record.mmap(true);
+        record.read("v1", view1);
+        record.read("v2", view2);
+        record.read("v3", view3);
+        record.wait();
+    }
+    {
+        codec::RecordReader record(path);
+        record.mmap(true);
+        record.read("v1", read1);
+        record.wait();
+    }
+
+    // n.b. the views outlive the reader, the file stays mapped
+    EXPECT(view1.shared());
+    EXPECT(view2.shared());
+    EXPECT(not view3.shared());
+
+    EXPECT_EQUAL(view1.size(), v1.size());
+    EXPECT(std::equal(v1.begin(), v1.end(), view1.data<double>()));
+    EXPECT(std::equal(v2.begin(), v2.end(), view2.data<int>()));
+    EXPECT(std::equal(v2.begin(), v2.end(), view3.data<int>()));
+    EXPECT(read1 == v1);
+    EXPECT_THROWS_AS(view1.data<float>(), codec::Exception);
+
+    SECTION("without mapping") {
+        codec::ArrayView view;
+        codec::RecordReader record(path);
+        record.mmap(false);
+        record.read("v1", view).wait();
+        EXPECT(not view.shared());
+        EXPECT(std::equal(v1.begin(), v1.end(), view.data<double>()));
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 CASE("Recursive Write/read records in nested subdirectories") {
     auto reference_path = eckit::PathName{"atlas_test_io_refpath"};
 
@@ -0,0 +1,93 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "eckit/container/MPMCQueue.h"
+#include "eckit/container/Queue.h"
+#include "eckit/log/Timer.h"
+
+#include "eckit/testing/Test.h"
+
+using namespace std;
+using namespace eckit;
+using namespace eckit::testing;
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+#define NMESSAGES 200000
+
+template <typename QUEUE>
+void benchmark_queue(const std::string& tname, size_t depth, size_t nprod, size_t ncons, size_t batch) {
+
+    std::ostringstream os;
+    os << tname << " depth=" << depth << " producers=" << nprod << " consumers=" << ncons << " batch=" << batch;
+
+    QUEUE q(depth);
+    std::atomic<long> received{0};
+
+    Timer timer(os.str());
+
+    std::vector<std::thread> consumers;
+    for (size_t i = 0; i < ncons; ++i) {
+        consumers.emplace_back([&q, &received, batch] {
+            std::vector<long> elems(batch);
+            long n;
+            while ((n = q.pop(elems)) > 0) {
+                received += n;
+            }
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < nprod; ++i) {
+        producers.emplace_back([&q, nprod] {
+            for (long j = 0; j < NMESSAGES / long(nprod); ++j) {
+                q.push(j);
+            }
+        });
+    }
+
+    for (auto& p : producers) {
+        p.join();
+    }
+    q.close();
+    for (auto& c : consumers) {
+        c.join();
+    }
+
+    double elapsed = timer.elapsed();
+    EXPECT(received == long(nprod * (NMESSAGES / nprod)));
+
+    std::cout << os.str() << ": " << long(received / elapsed) << " messages per second" << std::endl;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("benchmark_queue") {
+    for (size_t threads : {1, 4}) {
+        for (size_t batch : {1, 64}) {
+            benchmark_queue<Queue<long>>("Queue<long>", 1024, threads, threads, batch);
+            benchmark_queue<MPMCQueue<long>>("MPMCQueue<long>", 1024, threads, threads, batch);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
@@ -8,7 +8,16 @@
  * does it submit to any jurisdiction.
  */
 
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "eckit/container/BlockedBloomFilter.h"
 #include "eckit/container/BloomFilter.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/log/Log.h"
 #include "eckit/testing/Test.h"
 
 using namespace std;
@@ -33,6 +42,121 @@ CASE("test_eckit_container_bloomfilter_insert") {
     EXPECT(!f.contains("hello there again"));
 }
 
+CASE("test_eckit_container_blockedbloomfilter_insert") {
+
+    BlockedBloomFilter f(1000, 0.01);
+
+    EXPECT(f.empty());
+    EXPECT(f.hashes() == 7);
+    EXPECT(f.bits() >= 9586);
+    EXPECT(!f.contains("hello there"));
+
+    f.insert("hello there");
+    f.insert(std::string("hello again"));
+    f.insert(42);
+
+    EXPECT(f.entries() == 3);
+    EXPECT(f.contains(std::string("hello there")));
+    EXPECT(f.contains("hello again"));
+    EXPECT(f.contains(42));
+    EXPECT(!f.contains("hello there again"));
+    EXPECT(!f.contains(43));
+
+    f.clear();
+    EXPECT(f.empty());
+    EXPECT(!f.contains(42));
+}
+
+CASE("test_eckit_container_blockedbloomfilter_false_positive_rate") {
+
+    const size_t n = 10000;
+
+    std::vector<std::uint64_t> values(n);
+    std::iota(values.begin(), values.end(), 0);
+
+    BlockedBloomFilter f(n, 0.01);
+    f.insert(values.begin(), values.end());
+    EXPECT(f.entries() == n);
+
+    // no false negatives
+    std::unique_ptr<bool[]> found(new bool[n]);
+    f.contains(values.begin(), values.end(), found.get());
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT(found[i]);
+    }
+
+    // false positives, close to the target
+    std::iota(values.begin(), values.end(), n);
+    f.contains(values.begin(), values.end(), found.get());
+
+    size_t falsePositives = 0;
+    for (size_t i = 0; i < n; ++i) {
+        falsePositives += found[i] ? 1 : 0;
+        EXPECT(found[i] == f.contains(values[i]));
+    }
+
+    Log::info() << f << ": false positive rate " << double(falsePositives) / n << " (expected "
+                << f.falsePositiveRate() << ")" << std::endl;
+    EXPECT(falsePositives < 2 * n / 100);
+}
+
+CASE("test_eckit_container_blockedbloomfilter_merge") {
+
+    BlockedBloomFilter a(100);
+    BlockedBloomFilter b(100);
+    BlockedBloomFilter c(1000);
+
+    a.insert("a");
+    b.insert("b");
+
+    a.merge(b);
+    EXPECT(a.contains("a"));
+    EXPECT(a.contains("b"));
+    EXPECT(a.entries() == 2);
+
+    EXPECT_THROWS_AS(a.merge(c), AssertionFailed);
+}
+
+CASE("test_eckit_container_blockedbloomfilter_save") {
+
+    PathName path("test_eckit_container_blockedbloomfilter.blf");
+
+    {
+        BlockedBloomFilter f(1000);
+        for (int i = 0; i < 1000; i += 2) {
+            f.insert(i);
+        }
+        f.save(path);
+    }
+
+    for (bool mapped : {false, true}) {
+        BlockedBloomFilter f(path, mapped);
+        EXPECT(f.mapped() == mapped);
+        EXPECT(f.entries() == 500);
+
+        size_t found = 0;
+        for (int i = 0; i < 1000; ++i) {
+            found += f.contains(i) ? 1 : 0;
+            if (i % 2 == 0) {
+                EXPECT(f.contains(i));
+            }
+        }
+        EXPECT(found < 520);
+
+        if (mapped) {
+            EXPECT_THROWS_AS(f.insert(1), UserError);
+        }
+    }
+
+    path.unlink();
+
+    PathName bad("test_eckit_container_blockedbloomfilter.bad");
+    bad.touch();
+    EXPECT_THROWS(BlockedBloomFilter f(bad));
+    EXPECT_THROWS(BlockedBloomFilter f(bad, true));
+    bad.unlink();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::test
@@ -41,9 +41,14 @@ struct CacheTraits {
         Log::info() << "CacheTraits::load(path='" << path << "')" << std::endl;
         ASSERT(path.exists());
         value = "cached";
+        ++loads;
     }
+
+    static size_t loads;
 };
 
+size_t CacheTraits::loads = 0;
+
 
 struct Manager : eckit::CacheManager<CacheTraits> {
     Manager() :
@@ -159,6 +164,40 @@ CASE("test_cachemanager") {
     EXPECT(!missingPath.exists());
 }
 
+CASE("test_cachemanager_memory") {
+    PathName dir = caching::CacheTraits::name();
+    deldir(dir);
+    EXPECT(!dir.exists());
+
+    using value_t     = caching::CacheTraits::value_type;
+    value_t reference = "cached";
+
+    static caching::Manager cache;
+    cache.memoryCache(1024, [](const value_t& value) { return value.size(); });
+    EXPECT(cache.memoryCache() != nullptr);
+
+    caching::CacheCreator creator;
+    caching::Manager::key_t key = "key";
+
+    value_t created;
+    auto path = cache.getOrCreate(key, creator, created);
+    EXPECT(created == reference);
+    EXPECT(path.exists());
+
+    // served from memory, not loaded from file
+    auto loads = caching::CacheTraits::loads;
+
+    value_t loaded;
+    EXPECT(cache.getOrCreate(key, creator, loaded) == path);
+    EXPECT(loaded == reference);
+    EXPECT(caching::CacheTraits::loads == loads);
+
+    auto stats = cache.memoryCache()->statistics();
+    EXPECT(stats.hits_ == 1);
+    EXPECT(stats.misses_ == 1);
+    EXPECT(cache.memoryCache()->size() == reference.size());
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::test
@@ -0,0 +1,185 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eckit/container/ConcurrentCacheLRU.h"
+#include "eckit/exception/Exceptions.h"
+
+#include "eckit/testing/Test.h"
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+using Cache = ConcurrentCacheLRU<std::string, size_t>;
+
+/// entries weigh their value
+static size_t weight(const std::string&, const size_t& value) {
+    return value;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("test_concurrent_cache_lru_basic") {
+    Cache cache(3);
+
+    EXPECT(cache.size() == 0);
+    EXPECT(cache.capacity() == 3);
+    EXPECT(cache.shards() >= 1);
+
+    EXPECT(!cache.insert("a", 1));
+    EXPECT(!cache.insert("b", 2));
+    EXPECT(cache.insert("b", 22));
+    EXPECT(cache.size() == 2);
+    EXPECT(cache.entries() == 2);
+
+    EXPECT(cache.access("b") == 22);
+    EXPECT_THROWS_AS(cache.access("c"), OutOfRange);
+
+    size_t value = 0;
+    EXPECT(cache.find("a", value));
+    EXPECT(value == 1);
+
+    EXPECT(cache.remove("a"));
+    EXPECT(!cache.remove("a"));
+    EXPECT(!cache.exists("a"));
+
+    cache.clear();
+    EXPECT(cache.size() == 0);
+    EXPECT(cache.entries() == 0);
+
+    auto stats = cache.statistics();
+    EXPECT(stats.hits_ == 2);
+    EXPECT(stats.misses_ == 1);
+    EXPECT(stats.insertions_ == 3);
+    EXPECT(stats.evictions_ == 0);
+    EXPECT(stats.replacements_ == 1);
+}
+
+CASE("test_concurrent_cache_lru_eviction_by_size") {
+    std::vector<std::string> purged;
+    Cache cache(100, weight, 8, [&purged](const std::string& key, size_t&) { purged.push_back(key); });
+
+    // entries spread over the shards, evicted in the order of their use across shards
+
+    cache.insert("a", 40);
+    cache.insert("b", 30);
+    cache.insert("c", 20);
+    EXPECT(cache.size() == 90);
+
+    EXPECT(cache.access("a") == 40);  // b is now the least recently used
+
+    cache.insert("d", 20);
+    EXPECT(cache.size() == 80);
+    EXPECT(!cache.exists("b"));
+    EXPECT(cache.exists("a") && cache.exists("c") && cache.exists("d"));
+    EXPECT(purged == std::vector<std::string>{"b"});
+
+    // a large entry evicts as many entries as needed
+    cache.insert("e", 90);
+    EXPECT(cache.size() == 90);
+    EXPECT(cache.entries() == 1);
+    EXPECT(purged.size() == 4);
+
+    // an entry larger than the capacity is not cached
+    cache.insert("f", 101);
+    EXPECT(!cache.exists("f"));
+    EXPECT(cache.exists("e"));
+
+    EXPECT(cache.statistics().evictions_ == 5);
+
+    // shrinking the capacity evicts
+    cache.capacity(50);
+    EXPECT(cache.size() == 0);
+    EXPECT(purged.size() == 5);
+}
+
+CASE("test_concurrent_cache_lru_get_or_create") {
+    Cache cache(10);
+
+    size_t created = 0;
+    auto create    = [&created]() { return ++created; };
+
+    EXPECT(cache.getOrCreate("a", create) == 1);
+    EXPECT(cache.getOrCreate("a", create) == 1);
+    EXPECT(created == 1);
+
+    // a key cached meanwhile (e.g. by another thread) is kept, and returned
+    EXPECT(cache.getOrCreate("b", [&cache]() {
+        cache.insert("b", 42);
+        return size_t(7);
+    }) == 42);
+    EXPECT(cache.access("b") == 42);
+
+    auto stats = cache.statistics();
+    EXPECT(stats.insertions_ == 2);
+    EXPECT(stats.replacements_ == 0);
+}
+
+CASE("test_concurrent_cache_lru_threads") {
+    using Value = std::shared_ptr<std::vector<char>>;
+
+    const size_t capacity = 64 * 1024;
+    ConcurrentCacheLRU<int, Value> cache(
+        capacity, [](const int&, const Value& v) { return v->size(); }, 4);
+
+    const int nthreads = 8;
+    const int nkeys    = 64;
+
+    std::atomic<size_t> errors{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nthreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 2000; ++i) {
+                int key = (i * 7 + t) % nkeys;
+
+                // values are sized and filled from their key, so they can be checked
+                auto v = cache.getOrCreate(key, [key]() {
+                    return std::make_shared<std::vector<char>>(1024 * (1 + key % 4), char(key));
+                });
+
+                if (v->size() != size_t(1024 * (1 + key % 4)) || (*v)[0] != char(key)) {
+                    ++errors;
+                }
+                if (cache.size() > capacity + nthreads * 4 * 1024) {
+                    ++errors;
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT(errors == 0);
+    EXPECT(cache.size() <= capacity);
+
+    auto stats = cache.statistics();
+    Log::info() << cache << std::endl;
+    EXPECT(stats.hits_ + stats.misses_ == size_t(nthreads * 2000));
+    EXPECT(stats.insertions_ <= stats.misses_);  // concurrent misses of a key insert it once
+    EXPECT(stats.replacements_ == 0);
+    EXPECT(stats.insertions_ - stats.evictions_ == cache.entries());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
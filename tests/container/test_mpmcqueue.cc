@@ -0,0 +1,184 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "eckit/container/MPMCQueue.h"
+#include "eckit/testing/Test.h"
+
+using namespace std;
+using namespace eckit;
+using namespace eckit::testing;
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Capacity is a power of two") {
+    EXPECT(MPMCQueue<int>(1).maxSize() == 2);
+    EXPECT(MPMCQueue<int>(2).maxSize() == 2);
+    EXPECT(MPMCQueue<int>(5).maxSize() == 8);
+    EXPECT(MPMCQueue<int>(1024).maxSize() == 1024);
+}
+
+CASE("Single thread FIFO") {
+    MPMCQueue<std::string> q(4);
+
+    EXPECT(q.empty());
+    EXPECT(q.push("a") == 1);
+    EXPECT(q.emplace(3, 'b') == 2);
+    EXPECT(q.tryPush(std::string("c")));
+    EXPECT(q.tryPush(std::string("d")));
+    EXPECT(!q.tryPush(std::string("e")));
+    EXPECT(q.size() == 4);
+
+    std::string s;
+    EXPECT(q.pop(s) == 3);
+    EXPECT(s == "a");
+    EXPECT(q.pop(s) == 2);
+    EXPECT(s == "bbb");
+
+    std::vector<std::string> batch(10);
+    EXPECT(q.pop(batch) == 2);
+    EXPECT(batch[0] == "c");
+    EXPECT(batch[1] == "d");
+
+    EXPECT(q.empty());
+    EXPECT(!q.tryPop(s));
+
+    // Wraps around the ring
+    for (int i = 0; i < 100; ++i) {
+        q.push(std::to_string(i));
+        q.push(std::to_string(-i));
+        EXPECT(q.pop(s) == 1);
+        EXPECT(s == std::to_string(i));
+        EXPECT(q.pop(s) == 0);
+        EXPECT(s == std::to_string(-i));
+    }
+}
+
+CASE("Close delivers the remaining elements") {
+    MPMCQueue<int> q(8);
+    q.push(1);
+    q.push(2);
+    q.close();
+
+    EXPECT(q.closed());
+    EXPECT_THROWS_AS(q.push(3), AssertionFailed);
+
+    int e = 0;
+    EXPECT(q.pop(e) >= 0);
+    EXPECT(e == 1);
+    EXPECT(q.pop(e) >= 0);
+    EXPECT(e == 2);
+    EXPECT(q.pop(e) == -1);
+}
+
+CASE("Close wakes up blocked consumers") {
+    MPMCQueue<int> q(8);
+    std::vector<std::thread> consumers;
+    std::atomic<int> finished{0};
+    for (int i = 0; i < 4; ++i) {
+        consumers.emplace_back([&] {
+            int e;
+            while (q.pop(e) >= 0) {
+            }
+            finished++;
+        });
+    }
+    q.push(1);
+    q.close();
+    for (auto& c : consumers) {
+        c.join();
+    }
+    EXPECT(finished == 4);
+}
+
+CASE("Interrupt wakes up blocked producers") {
+    MPMCQueue<int> q(2);
+    q.push(1);
+    q.push(2);
+
+    std::atomic<bool> caught{false};
+    std::thread producer([&] {
+        try {
+            q.push(3);
+        }
+        catch (BadValue&) {
+            caught = true;
+        }
+    });
+
+    q.interrupt(std::make_exception_ptr(BadValue("stop")));
+    producer.join();
+
+    EXPECT(caught);
+    EXPECT(q.closed());
+    int e;
+    EXPECT_THROWS_AS(q.pop(e), BadValue);
+}
+
+CASE("Multi Producer Multi Consumer") {
+
+    for (size_t depth : {2, 64}) {
+        MPMCQueue<long> q(depth);
+
+        const long nprod = 13;
+        const long ncons = 7;
+        const long count = 20000;
+
+        std::vector<std::thread> producers;
+        for (long id = 0; id < nprod; ++id) {
+            producers.emplace_back([&q, id] {
+                for (long j = 0; j < count; ++j) {
+                    q.push(id * count + j);
+                }
+            });
+        }
+
+        std::atomic<long> sum{0};
+        std::atomic<long> popped{0};
+        std::vector<std::thread> consumers;
+        for (long id = 0; id < ncons; ++id) {
+            consumers.emplace_back([&q, &sum, &popped, id] {
+                std::vector<long> batch(id % 2 ? 16 : 1);
+                long n;
+                while ((n = q.pop(batch)) > 0) {
+                    for (long i = 0; i < n; ++i) {
+                        sum += batch[i];
+                    }
+                    popped += n;
+                }
+            });
+        }
+
+        for (auto& p : producers) {
+            p.join();
+        }
+        q.close();
+        for (auto& c : consumers) {
+            c.join();
+        }
+
+        const long total = nprod * count;
+        EXPECT(popped == total);
+        EXPECT(sum == total * (total - 1) / 2);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
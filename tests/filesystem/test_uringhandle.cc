@@ -0,0 +1,210 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "eckit/config/Resource.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/io/AutoCloser.h"
+#include "eckit/io/Buffer.h"
+#include "eckit/io/FileHandle.h"
+#include "eckit/io/URingHandle.h"
+#include "eckit/log/Log.h"
+#include "eckit/testing/Test.h"
+
+using namespace std;
+using namespace eckit;
+using namespace eckit::testing;
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Byte at offset of the test files, which differs from block to block, so that data out of place is detected
+char byteAt(size_t offset) {
+    return static_cast<char>((offset * 131 + offset / 4093) % 251);
+}
+
+class TestURing {
+public:
+    TestURing() {
+        std::string base = Resource<std::string>("$TMPDIR", "/tmp");
+        path_            = PathName::unique(base + "/file") + ".dat";
+        reference_       = PathName::unique(base + "/reference") + ".dat";
+
+        std::unique_ptr<DataHandle> fh(reference_.fileHandle());
+        auto close = closer(*fh);
+        writeTo(*fh);
+    }
+
+    /// Writes the test data, in writes of various sizes, smaller and larger than the blocks of the handles tested
+    size_t writeTo(DataHandle& dh) {
+        std::vector<char> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = byteAt(i);
+        }
+
+        dh.openForWrite(0);
+
+        const size_t sizes[] = {1, 4093, 100000, 65536, 777, 1024 * 1024};
+        size_t total         = 0;
+
+        for (size_t k = 0; total < size; ++k) {
+            long len = long(std::min(sizes[k % std::size(sizes)], size - total));
+            total += dh.write(data.data() + total, len);
+        }
+
+        dh.close();
+
+        return total;
+    }
+
+    static constexpr size_t size = 10 * 1024 * 1024 + 12345;
+
+    bool verify() {
+        std::unique_ptr<DataHandle> fh(path_.fileHandle());
+        std::unique_ptr<DataHandle> rh(reference_.fileHandle());
+        return rh->compare(*fh);
+    }
+
+    ~TestURing() {
+        if (path_.exists()) {
+            path_.unlink();
+        }
+        reference_.unlink();
+    }
+
+    PathName path_;
+    PathName reference_;
+};
+
+CASE("Write to a new file") {
+
+    TestURing test;
+
+    SECTION("Single write") {
+        std::unique_ptr<DataHandle> rh(test.reference_.fileHandle());
+        std::unique_ptr<DataHandle> uh(new URingHandle(test.path_));
+        rh->saveInto(*uh);
+        EXPECT(test.verify());
+    }
+
+    SECTION("Multiple writes") {
+        std::unique_ptr<DataHandle> uh(new URingHandle(test.path_, 4, 64 * 1024));
+        test.writeTo(*uh);
+        EXPECT(test.verify());
+    }
+
+    SECTION("Direct I/O") {
+        std::unique_ptr<DataHandle> uh(new URingHandle(test.path_, 8, 256 * 1024, true));
+        test.writeTo(*uh);
+        EXPECT(test.verify());
+    }
+
+    SECTION("Append") {
+        long long full = test.reference_.size();
+        long long half = full / 2;
+        {
+            std::unique_ptr<DataHandle> rh(test.reference_.fileHandle());
+            std::unique_ptr<DataHandle> fh(test.path_.fileHandle());
+            rh->copyTo(*fh, 1024 * 1024, Length(half));
+        }
+
+        Buffer buffer(size_t(full - half));
+        {
+            std::unique_ptr<DataHandle> rh(test.reference_.fileHandle());
+            rh->openForRead();
+            AutoClose closer(*rh);
+            rh->seek(half);
+            EXPECT(rh->read(buffer, buffer.size()) == long(buffer.size()));
+        }
+
+        URingHandle uh(test.path_, 4, 64 * 1024);
+        uh.openForAppend(0);
+        EXPECT(uh.position() == Offset(half));
+        EXPECT(uh.write(buffer, buffer.size()) == long(buffer.size()));
+        uh.close();
+
+        EXPECT(test.verify());
+    }
+}
+
+CASE("Read from a file") {
+
+    TestURing test;
+
+    SECTION("Read all") {
+        std::unique_ptr<DataHandle> uh(new URingHandle(test.reference_, 4, 64 * 1024));
+        std::unique_ptr<DataHandle> fh(test.path_.fileHandle());
+        uh->saveInto(*fh);
+        EXPECT(test.verify());
+    }
+
+    SECTION("Direct I/O") {
+        std::unique_ptr<DataHandle> uh(new URingHandle(test.reference_, 4, 64 * 1024, true));
+        std::unique_ptr<DataHandle> fh(test.reference_.fileHandle());
+        EXPECT(uh->compare(*fh));
+    }
+
+    SECTION("Seek") {
+        URingHandle uh(test.reference_, 4, 64 * 1024);
+        long long size = uh.openForRead();
+        AutoClose closer(uh);
+
+        EXPECT(uh.canSeek());
+        EXPECT(size == (long long)test.reference_.size());
+
+        char buf[1000];
+        for (size_t offset : {89010UL, 277UL, 10412999UL, 0UL, 445010UL, TestURing::size - sizeof(buf)}) {
+            EXPECT(uh.seek(offset) == Offset(offset));
+            EXPECT(uh.read(buf, sizeof(buf)) == long(sizeof(buf)));
+            for (size_t i = 0; i < sizeof(buf); ++i) {
+                EXPECT(buf[i] == byteAt(offset + i));
+            }
+        }
+
+        uh.seek(size);
+        EXPECT(uh.read(buf, sizeof(buf)) == 0);
+    }
+
+    SECTION("Read errors") {
+        // reading a directory fails (EISDIR), the error must be reported rather than a short read
+        std::string base = Resource<std::string>("$TMPDIR", "/tmp");
+        PathName dir     = PathName::unique(base + "/dir");
+        dir.mkdir();
+
+        {
+            URingHandle uh(dir, 4, 64 * 1024);
+            long long size = uh.openForRead();
+            AutoClose closer(uh);
+
+            char buf[1000];
+            if (size > 0) {
+                EXPECT_THROWS_AS(uh.read(buf, sizeof(buf)), FailedSystemCall);
+
+                // the failed buffer is released, and reused
+                uh.seek(0);
+                EXPECT_THROWS_AS(uh.read(buf, sizeof(buf)), FailedSystemCall);
+            }
+        }
+
+        dir.rmdir();
+    }
+}
+
+}  // namespace eckit::test
+
+//----------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
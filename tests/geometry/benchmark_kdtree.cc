@@ -0,0 +1,143 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "eckit/container/KDTree.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/geometry/Point3.h"
+#include "eckit/log/Timer.h"
+
+#include "eckit/testing/Test.h"
+
+using namespace eckit;
+using namespace eckit::testing;
+using namespace eckit::geometry;
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+#define NPOINTS 500000
+#define NQUERIES 200000
+
+struct TreeTraits {
+    typedef Point3 Point;
+    typedef size_t Payload;
+};
+
+using Value = SPValue<TreeTraits>;
+
+/// Points on the unit sphere, as the grids searched when interpolating
+std::vector<Point3> sphere(size_t n, unsigned int seed) {
+    std::vector<Point3> points;
+    points.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        seed        = seed * 1103515245 + 12345;
+        double lon  = double(seed % 3600000) / 10000. * M_PI / 180.;
+        seed        = seed * 1103515245 + 12345;
+        double z    = double(seed % 2000001) / 1000000. - 1.;
+        double r    = std::sqrt(1. - z * z);
+        points.emplace_back(r * std::cos(lon), r * std::sin(lon), z);
+    }
+    return points;
+}
+
+template <typename Tree>
+void benchmark(const std::string& name, Tree& tree, const std::vector<Point3>& queries, size_t& checksum) {
+    size_t sum = 0;
+
+    double nn = 0;
+    {
+        Timer timer(name + ": nearest neighbour", Log::debug());
+        for (const auto& q : queries) {
+            sum += tree.nearestNeighbour(q).payload();
+        }
+        nn = timer.elapsed();
+    }
+
+    double knn = 0;
+    {
+        Timer timer(name + ": 4-nearest neighbours", Log::debug());
+        for (const auto& q : queries) {
+            sum += tree.kNearestNeighbours(q, 4).front().payload();
+        }
+        knn = timer.elapsed();
+    }
+
+    Log::info() << name << ": " << size_t(double(queries.size()) / nn) << " nearest neighbour queries/s, "
+                << size_t(double(queries.size()) / knn) << " 4-nearest neighbours queries/s" << std::endl;
+
+    if (checksum == 0) {
+        checksum = sum;
+    }
+    EXPECT(sum == checksum);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("benchmark_kdtree_layouts") {
+    std::vector<Value> values;
+    size_t i = 0;
+    for (const auto& p : sphere(NPOINTS, 1)) {
+        values.emplace_back(p, i++);
+    }
+
+    const auto queries = sphere(NQUERIES, 2);
+
+    // the trees are the same (the same values, partitioned the same way), only their layout differs
+    size_t checksum = 0;
+
+    {
+        KDTreeMemory<TreeTraits> tree;
+        auto v = values;
+        tree.build(v);
+        benchmark("KDTreeMemory", tree, queries, checksum);
+    }
+
+    for (auto layout : {KDLayout::PreOrder, KDLayout::BreadthFirst, KDLayout::VanEmdeBoas}) {
+        static const char* names[] = {"pre-order", "breadth-first", "van Emde Boas"};
+
+        KDTreeFlat<TreeTraits> tree;
+        auto v = values;
+        tree.build(v, layout);
+        benchmark(std::string("KDTreeFlat, ") + names[static_cast<int>(layout)], tree, queries, checksum);
+    }
+
+    {
+        PathName path("benchmark_kdtree_layouts.kdtree");
+
+        auto v = values;
+        KDTreeMapped<TreeTraits>::write(path, v);
+        {
+            KDTreeMapped<TreeTraits> tree(path, 0, 0);
+            benchmark("KDTreeMapped", tree, queries, checksum);
+        }
+
+        v = values;
+        KDTreeMappedFlat<TreeTraits>::write(path, v);
+        {
+            KDTreeMappedFlat<TreeTraits> tree(path, 0, 0);
+            benchmark("KDTreeMappedFlat, van Emde Boas", tree, queries, checksum);
+        }
+
+        path.unlink();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
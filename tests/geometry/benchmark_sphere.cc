@@ -0,0 +1,162 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "eckit/geometry/Point2.h"
+#include "eckit/geometry/Point3.h"
+#include "eckit/geometry/UnitSphere.h"
+#include "eckit/log/Timer.h"
+
+#include "eckit/testing/Test.h"
+
+using namespace eckit;
+using namespace eckit::testing;
+using namespace eckit::geometry;
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+#define NPOINTS 2000000
+
+template <typename F>
+double time(const std::string& name, F f) {
+    Timer timer(name, Log::debug());
+    f();
+    return timer.elapsed();
+}
+
+void report(const std::string& name, double scalar, double batch, double threaded) {
+    Log::info() << name << ": " << size_t(NPOINTS / scalar) << " points/s (scalar), " << size_t(NPOINTS / batch)
+                << " points/s (batch), " << size_t(NPOINTS / threaded) << " points/s (batch, threaded)" << std::endl;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("benchmark_sphere") {
+    // a regular grid, as converted and measured per field
+    std::vector<double> lon(NPOINTS);
+    std::vector<double> lat(NPOINTS);
+    const auto nlon = size_t(std::sqrt(2. * NPOINTS));
+    for (size_t i = 0; i < NPOINTS; ++i) {
+        lon[i] = 360. * double(i % nlon) / double(nlon);
+        lat[i] = 90. - 180. * double(i / nlon) / double(NPOINTS / nlon);
+    }
+
+    std::vector<double> x(NPOINTS), y(NPOINTS), z(NPOINTS), d(NPOINTS), e(NPOINTS);
+    const Point2 A(-71.6, -33.);
+    const Point2 B(121.8, 31.4);
+
+    {
+        const double scalar = time("convertSphericalToCartesian (scalar)", [&]() {
+            Point3 p;
+            for (size_t i = 0; i < NPOINTS; ++i) {
+                UnitSphere::convertSphericalToCartesian(Point2(lon[i], lat[i]), p);
+                d[i] = p[0];
+            }
+        });
+
+        const double batch = time("convertSphericalToCartesian (batch)", [&]() {
+            UnitSphere::convertSphericalToCartesian(NPOINTS, lon.data(), lat.data(), x.data(), y.data(), z.data(), 0.,
+                                                    false, 1);
+        });
+
+        const double threaded = time("convertSphericalToCartesian (batch, threaded)", [&]() {
+            UnitSphere::convertSphericalToCartesian(NPOINTS, lon.data(), lat.data(), x.data(), y.data(), z.data());
+        });
+
+        report("convertSphericalToCartesian", scalar, batch, threaded);
+
+        for (size_t i = 0; i < NPOINTS; i += 997) {
+            EXPECT(types::is_approximately_equal(d[i], x[i], 1e-14));
+        }
+    }
+
+    {
+        std::vector<double> lon2(NPOINTS), lat2(NPOINTS);
+
+        const double scalar = time("convertCartesianToSpherical (scalar)", [&]() {
+            Point2 q;
+            for (size_t i = 0; i < NPOINTS; ++i) {
+                UnitSphere::convertCartesianToSpherical(Point3(x[i], y[i], z[i]), q);
+                d[i] = q[1];
+            }
+        });
+
+        const double batch = time("convertCartesianToSpherical (batch)", [&]() {
+            UnitSphere::convertCartesianToSpherical(NPOINTS, x.data(), y.data(), z.data(), lon2.data(), lat2.data(), 1);
+        });
+
+        const double threaded = time("convertCartesianToSpherical (batch, threaded)", [&]() {
+            UnitSphere::convertCartesianToSpherical(NPOINTS, x.data(), y.data(), z.data(), lon2.data(), lat2.data());
+        });
+
+        report("convertCartesianToSpherical", scalar, batch, threaded);
+
+        for (size_t i = 0; i < NPOINTS; i += 997) {
+            EXPECT(d[i] == lat2[i]);
+        }
+    }
+
+    {
+        const double scalar = time("distance (scalar)", [&]() {
+            for (size_t i = 0; i < NPOINTS; ++i) {
+                d[i] = UnitSphere::distance(A, Point2(lon[i], lat[i]));
+            }
+        });
+
+        const double batch = time("distance (batch)", [&]() {
+            UnitSphere::distance(A, NPOINTS, lon.data(), lat.data(), e.data(), 1);
+        });
+
+        const double threaded = time("distance (batch, threaded)", [&]() {
+            UnitSphere::distance(A, NPOINTS, lon.data(), lat.data(), e.data());
+        });
+
+        report("distance", scalar, batch, threaded);
+
+        for (size_t i = 0; i < NPOINTS; i += 997) {
+            EXPECT(types::is_approximately_equal(d[i], e[i], 1e-14));
+        }
+    }
+
+    {
+        const double scalar = time("greatCircleLatitudeGivenLongitude (scalar)", [&]() {
+            for (size_t i = 0; i < NPOINTS; ++i) {
+                d[i] = UnitSphere::greatCircleLatitudeGivenLongitude(A, B, lon[i]);
+            }
+        });
+
+        const double batch = time("greatCircleLatitudeGivenLongitude (batch)", [&]() {
+            UnitSphere::greatCircleLatitudeGivenLongitude(A, B, NPOINTS, lon.data(), e.data(), 1);
+        });
+
+        const double threaded = time("greatCircleLatitudeGivenLongitude (batch, threaded)", [&]() {
+            UnitSphere::greatCircleLatitudeGivenLongitude(A, B, NPOINTS, lon.data(), e.data());
+        });
+
+        report("greatCircleLatitudeGivenLongitude", scalar, batch, threaded);
+
+        for (size_t i = 0; i < NPOINTS; i += 997) {
+            EXPECT(types::is_approximately_equal(d[i], e[i], 1e-12));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
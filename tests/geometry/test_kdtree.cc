@@ -10,6 +10,7 @@
 
 #include <list>
 
+#include "eckit/container/KDBuckets.h"
 #include "eckit/container/KDTree.h"
 #include "eckit/geometry/Point2.h"
 #include "eckit/os/Semaphore.h"
@@ -354,6 +355,254 @@ CASE("test_kdtree_mapped") {
     }
 }
 
+CASE("test_kdtree_build_parallel") {
+    using Tree  = KDTreeMemory<TestTreeTrait>;
+    using Point = Tree::PointType;
+
+    // more points than a task partitions on its own
+    std::vector<Tree::Value> points;
+    unsigned int seed = 1;
+    for (size_t i = 0; i < 200000; i++) {
+        seed = seed * 1103515245 + 12345;
+        double x = double(seed % 100000);
+        seed = seed * 1103515245 + 12345;
+        double y = double(seed % 100000);
+        points.emplace_back(Point(x, y), double(i));
+    }
+
+    auto serial   = points;
+    auto parallel = points;
+
+    Tree kd;
+    kd.build(serial);
+
+    Tree kdp;
+    kdp.buildParallel(parallel, 4);
+    EXPECT_EQUAL(kdp.size(), points.size());
+
+    // same reordering, so same tree
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT(serial[i].payload() == parallel[i].payload());
+    }
+
+    for (size_t i = 0; i < points.size(); i += 997) {
+        Point p = Point::add(points[i].point(), Point(0.1, 0.1));
+        EXPECT(kd.nearestNeighbour(p).payload() == kdp.nearestNeighbour(p).payload());
+        EXPECT(kdp.nearestNeighbour(p).point() == kd.nearestNeighbour(p).point());
+    }
+
+    // streamed directly into the layout of a mapped tree
+    using Mapped = KDTreeMapped<TestTreeTrait>;
+
+    eckit::PathName path("test_kdtree_build_parallel.kdtree");
+    if (path.exists()) {
+        path.unlink();
+    }
+
+    auto streamed = points;
+    Mapped::write(path, streamed, 4);
+
+    {
+        Mapped kdm(path, 0, 0);
+        EXPECT_EQUAL(kdm.size(), points.size());
+
+        for (size_t i = 0; i < points.size(); i += 997) {
+            Point p = Point::add(points[i].point(), Point(0.1, 0.1));
+            EXPECT(kd.nearestNeighbour(p).payload() == kdm.nearestNeighbour(p).payload());
+
+            auto knn  = kd.kNearestNeighbours(p, 5);
+            auto knnm = kdm.kNearestNeighbours(p, 5);
+            EXPECT_EQUAL(knn.size(), knnm.size());
+            for (size_t j = 0; j < knn.size(); ++j) {
+                EXPECT(knn[j].payload() == knnm[j].payload());
+            }
+        }
+
+        // nodes linked in the same order as those of the built tree
+        std::vector<double> order;
+        for (auto& item : kd) {
+            order.push_back(item.payload());
+        }
+
+        size_t count = 0;
+        for (auto& item : kdm) {
+            EXPECT(count < order.size() && item.payload() == order[count]);
+            count++;
+        }
+        EXPECT_EQUAL(count, points.size());
+    }
+
+    path.unlink();
+}
+
+CASE("test_kdbuckets") {
+    using Tree    = KDTreeMemory<TestTreeTrait>;
+    using Buckets = KDBuckets<TestTreeTrait>;
+    using Point   = Tree::PointType;
+
+    // more points than a task partitions on its own
+    std::vector<Tree::Value> points;
+    unsigned int seed = 1;
+    for (size_t i = 0; i < 100000; i++) {
+        seed = seed * 1103515245 + 12345;
+        double x = double(seed % 10000) / 100.;
+        seed = seed * 1103515245 + 12345;
+        double y = double(seed % 10000) / 100.;
+        points.emplace_back(Point(x, y), double(i));
+    }
+
+    Buckets buckets(16);
+    buckets.build(points, 2);
+    EXPECT(buckets.size() == points.size());
+
+    Tree kd;
+    auto copy = points;
+    kd.build(copy);
+
+    std::vector<Point> queries;
+    for (size_t i = 0; i < 1000; i++) {
+        seed = seed * 1103515245 + 12345;
+        double x = double(seed % 10000) / 100.;
+        seed = seed * 1103515245 + 12345;
+        double y = double(seed % 10000) / 100.;
+        queries.emplace_back(x, y);
+    }
+
+    std::vector<Buckets::ResultList> knn;
+    buckets.kNearestNeighbours(queries.data(), queries.size(), 4, knn, 2);
+    EXPECT_EQUAL(knn.size(), queries.size());
+
+    std::vector<Buckets::ResultList> sphere;
+    buckets.findInSphere(queries.data(), queries.size(), 2., sphere, 2);
+    EXPECT_EQUAL(sphere.size(), queries.size());
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        // same distances as the tree (the points may differ between equidistant ones)
+        auto expected = kd.kNearestNeighbours(queries[i], 4);
+        EXPECT_EQUAL(knn[i].size(), expected.size());
+        for (size_t j = 0; j < expected.size(); ++j) {
+            EXPECT(knn[i][j].distance_ == expected[j].distance());
+            EXPECT(Point::distance(buckets.point(knn[i][j].index_), queries[i]) == knn[i][j].distance_);
+        }
+
+        auto inSphere = kd.findInSphere(queries[i], 2.);
+        EXPECT_EQUAL(sphere[i].size(), inSphere.size());
+        for (size_t j = 0; j < inSphere.size(); ++j) {
+            EXPECT(sphere[i][j].distance_ == inSphere[j].distance());
+        }
+    }
+
+    // single query, same as the batch
+    Buckets::ResultList result;
+    buckets.kNearestNeighbours(queries[0], 4, result);
+    EXPECT_EQUAL(result.size(), knn[0].size());
+    EXPECT(result[0].index_ == knn[0][0].index_);
+    EXPECT(buckets.payload(result[0].index_) == kd.nearestNeighbour(queries[0]).payload());
+}
+
+CASE("test_kdtree_flat") {
+    using Tree  = KDTreeMemory<TestTreeTrait>;
+    using Flat  = KDTreeFlat<TestTreeTrait>;
+    using Point = Tree::PointType;
+
+    std::vector<Tree::Value> points;
+    unsigned int seed = 1;
+    for (size_t i = 0; i < 10000; i++) {
+        seed = seed * 1103515245 + 12345;
+        double x = double(seed % 100000) / 1000.;
+        seed = seed * 1103515245 + 12345;
+        double y = double(seed % 100000) / 1000.;
+        points.emplace_back(Point(x, y), double(i));
+    }
+
+    Tree kd;
+    auto copy = points;
+    kd.build(copy);
+
+    std::vector<Point> queries;
+    for (size_t i = 0; i < points.size(); i += 97) {
+        queries.push_back(Point::add(points[i].point(), Point(0.01, -0.02)));
+    }
+
+    // same tree, in another layout: same results
+    auto same = [&](auto& tree) {
+        EXPECT(tree.size() == points.size());
+        for (const auto& q : queries) {
+            EXPECT(tree.nearestNeighbour(q).payload() == kd.nearestNeighbour(q).payload());
+
+            auto knn      = tree.kNearestNeighbours(q, 6);
+            auto expected = kd.kNearestNeighbours(q, 6);
+            EXPECT_EQUAL(knn.size(), expected.size());
+            for (size_t j = 0; j < knn.size(); ++j) {
+                EXPECT(knn[j].payload() == expected[j].payload());
+            }
+
+            EXPECT(tree.findInSphere(q, 0.5).size() == kd.findInSphere(q, 0.5).size());
+        }
+    };
+
+    for (auto layout : {KDLayout::PreOrder, KDLayout::BreadthFirst, KDLayout::VanEmdeBoas}) {
+        Flat flat;
+        auto values = points;
+        flat.build(values, layout);
+        same(flat);
+
+        size_t count = 0;
+        for (auto& item : flat) {
+            static_cast<void>(item);
+            count++;
+        }
+        EXPECT_EQUAL(count, points.size());
+    }
+
+    // rebuilt, smaller then larger
+    {
+        Flat flat;
+        auto values = points;
+        flat.build(values);
+
+        std::vector<Tree::Value> fewer(points.begin(), points.begin() + 100);
+        flat.build(fewer);
+        EXPECT(flat.size() == fewer.size());
+        for (const auto& v : fewer) {
+            EXPECT(flat.nearestNeighbour(v.point()).payload() == v.payload());
+        }
+
+        std::vector<Tree::Value> none;
+        flat.build(none);
+        EXPECT(flat.empty());
+
+        values = points;
+        flat.build(values);
+        same(flat);
+    }
+
+    // room for insertions
+    {
+        Flat flat(points.size() + 1);
+        auto values = points;
+        flat.build(values);
+        flat.insert(Tree::Value(Point(-1., -1.), -1.));
+        EXPECT(flat.size() == points.size() + 1);
+        EXPECT(flat.nearestNeighbour(Point(-2., -2.)).payload() == -1.);
+        EXPECT_THROWS_AS(flat.insert(Tree::Value(Point(-1., -1.), -2.)), eckit::AssertionFailed);
+    }
+
+    // mapped
+    {
+        using Mapped = KDTreeMappedFlat<TestTreeTrait>;
+        eckit::PathName path("test_kdtree_flat.kdtree");
+
+        auto values = points;
+        Mapped::write(path, values);
+
+        Mapped mapped(path, 0, 0);
+        same(mapped);
+
+        path.unlink();
+    }
+}
+
 CASE("test_kdtree_iterate_empty") {
     using Tree = KDTreeMemory<TestTreeTrait>;
 
@@ -8,12 +8,17 @@
  * does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
 #include <vector>
 
+#include "eckit/geometry/CoordinateHelpers.h"
 #include "eckit/geometry/Point2.h"
 #include "eckit/geometry/polygon/LonLatPolygon.h"
 #include "eckit/geometry/polygon/Polygon.h"
 #include "eckit/testing/Test.h"
+#include "eckit/types/FloatCompare.h"
 
 namespace eckit::test {
 
@@ -379,6 +384,146 @@ CASE("LonLatPolygon") {
             EXPECT(counts[i + 9] == 1);
         }
     }
+
+    SECTION("Contains many points") {
+        // jagged ring around (10, 20), between radii 20 and 30 (in degrees)
+        constexpr size_t N = 3000;
+        std::vector<Polygon::value_type> points;
+        for (size_t i = 0; i <= N; ++i) {
+            const double a = 2. * M_PI * static_cast<double>(i % N) / static_cast<double>(N);
+            const double r = i % 2 == 0 ? 30. : 20.;
+            points.emplace_back(10. + r * std::cos(a), 20. + r * std::sin(a));
+        }
+        Polygon poly(points);
+
+        std::vector<Polygon::value_type> grid(points.begin(), points.end());
+        for (double lat = -90; lat <= 90; lat += 0.5) {
+            for (double lon = -180; lon < 180; lon += 0.5) {
+                grid.emplace_back(lon, lat);
+            }
+        }
+
+        std::unique_ptr<bool[]> result(new bool[grid.size()]);
+        for (size_t threads : {1, 4}) {
+            poly.contains(grid.data(), grid.size(), result.get(), false, threads);
+
+            for (size_t i = 0; i < grid.size(); ++i) {
+                EXPECT(result[i] == poly.contains(grid[i]));
+
+                const double r = std::hypot(grid[i][0] - 10., grid[i][1] - 20.);
+                if (r < 19.9) {
+                    EXPECT(result[i]);
+                }
+                if (r > 30.1) {
+                    EXPECT_NOT(result[i]);
+                }
+            }
+
+            // vertices are on the polygon
+            EXPECT(std::all_of(result.get(), result.get() + points.size(), [](bool b) { return b; }));
+        }
+
+        const std::vector<Polygon::value_type> invalid{{0, 0}, {0, 100}};
+        EXPECT_THROWS_AS(poly.contains(invalid.data(), invalid.size(), result.get()), eckit::BadValue);
+    }
+}
+
+/// Point-in-polygon test as LonLatPolygon::contains did before its edges were indexed by latitude band: the winding
+/// number over all the edges, one at a time
+bool containsBruteForce(const geometry::polygon::LonLatPolygon& poly, const geometry::Point2& P, bool includePoles) {
+    auto eq = [](double a, double b) { return types::is_approximately_equal(a, b, 1e-10); };
+    auto ge = [&eq](double a, double b) { return a >= b || eq(a, b); };
+    auto on = [](double a, double b, double c) { return a <= b && b <= c ? 1 : c <= b && b <= a ? -1 : 0; };
+
+    const auto& min = poly.min();
+    const auto& max = poly.max();
+
+    const auto p = geometry::canonicaliseOnSphere(P, min[0]);
+    auto lon     = p[0];
+    auto lat     = p[1];
+
+    if (includePoles && ((eq(max[1], 90) && eq(lat, 90)) || (eq(min[1], -90) && eq(lat, -90)))) {
+        return true;
+    }
+    if (!ge(lat, min[1]) || !ge(max[1], lat)) {
+        return false;
+    }
+    if (ge(360, max[0] - min[0]) && (!ge(lon, min[0]) || !ge(max[0], lon))) {
+        return false;
+    }
+
+    do {
+        int wn   = 0;
+        int prev = 0;
+        for (size_t i = 1; i < poly.size(); ++i) {
+            const auto& A = poly[i - 1];
+            const auto& B = poly[i];
+
+            const auto direction = on(A[1], lat, B[1]);
+            if (direction != 0) {
+                const auto cross = (lon - B[0]) * (A[1] - B[1]) - (lat - B[1]) * (A[0] - B[0]);
+                const auto side  = eq(cross, 0) ? 0 : cross > 0 ? 1 : -1;
+                if (side == 0 && on(A[0], lon, B[0]) != 0) {
+                    return true;
+                }
+                if ((prev != 1 && direction > 0 && side > 0) || (prev != -1 && direction < 0 && side < 0)) {
+                    prev = direction;
+                    wn += direction;
+                }
+            }
+        }
+        if (wn != 0) {
+            return true;
+        }
+        lon += 360;
+    } while (lon <= max[0]);
+
+    return false;
+}
+
+CASE("LonLatPolygon contains as the brute-force edge loop") {
+    using Polygon = geometry::polygon::LonLatPolygon;
+
+    // jagged ring, with many edges (and latitude bands)
+    std::vector<Polygon::value_type> ring;
+    constexpr size_t N = 500;
+    for (size_t i = 0; i <= N; ++i) {
+        const double a = 2. * M_PI * static_cast<double>(i % N) / static_cast<double>(N);
+        const double r = i % 2 == 0 ? 30. : 20.;
+        ring.emplace_back(10. + r * std::cos(a), 20. + r * std::sin(a));
+    }
+
+    const std::vector<std::vector<Polygon::value_type>> polygons{
+        {{0, 0}, {10, 0}, {10, 10}, {0, 10}, {0, 0}},
+        {{0, 0}, {361, 0}, {361, 2}, {0, 2}, {0, 0}},
+        {{-1, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}},
+        {{-1, 89}, {1, 89}, {0, 90}, {181, 89}, {179, 89}, {0, 90}, {-1, 89}},
+        {{0, -90}, {60, -45}, {120, -90}, {120, 90}, {60, 45}, {0, 90}, {0, -90}},
+        ring,
+    };
+
+    // n.b. on the vertices and edges of the polygons above, as well as between them
+    std::vector<Polygon::value_type> points;
+    for (double lat = -90; lat <= 90; lat += 1) {
+        for (double lon = -360; lon <= 720; lon += 2.5) {
+            points.emplace_back(lon, lat);
+        }
+    }
+    points.insert(points.end(), ring.begin(), ring.end());
+
+    std::unique_ptr<bool[]> result(new bool[points.size()]);
+    for (const auto& vertices : polygons) {
+        for (bool includePoles : {true, false}) {
+            Polygon poly(vertices, includePoles);
+            poly.contains(points.data(), points.size(), result.get());
+
+            for (size_t i = 0; i < points.size(); ++i) {
+                const bool expected = containsBruteForce(poly, points[i], includePoles);
+                EXPECT(poly.contains(points[i]) == expected);
+                EXPECT(result[i] == expected);
+            }
+        }
+    }
 }
 
 }  // namespace eckit::test
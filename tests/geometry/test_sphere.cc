@@ -10,6 +10,7 @@
 
 #include <cmath>
 #include <limits>
+#include <vector>
 
 #include "eckit/geometry/Point2.h"
 #include "eckit/geometry/Point3.h"
@@ -321,6 +322,95 @@ CASE("test two units sphere sub areas") {
     EXPECT(4. * sub_area_sphere_1 == sub_area_sphere_2);
 }
 
+// -----------------------------------------------------------------------------
+// test batch versions against the single point versions
+
+CASE("test unit sphere batch") {
+    std::vector<double> lon;
+    std::vector<double> lat;
+    for (double la = -90.; la <= 90.; la += 2.5) {
+        for (double lo = -360.; lo <= 720.; lo += 7.5) {
+            lon.push_back(lo);
+            lat.push_back(la);
+        }
+    }
+
+    const size_t n = lon.size();
+    std::vector<double> x(n), y(n), z(n), lon2(n), lat2(n), d(n);
+
+    const PointLonLat P1(-71.6, -33.);  // Valparaíso
+    const double eps = 1e-14;
+
+    for (size_t threads : {1, 4}) {
+        SECTION("convert spherical to Cartesian and back") {
+            UnitSphere::convertSphericalToCartesian(n, lon.data(), lat.data(), x.data(), y.data(), z.data(), 0., false,
+                                                    threads);
+            UnitSphere::convertCartesianToSpherical(n, x.data(), y.data(), z.data(), lon2.data(), lat2.data(), threads);
+
+            for (size_t i = 0; i < n; ++i) {
+                PointXYZ p;
+                UnitSphere::convertSphericalToCartesian(PointLonLat(lon[i], lat[i]), p);
+                EXPECT(types::is_approximately_equal(x[i], p.x(), eps));
+                EXPECT(types::is_approximately_equal(y[i], p.y(), eps));
+                EXPECT(types::is_approximately_equal(z[i], p.z(), eps));
+
+                PointLonLat q(0., 0.);
+                UnitSphere::convertCartesianToSpherical(p, q);
+                EXPECT(types::is_approximately_equal(lat2[i], q.lat(), 1e-12));
+                if (std::abs(q.lat()) < 90.) {
+                    EXPECT(types::is_approximately_equal(lon2[i], q.lon(), 1e-12));
+                }
+            }
+
+            // poles and quadrants are exact
+            const double lon3[] = {0., 90., 180., 270., -90.};
+            const double lat3[] = {90., 0., 0., 0., -90.};
+            UnitSphere::convertSphericalToCartesian(5, lon3, lat3, x.data(), y.data(), z.data());
+            EXPECT(x[0] == 0. && y[0] == 0. && z[0] == 1.);
+            EXPECT(x[1] == 0. && y[1] == 1. && z[1] == 0.);
+            EXPECT(x[2] == -1. && y[2] == 0. && z[2] == 0.);
+            EXPECT(x[3] == 0. && y[3] == -1. && z[3] == 0.);
+            EXPECT(x[4] == 0. && y[4] == 0. && z[4] == -1.);
+
+            const double invalid[] = {100.};
+            EXPECT_THROWS_AS(UnitSphere::convertSphericalToCartesian(1, lon3, invalid, x.data(), y.data(), z.data()),
+                             BadValue);
+        }
+
+        SECTION("distances") {
+            TwoUnitsSphere::distance(P1, n, lon.data(), lat.data(), d.data(), threads);
+            for (size_t i = 0; i < n; ++i) {
+                EXPECT(types::is_approximately_equal(d[i], TwoUnitsSphere::distance(P1, PointLonLat(lon[i], lat[i])),
+                                                     eps));
+            }
+
+            PointXYZ A;
+            TwoUnitsSphere::convertSphericalToCartesian(P1, A);
+            TwoUnitsSphere::convertSphericalToCartesian(n, lon.data(), lat.data(), x.data(), y.data(), z.data());
+            TwoUnitsSphere::distance(A, n, x.data(), y.data(), z.data(), d.data(), threads);
+            for (size_t i = 0; i < n; ++i) {
+                PointXYZ B;
+                TwoUnitsSphere::convertSphericalToCartesian(PointLonLat(lon[i], lat[i]), B);
+                EXPECT(types::is_approximately_equal(d[i], TwoUnitsSphere::distance(A, B), 1e-7));
+            }
+        }
+
+        SECTION("great circle latitudes") {
+            const PointLonLat P2(121.8, 31.4);  // Shanghai
+            UnitSphere::greatCircleLatitudeGivenLongitude(P1, P2, n, lon.data(), d.data(), threads);
+            for (size_t i = 0; i < n; ++i) {
+                const double expected = UnitSphere::greatCircleLatitudeGivenLongitude(P1, P2, lon[i]);
+                EXPECT(types::is_approximately_equal(d[i], expected, 1e-12));
+            }
+
+            // crossing the poles
+            UnitSphere::greatCircleLatitudeGivenLongitude(PointLonLat(0., 10.), PointLonLat(0., 20.), n, lon.data(),
+                                                          d.data(), threads);
+            EXPECT(std::isnan(d.front()) && std::isnan(d.back()));
+        }
+    }
+}
+
 // -----------------------------------------------------------------------------
 
 }  // namespace eckit::test
@@ -0,0 +1,202 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <unistd.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eckit/eckit_config.h"
+
+#include "eckit/config/Resource.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/io/AutoCloser.h"
+#include "eckit/io/FileDescHandle.h"
+#include "eckit/io/FileHandle.h"
+#include "eckit/io/RawFileHandle.h"
+#include "eckit/io/TransferWatcher.h"
+#include "eckit/log/Log.h"
+#include "eckit/testing/Test.h"
+
+using namespace std;
+using namespace eckit;
+using namespace eckit::testing;
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Content of the source files: a multiplicative hash of the offset, so that a misplaced range shows as a mismatch
+char sourceByte(size_t offset) {
+    return static_cast<char>((uint32_t(offset) * 2654435761U) >> 24);
+}
+
+class Transfer {
+public:
+    Transfer() {
+        std::string base = Resource<std::string>("$TMPDIR", "/tmp");
+        source_          = PathName::unique(base + "/source") + ".dat";
+        target_          = PathName::unique(base + "/target") + ".dat";
+
+        std::vector<char> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = sourceByte(i);
+        }
+
+        FileHandle fh(source_);
+        fh.openForWrite(0);
+        auto close = closer(fh);
+        fh.write(data.data(), long(size));
+    }
+
+    ~Transfer() {
+        if (target_.exists()) {
+            target_.unlink();
+        }
+        source_.unlink();
+    }
+
+    bool verify() {
+        FileHandle s(source_);
+        FileHandle t(target_);
+        return s.compare(t);
+    }
+
+    static constexpr size_t size = 3 * 1024 * 1024 + 4321;
+
+    PathName source_;
+    PathName target_;
+};
+
+/// Needs to see the data, so forces the transfer through user space
+struct CountingWatcher : public TransferWatcher {
+    void watch(const void* p, long len) override {
+        if (p) {
+            count_ += len;
+        }
+    }
+    size_t count_ = 0;
+};
+
+/// Does not need to see the data, records how it was moved inside the kernel (if it was)
+struct PathWatcher : public TransferWatcher {
+    void watch(const void*, long len) override { watched_ += len; }
+    bool watchesData() const override { return false; }
+    void movedInKernel(const char* method, long long bytes) override {
+        method_ = method;
+        moved_ += bytes;
+    }
+    std::string method_;
+    long long moved_ = 0;
+    long watched_    = 0;
+};
+
+/// Whether this build has a way of moving data between two files inside the kernel
+constexpr bool kernelFileToFile = eckit_HAVE_COPY_FILE_RANGE || eckit_HAVE_SENDFILE || eckit_HAVE_SPLICE;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("File to file saveInto") {
+    Transfer test;
+    FileHandle in(test.source_);
+    FileHandle out(test.target_);
+
+    PathWatcher watcher;
+    EXPECT(in.saveInto(out, watcher) == Length(Transfer::size));
+    EXPECT(test.target_.size() == Length(Transfer::size));
+    EXPECT(test.verify());
+
+    if (kernelFileToFile) {
+        Log::info() << "File to file moved with " << watcher.method_ << std::endl;
+        EXPECT(!watcher.method_.empty());
+        EXPECT(watcher.moved_ == (long long)Transfer::size);
+        EXPECT(watcher.watched_ == 0);
+    }
+}
+
+CASE("File to file saveInto with a watcher sees all the data") {
+    Transfer test;
+    FileHandle in(test.source_);
+    FileHandle out(test.target_);
+
+    CountingWatcher watcher;
+    EXPECT(in.saveInto(out, watcher) == Length(Transfer::size));
+    EXPECT(watcher.count_ == Transfer::size);
+    EXPECT(test.verify());
+}
+
+CASE("Raw file copyTo honours maxsize") {
+    Transfer test;
+    RawFileHandle in(test.source_);
+    RawFileHandle out(test.target_);
+
+    const Length part = 1000 * 1000 + 17;
+    PathWatcher watcher;
+    EXPECT(in.copyTo(out, -1, part, watcher) == part);
+    EXPECT(test.target_.size() == part);
+
+    if (kernelFileToFile) {
+        EXPECT(!watcher.method_.empty());
+        EXPECT(watcher.moved_ == (long long)part);
+    }
+
+    FileHandle t(test.target_);
+    t.openForRead();
+    auto close = closer(t);
+    char buf[100];
+    t.seek(part - Length(sizeof(buf)));
+    EXPECT(t.read(buf, sizeof(buf)) == long(sizeof(buf)));
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        EXPECT(buf[i] == sourceByte(size_t(part) - sizeof(buf) + i));
+    }
+    EXPECT(t.read(buf, sizeof(buf)) == 0);
+}
+
+CASE("File to pipe to file") {
+    Transfer test;
+
+    int fds[2];
+    EXPECT(::pipe(fds) == 0);
+
+    PathWatcher toPipe;
+    std::thread writer([&] {
+        FileHandle in(test.source_);
+        FileDescHandle pipeIn(fds[1], true);
+        in.saveInto(pipeIn, toPipe);
+    });
+
+    PathWatcher fromPipe;
+    FileDescHandle pipeOut(fds[0], true);
+    FileHandle out(test.target_);
+    Length len = pipeOut.saveInto(out, fromPipe);
+
+    writer.join();
+
+    EXPECT(len == Length(Transfer::size));
+    EXPECT(test.verify());
+
+    // n.b. copy_file_range() does not apply to pipes
+    if (eckit_HAVE_SPLICE) {
+        Log::info() << "File to pipe moved with " << toPipe.method_ << ", pipe to file with " << fromPipe.method_
+                    << std::endl;
+        EXPECT(toPipe.method_ == "sendfile" || toPipe.method_ == "splice");
+        EXPECT(fromPipe.method_ == "splice");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
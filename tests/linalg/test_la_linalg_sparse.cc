@@ -149,6 +149,66 @@ CASE("test backend") {
     }
 }
 
+CASE("test backend, single precision") {
+    using linalg::Matrix;
+    using linalg::MatrixFloat;
+    using linalg::SparseMatrixFloat;
+    using linalg::Vector;
+    using linalg::VectorFloat;
+
+    SparseMatrixFloat A(S(3, 3, 4, 0, 0, 2., 0, 2, -3., 1, 1, 2., 2, 2, 2.));
+
+    const auto& linalg = linalg::LinearAlgebraSparse::backend();
+
+    SECTION("spmv - sparse 3x3 x vector 3 = vector 3") {
+        VectorFloat x(3);
+        VectorFloat y(3);
+        for (linalg::Size i = 0; i < 3; ++i) {
+            x[i] = static_cast<float>(i + 1);
+        }
+
+        linalg.spmv(A, x, y);
+        EXPECT(y[0] == -7.f && y[1] == 4.f && y[2] == 6.f);
+
+        EXPECT_THROWS_AS(linalg.spmv(A, VectorFloat(2), y), AssertionFailed);
+    }
+
+    SECTION("spmv - sparse 3x3 x vector 3 = vector 3, accumulating in double") {
+        Vector y(3);
+        linalg.spmv(A, V(3, 1., 2., 3.), y);
+        EXPECT(equal_dense_matrix(y, V(3, -7., 4., 6.)));
+
+        // the product is in double: the vector entries are not rounded to float
+        SparseMatrixFloat B;
+        B.setIdentity(3, 3);
+
+        auto x = V(3, 1. / 3., 1. + 1e-12, 1e300);
+        linalg.spmv(B, x, y);
+        EXPECT(equal_dense_matrix(y, x));
+    }
+
+    SECTION("spmm - sparse 3x3 x matrix 3x2 = matrix 3x2") {
+        MatrixFloat B(3, 2);
+        MatrixFloat C(3, 2);
+        for (linalg::Size i = 0; i < B.size(); ++i) {
+            B[i] = static_cast<float>(i + 1);  // column-major: 1 4 / 2 5 / 3 6
+        }
+
+        linalg.spmm(A, B, C);
+        EXPECT(C(0, 0) == -7.f && C(1, 0) == 4.f && C(2, 0) == 6.f);
+        EXPECT(C(0, 1) == -10.f && C(1, 1) == 10.f && C(2, 1) == 12.f);
+
+        EXPECT_THROWS_AS(linalg.spmm(A, MatrixFloat(2, 2), C), AssertionFailed);
+    }
+
+    SECTION("spmm - sparse 3x3 x matrix 3x2 = matrix 3x2, accumulating in double") {
+        Matrix C(3, 2);
+        linalg.spmm(A, M(3, 2, 1., 2., 3., 4., 5., 6.), C);
+
+        EXPECT(equal_dense_matrix(C, M(3, 2, -13., -14., 6., 8., 10., 12.)));
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::test
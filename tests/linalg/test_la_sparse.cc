@@ -8,7 +8,14 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <limits>
+
 #include "eckit/config/Resource.h"
+#include "eckit/io/AutoCloser.h"
+#include "eckit/io/FileHandle.h"
+#include "eckit/linalg/LinearAlgebraSparse.h"
+#include "eckit/linalg/allocator/MappedAllocator.h"
+#include "eckit/linalg/sparse/SELLMatrix.h"
 #include "util.h"
 
 using namespace eckit::linalg;
@@ -242,6 +249,136 @@ CASE("creation with unassigned triplets ( ECKIT-361 )") {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+CASE("SELL-C-sigma layout and SIMD backend") {
+    // Rows of uneven lengths (some empty), a number of rows that is not a multiple of the chunk size, and
+    // values for which the products are exact whatever the order of the additions
+    const Size N = 203;
+    const Size M = 97;
+
+    std::vector<Triplet> triplets;
+    for (Size i = 0; i < N; ++i) {
+        for (Size k = 0; k < (i * 7) % 20; ++k) {
+            triplets.emplace_back(i, 1 + (i + 5 * k) % (M - 1), 0.5 * Scalar(k + 1));
+        }
+    }
+    SparseMatrix A(N, M, triplets);
+
+    // Column 0 is never referenced, so must never be read
+    Vector x(M);
+    for (Size j = 0; j < M; ++j) {
+        x[j] = Scalar(j % 5) - 2.;
+    }
+    x[0] = std::numeric_limits<Scalar>::quiet_NaN();
+
+    Vector expected(N);
+    expected.setZero();
+    for (const auto& t : triplets) {
+        expected[t.row()] += t.value() * x[t.col()];
+    }
+
+    SECTION("SELLMatrix spmv") {
+        for (Size sigma : {1, 8, 64, 1000}) {
+            sparse::SELLMatrix B(A, sigma);
+            EXPECT(B.nonZeros() == A.nonZeros());
+            EXPECT(B.storedSize() >= A.nonZeros());
+
+            Vector y(N);
+            B.spmv(x, y);
+            EXPECT(equal_dense_matrix(y, expected));
+        }
+    }
+
+    SECTION("simd backend spmv") {
+        Vector y(N);
+        LinearAlgebraSparse::getBackend("simd").spmv(A, x, y);
+        EXPECT(equal_dense_matrix(y, expected));
+    }
+
+    SECTION("simd backend spmm") {
+        Matrix X(M, 3);
+        for (Size k = 0; k < 3; ++k) {
+            for (Size j = 0; j < M; ++j) {
+                X(j, k) = x[j] * Scalar(k + 1);
+            }
+        }
+
+        Matrix Y(N, 3);
+        LinearAlgebraSparse::getBackend("simd").spmm(A, X, Y);
+        for (Size k = 0; k < 3; ++k) {
+            for (Size i = 0; i < N; ++i) {
+                EXPECT(Y(i, k) == expected[i] * Scalar(k + 1));
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("memory-mapped matrix") {
+    auto A = S(3, 4, 5, 0, 0, 2., 0, 2, -3., 1, 1, 2., 2, 2, 2., 2, 3, 0.5);
+    auto x = V(4, 1., 2., 3., 4.);
+
+    PathName path = PathName::unique("matrix");
+
+    auto same = [](const auto& B, const auto& A) {
+        return B.rows() == A.rows() && B.cols() == A.cols() && B.nonZeros() == A.nonZeros()
+               && equal_array(B.outer(), A.outer(), A.rows() + 1) && equal_array(B.inner(), A.inner(), A.nonZeros())
+               && equal_array(B.data(), A.data(), A.nonZeros());
+    };
+
+    SECTION("save and map") {
+        allocator::MappedAllocator::save(A, path);
+
+        SparseMatrix B(new allocator::MappedAllocator(path));
+        EXPECT(B.inSharedMemory());
+        EXPECT(same(B, A));
+
+        // arrays are aligned
+        EXPECT(reinterpret_cast<uintptr_t>(B.outer()) % allocator::MappedAllocator::alignment == 0);
+        EXPECT(reinterpret_cast<uintptr_t>(B.data()) % allocator::MappedAllocator::alignment == 0);
+
+        Vector y(3);
+        LinearAlgebraSparse::backend().spmv(B, x, y);
+        EXPECT(equal_dense_matrix(y, V(3, -7., 4., 8.)));
+
+        // a copy is not mapped
+        SparseMatrix C(B);
+        EXPECT(!C.inSharedMemory());
+        EXPECT(same(C, A));
+
+        // huge pages are only advised
+        SparseMatrix D(new allocator::MappedAllocator(path, true));
+        EXPECT(same(D, A));
+    }
+
+    SECTION("single precision") {
+        SparseMatrixFloat F(A);
+        allocator::MappedAllocatorFloat::save(F, path);
+
+        SparseMatrixFloat B(new allocator::MappedAllocatorFloat(path));
+        EXPECT(same(B, F));
+
+        EXPECT_THROWS_AS(allocator::MappedAllocator{path}, BadValue);
+    }
+
+    SECTION("not a matrix file") {
+        {
+            FileHandle dh(path);
+            dh.openForWrite(0);
+            auto c = closer(dh);
+            const std::vector<char> junk(1024, 'x');
+            dh.write(junk.data(), long(junk.size()));
+        }
+        EXPECT_THROWS_AS(allocator::MappedAllocator{path}, BadValue);
+    }
+
+    if (path.exists()) {
+        path.unlink();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 }  // namespace eckit::test
 
 int main(int argc, char** argv) {
@@ -10,6 +10,7 @@
 
 #include "eckit/filesystem/PathName.h"
 #include "eckit/io/AutoCloser.h"
+#include "eckit/memory/MemoryBuffer.h"
 #include "eckit/serialisation/FileStream.h"
 #include "util.h"
 
@@ -25,7 +26,8 @@ void test(const T& v, const T& r) {
     EXPECT(testing::make_view(v.begin(), v.end()) == testing::make_view(r.begin(), r.end()));
 }
 
-void test(const linalg::SparseMatrix& v, const linalg::SparseMatrix& r) {
+template <typename S>
+void test(const linalg::SparseMatrixT<S>& v, const linalg::SparseMatrixT<S>& r) {
     EXPECT(v.rows() == r.rows());
     EXPECT(v.cols() == r.cols());
     EXPECT(v.nonZeros() == r.nonZeros());
@@ -66,6 +68,33 @@ CASE("test_stream_matrix") {
     stream_test(M(3, 3, 1., 2., 3., 4., 5., 6., 7., 8., 9.));
 }
 
+CASE("test_stream_vector_as_blob") {
+    // by default, arrays are written as blobs, readable by eckit versions without typed arrays
+    const auto v = V(3, 1., 2., 3.);
+
+    PathName filename = PathName::unique("data");
+    {
+        FileStream sout(filename, "w");
+        auto c = closer(sout);
+        sout << v;
+    }
+    {
+        FileStream sin(filename, "r");
+        auto c = closer(sin);
+
+        linalg::Size length = 0;
+        sin >> length;
+        EXPECT(length == v.size());
+
+        linalg::Vector out(length);
+        sin.readBlob(out.data(), length * sizeof(linalg::Scalar));
+        test(v, out);
+    }
+    if (filename.exists()) {
+        filename.unlink();
+    }
+}
+
 CASE("test_stream_sparsematrix") {
     std::vector<eckit::linalg::Triplet> triplets;
 
@@ -79,6 +108,74 @@ CASE("test_stream_sparsematrix") {
     stream_test(smat);
 }
 
+CASE("test_stream_single_precision") {
+    using linalg::MatrixFloat;
+    using linalg::SparseMatrixFloat;
+    using linalg::VectorFloat;
+
+    VectorFloat v(5);
+    for (linalg::Size i = 0; i < v.size(); ++i) {
+        v[i] = 0.1f * static_cast<float>(i + 1);
+    }
+    stream_test(v);
+
+    MatrixFloat m(2, 3);
+    for (linalg::Size i = 0; i < m.size(); ++i) {
+        m[i] = 0.1f * static_cast<float>(i + 1);
+    }
+    stream_test(m);
+
+    SparseMatrixFloat smat(3, 3, {{0, 0, 0.1}, {0, 2, -0.3}, {1, 1, 0.2}, {2, 2, 0.2}});
+    stream_test(smat);
+}
+
+CASE("test_save_load_sparsematrix_precision") {
+    using linalg::SparseMatrix;
+    using linalg::SparseMatrixFloat;
+
+    SparseMatrix smat(3, 4, {{0, 0, 0.1}, {0, 3, -0.3}, {1, 1, 0.2}, {2, 2, 1. / 3.}});
+    SparseMatrixFloat fmat(smat);
+
+    EXPECT(fmat.nonZeros() == smat.nonZeros());
+    EXPECT(fmat.footprint() < smat.footprint());
+    for (linalg::Size i = 0; i < smat.nonZeros(); ++i) {
+        EXPECT(fmat.data()[i] == static_cast<float>(smat.data()[i]));
+    }
+
+    PathName filename = PathName::unique("data");
+
+    SECTION("load single precision from double precision file") {
+        smat.save(filename);
+
+        SparseMatrixFloat out;
+        out.load(filename);
+        test(fmat, out);
+    }
+
+    SECTION("load double precision from single precision file") {
+        fmat.save(filename);
+
+        SparseMatrix out;
+        out.load(filename);
+        test(SparseMatrix(fmat), out);
+    }
+
+    SECTION("dump and load from buffer") {
+        MemoryBuffer buffer(fmat.footprint() + 1024);
+        fmat.dump(buffer);
+
+        SparseMatrixFloat out(buffer);
+        test(fmat, out);
+
+        // entries are not converted when loading from a buffer
+        EXPECT_THROWS_AS(SparseMatrix{buffer}, AssertionFailed);
+    }
+
+    if (filename.exists()) {
+        filename.unlink();
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::test
@@ -8,8 +8,12 @@
  * does it submit to any jurisdiction.
  */
 
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <numeric>
+#include <string>
 
 #include "eckit/filesystem/LocalPathName.h"
 #include "eckit/log/Log.h"
@@ -819,6 +823,77 @@ CASE("test_broadcastFile") {
     EXPECT(comm.broadcastFile(path, root).str() == str);
 }
 
+/// Sets an environment variable until the end of the scope, then restores it
+struct ScopedEnv {
+    ScopedEnv(const char* name, const char* value) :
+        name_(name) {
+        const char* old = ::getenv(name);
+        if (old != nullptr) {
+            old_.reset(new std::string(old));
+        }
+        ::setenv(name, value, 1);
+    }
+
+    ~ScopedEnv() {
+        if (old_) {
+            ::setenv(name_, old_->c_str(), 1);
+        }
+        else {
+            ::unsetenv(name_);
+        }
+    }
+
+    const char* name_;
+    std::unique_ptr<std::string> old_;
+};
+
+CASE("test_broadcastFile_chunked") {
+    mpi::Comm& comm = mpi::comm("world");
+    size_t root     = comm.size() - 1;
+
+    // n.b. not a multiple of the chunk size
+    std::string str(1024 * 1024 + 7, ' ');
+    for (size_t i = 0; i < str.size(); ++i) {
+        str[i] = char('a' + (i * 7919) % 26);
+    }
+
+    LocalPathName path(eckit::Main::instance().name() + "_broadcastFile_chunked.txt");
+    if (comm.rank() == root) {
+        std::ofstream file(path.c_str(), std::ios_base::out);
+        file << str;
+        file.close();
+    }
+
+    // n.b. only on the root, the other tasks use its chunk size
+    std::unique_ptr<ScopedEnv> env(comm.rank() == root ? new ScopedEnv("ECKIT_MPI_BROADCAST_FILE_CHUNK_SIZE", "4096")
+                                                       : nullptr);
+
+    SECTION("broadcastFile") {
+        EXPECT(comm.broadcastFile(path, root).str() == str);
+    }
+
+    SECTION("broadcastFileShared") {
+        mpi::NodeBuffer buffer = comm.broadcastFileShared(path, root);
+        EXPECT(buffer.size() == str.size());
+        EXPECT(::memcmp(buffer.data(), str.data(), str.size()) == 0);
+
+        mpi::NodeBuffer copy = buffer;
+        EXPECT(copy.data() == buffer.data());
+        EXPECT(copy.str() == str);
+    }
+
+    SECTION("missing file") {
+        LocalPathName missing(eckit::Main::instance().name() + "_broadcastFile_missing.txt");
+        EXPECT_THROWS_AS(comm.broadcastFile(missing, root), CantOpenFile);
+        EXPECT_THROWS_AS(comm.broadcastFileShared(missing, root), CantOpenFile);
+    }
+
+    comm.barrier();
+    if (comm.rank() == root) {
+        path.unlink();
+    }
+}
+
 CASE("test_waitAll") {
 
     auto& comm = mpi::comm("world");
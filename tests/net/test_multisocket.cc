@@ -0,0 +1,208 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/io/Buffer.h"
+#include "eckit/net/MultiSocket.h"
+#include "eckit/net/TCPClient.h"
+#include "eckit/net/TCPServer.h"
+#include "eckit/net/TCPSocket.h"
+
+#include "eckit/testing/Test.h"
+
+using namespace eckit;
+using namespace eckit::testing;
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::vector<unsigned char> payload(size_t size) {
+    std::vector<unsigned char> data(size);
+    unsigned long long x = 88172645463325252ULL;
+    for (auto& c : data) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        c = static_cast<unsigned char>(x);
+    }
+    return data;
+}
+
+/// Accepts a MultiSocket transfer on an ephemeral port, and reads it to the end in blocks of blockSize bytes
+class Receiver {
+public:
+    Receiver(size_t blockSize) :
+        server_(0), port_(server_.localPort()) {
+        thread_ = std::thread([this, blockSize] {
+            try {
+                net::MultiSocket s(server_.accept());
+                std::vector<char> block(blockSize);
+                long len;
+                while ((len = s.read(block.data(), long(block.size()))) > 0) {
+                    received_.insert(received_.end(), block.begin(), block.begin() + len);
+                }
+                adaptive_  = s.adaptive();
+                reordered_ = s.reordered();
+                s.close();
+            }
+            catch (...) {
+                error_ = std::current_exception();
+            }
+        });
+    }
+
+    ~Receiver() {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    int port() const { return port_; }
+
+    void wait() {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    const std::vector<unsigned char>& received() const { return received_; }
+    bool adaptive() const { return adaptive_; }
+    size_t reordered() const { return reordered_; }
+
+private:
+    net::MultiSocket server_;
+    int port_;
+    std::thread thread_;
+    std::exception_ptr error_;
+    std::vector<unsigned char> received_;
+    bool adaptive_    = false;
+    size_t reordered_ = 0;
+};
+
+/// Forwards the streams of a MultiSocket to the receiver, delaying the first one after each block forwarded, so that
+/// it falls behind the others
+class Relay {
+public:
+    Relay(int target, size_t streams) :
+        server_(0) {
+        port_   = server_.localPort();
+        thread_ = std::thread([this, target, streams] {
+            std::vector<std::thread> forwarders;
+            for (size_t i = 0; i < streams; ++i) {
+                auto in  = std::make_shared<net::TCPSocket>(server_.accept());
+                auto out = std::make_shared<net::TCPClient>();
+                out->connect("localhost", target);
+                forwarders.emplace_back([in, out, i] {
+                    Buffer buffer(16 * 1024);
+                    long len;
+                    while ((len = in->rawRead(buffer, buffer.size())) > 0) {
+                        ASSERT(out->write(buffer, len) == len);
+                        if (i == 0) {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                        }
+                    }
+                    out->close();
+                });
+            }
+            for (auto& f : forwarders) {
+                f.join();
+            }
+        });
+    }
+
+    ~Relay() {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    int port() const { return port_; }
+
+private:
+    net::TCPServer server_;
+    int port_;
+    std::thread thread_;
+};
+
+/// Write data in blocks of various sizes
+void send(net::MultiSocket& s, const std::vector<unsigned char>& data) {
+    const size_t sizes[] = {1, 777, 4096, 10000, 65536};
+    size_t pos           = 0;
+    for (size_t k = 0; pos < data.size(); ++k) {
+        long len = long(std::min(sizes[k % 5], data.size() - pos));
+        EXPECT(s.write(data.data() + pos, len) == len);
+        pos += size_t(len);
+    }
+    s.close();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Clients use the original round-robin protocol by default") {
+    net::MultiSocket client(2, 1024);
+    EXPECT(!client.adaptive());
+}
+
+CASE("Adaptive striping reassembles chunks received out of order") {
+    const size_t streams = 4;
+    const auto data      = payload(4 * 1024 * 1024);
+
+    Receiver receiver(1000);  // smaller than the chunks, which are then partially consumed
+    {
+        Relay relay(receiver.port(), streams);
+
+        net::MultiSocket client(streams, 4096);
+        client.adaptive(true);
+        client.bufferSize(16 * 1024);
+        net::MultiSocket s(client.connect("localhost", relay.port()));
+        send(s, data);
+    }
+    receiver.wait();
+
+    EXPECT(receiver.adaptive());
+    EXPECT(receiver.reordered() > 0);
+    EXPECT(receiver.received().size() == data.size());
+    EXPECT(receiver.received() == data);
+}
+
+CASE("Round-robin (version 1) clients are served by the same server") {
+    const auto data = payload(1024 * 1024 + 123);
+
+    Receiver receiver(100000);  // larger than the chunks
+    {
+        net::MultiSocket client(3, 1000);
+        net::MultiSocket s(client.connect("localhost", receiver.port()));
+        send(s, data);
+    }
+    receiver.wait();
+
+    EXPECT(!receiver.adaptive());
+    EXPECT(receiver.reordered() == 0);
+    EXPECT(receiver.received() == data);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
@@ -0,0 +1,195 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "eckit/net/NetService.h"
+#include "eckit/net/NetUser.h"
+#include "eckit/net/TCPClient.h"
+#include "eckit/thread/ThreadControler.h"
+#include "eckit/web/HtmlResource.h"
+#include "eckit/web/HttpService.h"
+#include "eckit/web/Url.h"
+
+#include "eckit/testing/Test.h"
+
+using namespace eckit;
+using namespace eckit::testing;
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Hello : public HtmlResource {
+public:
+    Hello() :
+        HtmlResource("/hello") {}
+
+    void html(std::ostream& s, Url& url) override { s << "hello " << url.method(); }
+};
+
+static Hello hello;
+
+/// Runs a service on its event loop until the end of the scope
+template <typename Service>
+class Running {
+public:
+    Running() :
+        service_(new Service), port_(service_->port()), thread_(service_, false) {
+        thread_.start();
+    }
+
+    ~Running() {
+        thread_.stop();
+        thread_.wait();
+    }
+
+    int port() const { return port_; }
+
+private:
+    Service* service_;
+    int port_;
+    ThreadControler thread_;  // owns the service
+};
+
+class EventLoopHttpService : public HttpService {
+public:
+    EventLoopHttpService() :
+        HttpService(0) {}
+
+private:
+    bool preferEventLoop() const override { return true; }
+    size_t workers() const override { return 2; }
+    long timeout() const override { return 1; }  // so that the loop sees stop()
+};
+
+/// Echoes the words received, until the peer closes the connection, without overriding serveRequest()
+class EchoUser : public net::NetUser {
+public:
+    using net::NetUser::NetUser;
+
+private:
+    void serve(Stream&, std::istream& in, std::ostream& out) override {
+        std::string word;
+        while (in >> word) {
+            out << word << std::endl;
+        }
+    }
+};
+
+class EventLoopEchoService : public net::NetService {
+public:
+    EventLoopEchoService() :
+        net::NetService(0) {}
+
+private:
+    net::NetUser* newUser(net::TCPSocket& socket) const override { return new EchoUser(socket); }
+    std::string name() const override { return "echo"; }
+    bool preferEventLoop() const override { return true; }
+    size_t workers() const override { return 2; }
+    long timeout() const override { return 1; }
+};
+
+void send(net::TCPSocket& socket, const std::string& data) {
+    EXPECT(socket.write(data.data(), long(data.size())) == long(data.size()));
+}
+
+size_t occurrences(const std::string& all, const std::string& text) {
+    size_t seen = 0;
+    for (size_t pos = all.find(text); pos != std::string::npos; pos = all.find(text, pos + 1)) {
+        ++seen;
+    }
+    return seen;
+}
+
+/// Read until text has been seen count times (or to the end of the data, if count is 0)
+std::string receive(net::TCPSocket& socket, const std::string& text, size_t count) {
+    std::string all;
+    char buffer[4096];
+    while (count == 0 || occurrences(all, text) < count) {
+        long len = socket.readSome(buffer, sizeof(buffer));
+        if (len <= 0) {
+            break;
+        }
+        all.append(buffer, size_t(len));
+    }
+    return all;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("HTTP/1.1 requests pipelined on connections kept alive") {
+    Running<EventLoopHttpService> service;
+
+    const size_t clients = 5;
+    std::vector<net::TCPSocket> sockets(clients);
+    for (auto& socket : sockets) {
+        net::TCPClient client;
+        socket = client.connect("localhost", service.port());
+    }
+
+    const std::string request = "GET /hello HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    for (auto& socket : sockets) {
+        send(socket, request + request + request);
+    }
+
+    for (auto& socket : sockets) {
+        std::string replies = receive(socket, "hello GET", 3);
+        EXPECT(occurrences(replies, "hello GET") == 3);
+        EXPECT(occurrences(replies, "Connection: keep-alive") == 3);
+
+        // still open
+        send(socket, request);
+        EXPECT(occurrences(receive(socket, "hello GET", 1), "hello GET") == 1);
+    }
+}
+
+CASE("HTTP/1.0 requests are answered, then the connection is closed") {
+    Running<EventLoopHttpService> service;
+
+    net::TCPClient client;
+    net::TCPSocket socket = client.connect("localhost", service.port());
+    send(socket, "GET /hello HTTP/1.0\r\n\r\n");
+
+    // reads to the end of the data, which the service closing the connection marks
+    std::string reply = receive(socket, "", 0);
+    EXPECT(occurrences(reply, "hello GET") == 1);
+    EXPECT(occurrences(reply, "keep-alive") == 0);
+}
+
+CASE("Users that only implement serve() are served by the event loop") {
+    Running<EventLoopEchoService> service;
+
+    std::vector<net::TCPSocket> sockets(3);
+    for (auto& socket : sockets) {
+        net::TCPClient client;
+        socket = client.connect("localhost", service.port());
+    }
+
+    for (size_t i = 0; i < sockets.size(); ++i) {
+        send(sockets[i], "one two\nthree" + std::to_string(i) + "\n");
+        sockets[i].closeOutput();
+    }
+
+    for (size_t i = 0; i < sockets.size(); ++i) {
+        EXPECT(receive(sockets[i], "", 0) == "one\ntwo\nthree" + std::to_string(i) + "\n");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
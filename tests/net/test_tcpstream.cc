@@ -0,0 +1,230 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <string>
+#include <thread>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/io/cluster/NodeInfo.h"
+#include "eckit/net/Connector.h"
+#include "eckit/net/TCPClient.h"
+#include "eckit/net/TCPServer.h"
+#include "eckit/net/TCPStream.h"
+
+#include "eckit/testing/Test.h"
+
+using namespace eckit;
+using namespace eckit::testing;
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+const size_t bufferSize = 256;
+
+/// Small messages, several per buffer, then messages larger than the buffer (written with the bytes buffered so far,
+/// and read partly from the buffer, partly directly)
+const size_t sizes[] = {0, 1, 10, bufferSize - 20, bufferSize, 3 * bufferSize + 7, 100000};
+
+std::string text(size_t size, char first) {
+    std::string s(size, ' ');
+    for (size_t i = 0; i < size; ++i) {
+        s[i] = char(first + i % 26);
+    }
+    return s;
+}
+
+std::string reversed(std::string s) {
+    std::reverse(s.begin(), s.end());
+    return s;
+}
+
+/// Replies to each request (id, text) with (id, reversed text, length), until id is negative
+/// @param login accept the login of a Connector first
+void serve(net::TCPServer& server, std::atomic<size_t>& served, bool login) {
+    net::TCPSocket socket(server.accept());
+    if (login) {
+        net::InstantTCPStream s(socket);
+        NodeInfo::acceptLogin(s);
+    }
+
+    net::TCPStream s(socket);
+    s.buffered(bufferSize);
+
+    for (;;) {
+        long id = 0;
+        std::string request;
+        s >> id;
+        if (id < 0) {
+            break;
+        }
+        s >> request;
+
+        ++served;
+        s << id;
+        s << reversed(request);
+        s << request.size();
+    }
+}
+
+void request(Stream& s, long id, const std::string& text) {
+    s << id;
+    s << text;
+}
+
+void reply(Stream& s, long id, const std::string& text) {
+    long rid = -1;
+    std::string reply;
+    size_t length = 0;
+    s >> rid >> reply >> length;
+
+    EXPECT(rid == id);
+    EXPECT(length == text.size());
+    EXPECT(reply == reversed(text));
+}
+
+void oneAtATime(Stream& s, long& id) {
+    for (size_t size : sizes) {
+        request(s, id, text(size, 'a'));
+        reply(s, id++, text(size, 'a'));
+    }
+}
+
+void pipelined(Stream& s, long& id) {
+    const long first = id;
+    for (size_t size : sizes) {
+        request(s, id++, text(size, 'A'));
+    }
+    id = first;
+    for (size_t size : sizes) {
+        reply(s, id++, text(size, 'A'));
+    }
+}
+
+/// Connects to a given port, without looking the node up in the cluster
+class TestConnector : public net::Connector {
+public:
+    explicit TestConnector(int port) :
+        Connector("localhost", port, "test") {}
+};
+
+/// Runs client(port, served, thread) against serve() on a thread, joined even if the client fails (n.b. the client
+/// closes its connection on failure, so that the server stops waiting for requests)
+template <typename F>
+void loopback(bool login, F client) {
+    net::TCPServer server(0);
+    const int port = server.localPort();
+
+    std::atomic<size_t> served{0};
+    std::exception_ptr error;
+    std::thread thread([&] {
+        try {
+            serve(server, served, login);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+    });
+
+    std::exception_ptr failure;
+    try {
+        client(port, served, thread);
+    }
+    catch (...) {
+        failure = std::current_exception();
+    }
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Buffered request/reply round trips") {
+    loopback(false, [](int port, std::atomic<size_t>& served, std::thread&) {
+        net::TCPClient client;
+        net::TCPStream s(client.connect("localhost", port));
+        s.buffered(bufferSize);
+
+        long id = 0;
+        oneAtATime(s, id);
+        pipelined(s, id);
+        EXPECT(served == size_t(id));
+
+        s << -1L;
+    });
+}
+
+CASE("Buffered connector round trips") {
+    loopback(true, [&](int port, std::atomic<size_t>& served, std::thread& server) {
+        TestConnector c(port);
+        c.buffered(bufferSize);
+
+        long id = 0;
+
+        SECTION("one request at a time") {
+            oneAtATime(c, id);
+        }
+
+        SECTION("pipelined requests") {
+            pipelined(c, id);
+        }
+
+        SECTION("memoized requests") {
+            // the request buffered before memoize(true) is sent before the memoized one
+            request(c, id, text(10, 'm'));
+            c.memoize(true, 60);
+            request(c, id + 1, text(20, 'n'));
+            reply(c, id, text(10, 'm'));
+            reply(c, id + 1, text(20, 'n'));
+            c.memoize(false, 0);
+            id += 2;
+
+            // a request repeated while memoized is answered from the cache
+            const size_t before = served;
+            for (int i = 0; i < 2; ++i) {
+                c.memoize(true, 60);
+                request(c, id, text(30, 'x'));
+                reply(c, id, text(30, 'x'));
+                c.memoize(false, 0);
+            }
+            EXPECT(served == before + 1);
+            ++id;
+        }
+
+        EXPECT(served == size_t(id));
+
+        c << -1L;
+        c.flush();
+        server.join();
+
+        // the server has gone, reading resets the connector and asks to retry
+        long last = 0;
+        EXPECT_THROWS_AS(c >> last, Retry);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
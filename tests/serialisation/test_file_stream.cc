@@ -9,11 +9,15 @@
  */
 
 #include <sys/types.h>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <fstream>
+#include <vector>
 
 #include "eckit/io/AutoCloser.h"
 #include "eckit/serialisation/FileStream.h"
+#include "eckit/utils/ByteSwap.h"
 
 #include "eckit/testing/Test.h"
 
@@ -153,6 +157,85 @@ CASE("stream_string") {
     }
 }
 
+CASE("stream_array") {
+    std::vector<double> doubles(1001);
+    std::vector<int> ints(37);
+    std::vector<std::uint16_t> shorts(37);
+    for (size_t i = 0; i < doubles.size(); ++i) {
+        doubles[i] = double(i) / 3.;
+    }
+    for (size_t i = 0; i < ints.size(); ++i) {
+        ints[i]   = -int(i * 1000003);
+        shorts[i] = std::uint16_t(i * 257);
+    }
+
+    SECTION("same byte order") {
+        {
+            FileStream sout(F::filename, "w");
+            auto c = closer(sout);
+            sout.writeArray(doubles.data(), doubles.size());
+            sout << i_string;
+            sout.writeArray(ints.data(), ints.size());
+            sout.writeBlob(shorts.data(), shorts.size() * sizeof(std::uint16_t));  // as before arrays were typed
+        }
+
+        std::vector<double> d(doubles.size());
+        std::vector<int> i(ints.size());
+        std::vector<std::uint16_t> s(shorts.size());
+        std::string str;
+
+        FileStream sin(F::filename, "r");
+        auto c = closer(sin);
+        sin.readArray(d.data(), d.size());
+        sin >> str;
+        sin.readArray(i.data(), i.size());
+        sin.readArray(s.data(), s.size());
+
+        EXPECT(d == doubles);
+        EXPECT(str == i_string);
+        EXPECT(i == ints);
+        EXPECT(s == shorts);
+    }
+
+    SECTION("other byte order") {
+        {
+            FileStream sout(F::filename, "w");
+            auto c = closer(sout);
+            sout.writeArray(doubles.data(), doubles.size());
+        }
+
+        // n.b. the byte order follows the tag, and the kind and size of the elements
+        {
+            std::fstream f(F::filename.asString(), std::ios::in | std::ios::out | std::ios::binary);
+            f.seekg(3);
+            const auto order = char(f.get());
+            f.seekp(3);
+            f.put(char(1 - order));
+        }
+
+        std::vector<double> d(doubles.size());
+        FileStream sin(F::filename, "r");
+        auto c = closer(sin);
+        sin.readArray(d.data(), d.size());
+
+        byteswap(d);
+        EXPECT(d == doubles);
+    }
+
+    SECTION("other type") {
+        {
+            FileStream sout(F::filename, "w");
+            auto c = closer(sout);
+            sout.writeArray(ints.data(), ints.size());
+        }
+
+        std::vector<unsigned int> u(ints.size());
+        FileStream sin(F::filename, "r");
+        auto c = closer(sin);
+        EXPECT_THROWS_AS(sin.readArray(u.data(), u.size()), BadValue);
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace eckit::test
@@ -8,7 +8,10 @@
  * does it submit to any jurisdiction.
  */
 
+#include <cmath>
 #include <cstring>
+#include <limits>
+#include <map>
 
 #include "eckit/sql/SQLColumn.h"
 #include "eckit/sql/SQLDatabase.h"
@@ -20,6 +23,7 @@
 #include "eckit/sql/expression/SQLExpressions.h"
 #include "eckit/sql/type/SQLBitfield.h"
 #include "eckit/testing/Test.h"
+#include "eckit/types/FloatCompare.h"
 
 using namespace eckit::testing;
 
@@ -137,6 +141,88 @@ private:
 
 //----------------------------------------------------------------------------------------------------------------------
 
+// A numeric table spanning several evaluation blocks, with missing values, optionally read in several partitions
+
+static const size_t NUMERIC_ROWS = 2500;
+static const double NUMERIC_MISSING = -999;
+
+long numericA(size_t row) {
+    return (row * 7) % 13;
+}
+
+double numericB(size_t row) {
+    return (row % 11 == 0) ? NUMERIC_MISSING : row * 0.25 - (row % 5);
+}
+
+class NumericTable : public eckit::sql::SQLTable {
+
+public:
+    NumericTable(eckit::sql::SQLDatabase& db, const std::string& path, const std::string& name,
+                 size_t partitions = 1) :
+        SQLTable(db, path, name), partitions_(partitions) {
+        addColumn("a", 0, eckit::sql::type::SQLType::lookup("integer"), false, 0);
+        addColumn("b", 1, eckit::sql::type::SQLType::lookup("real"), true, NUMERIC_MISSING);
+    }
+
+private:
+    class NumericTableIterator : public eckit::sql::SQLTableIterator {
+    public:
+        NumericTableIterator(const std::vector<std::reference_wrapper<const eckit::sql::SQLColumn>>& columns,
+                             size_t begin, size_t end) :
+            begin_(begin), end_(end), row_(begin), data_(2) {
+            for (const auto& col : columns) {
+                offsets_.push_back(col.get().index());
+                hasMissing_.push_back(col.get().hasMissingValue());
+                missingVals_.push_back(col.get().missingValue());
+            }
+        }
+
+    private:
+        void rewind() override { row_ = begin_; }
+        bool next() override {
+            if (row_ < end_) {
+                data_[0] = numericA(row_);
+                data_[1] = numericB(row_);
+                row_++;
+                return true;
+            }
+            return false;
+        }
+        std::vector<size_t> columnOffsets() const override { return offsets_; }
+        std::vector<size_t> doublesDataSizes() const override { return std::vector<size_t>(offsets_.size(), 1); }
+        std::vector<char> columnsHaveMissing() const override { return hasMissing_; }
+        std::vector<double> missingValues() const override { return missingVals_; }
+        const double* data() const override { return &data_[0]; }
+
+        size_t begin_;
+        size_t end_;
+        size_t row_;
+        std::vector<size_t> offsets_;
+        std::vector<char> hasMissing_;
+        std::vector<double> missingVals_;
+        std::vector<double> data_;
+    };
+
+    eckit::sql::SQLTableIterator* iterator(
+        const std::vector<std::reference_wrapper<const eckit::sql::SQLColumn>>& columns,
+        std::function<void(eckit::sql::SQLTableIterator&)>) const override {
+        return new NumericTableIterator(columns, 0, NUMERIC_ROWS);
+    }
+
+    size_t partitions() const override { return partitions_; }
+
+    eckit::sql::SQLTableIterator* partitionIterator(
+        size_t partition, const std::vector<std::reference_wrapper<const eckit::sql::SQLColumn>>& columns,
+        std::function<void(eckit::sql::SQLTableIterator&)>) const override {
+        return new NumericTableIterator(columns, partition * NUMERIC_ROWS / partitions_,
+                                        (partition + 1) * NUMERIC_ROWS / partitions_);
+    }
+
+    size_t partitions_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 class TestOutput : public eckit::sql::SQLOutput {
 
     void cleanup(eckit::sql::SQLSelect&) override {}
@@ -408,6 +494,185 @@ CASE("Select from constructed table") {
 }  // Testing SQL select from standard table
 
 
+CASE("Select from a table larger than an evaluation block") {
+
+    eckit::sql::SQLSession session(std::unique_ptr<TestOutput>(new TestOutput));
+    eckit::sql::SQLDatabase& db(session.currentDatabase());
+
+    db.addTable(new NumericTable(db, "a/b/c.path", "numbers"));
+
+    TestOutput& o(static_cast<TestOutput&>(session.output()));
+
+    SECTION("Test SQL select arithmetic where") {
+
+        std::string sql = "select a, b * 2 from numbers where b > 100 and a <> 3";
+        eckit::sql::SQLParser().parseString(session, sql);
+
+        session.statement().execute();
+
+        std::vector<long> expectedA;
+        std::vector<double> expectedB;
+        for (size_t row = 0; row < NUMERIC_ROWS; ++row) {
+            if (numericB(row) != NUMERIC_MISSING && numericB(row) > 100 && numericA(row) != 3) {
+                expectedA.push_back(numericA(row));
+                expectedB.push_back(numericB(row) * 2);
+            }
+        }
+
+        EXPECT(!expectedA.empty());
+        EXPECT(o.intOutput == expectedA);
+        EXPECT(o.floatOutput == expectedB);
+    }
+
+    SECTION("Test SQL select aggregates") {
+
+        std::string sql = "select sum(b), count(b), min(b), max(b), avg(b) from numbers where a < 10";
+        eckit::sql::SQLParser().parseString(session, sql);
+
+        session.statement().execute();
+
+        double sum   = 0;
+        double count = 0;
+        double min   = std::numeric_limits<double>::max();
+        double max   = -std::numeric_limits<double>::max();
+        for (size_t row = 0; row < NUMERIC_ROWS; ++row) {
+            double b = numericB(row);
+            if (b != NUMERIC_MISSING && numericA(row) < 10) {
+                sum += b;
+                count++;
+                min = std::min(min, b);
+                max = std::max(max, b);
+            }
+        }
+
+        EXPECT(o.floatOutput == std::vector<double>({sum, count, min, max, sum / count}));
+    }
+
+    SECTION("Test SQL select mixed aggregates") {
+
+        std::string sql = "select a, count(b) from numbers where b < 500";
+        eckit::sql::SQLParser().parseString(session, sql);
+
+        session.statement().execute();
+
+        std::map<long, double> counts;
+        for (size_t row = 0; row < NUMERIC_ROWS; ++row) {
+            if (numericB(row) != NUMERIC_MISSING && numericB(row) < 500) {
+                counts[numericA(row)]++;
+            }
+        }
+
+        std::vector<long> expectedA;
+        std::vector<double> expectedCount;
+        for (const auto& kv : counts) {
+            expectedA.push_back(kv.first);
+            expectedCount.push_back(kv.second);
+        }
+
+        EXPECT(o.intOutput == expectedA);
+        EXPECT(o.floatOutput == expectedCount);
+    }
+
+    SECTION("Test SQL select aggregates without match") {
+
+        std::string sql = "select count(b) from numbers where a > 100";
+        eckit::sql::SQLParser().parseString(session, sql);
+
+        session.statement().execute();
+
+        EXPECT(o.floatOutput.empty());
+    }
+}
+
+
+CASE("Select aggregates from a partitioned table") {
+
+    eckit::sql::SQLSession session(std::unique_ptr<TestOutput>(new TestOutput));
+    eckit::sql::SQLDatabase& db(session.currentDatabase());
+
+    db.addTable(new NumericTable(db, "a/b/c.path", "numbers", 7));
+
+    TestOutput& o(static_cast<TestOutput&>(session.output()));
+
+    SECTION("Test SQL select aggregates") {
+
+        std::string sql = "select sum(b), count(b), min(b), max(b), avg(b) from numbers where a < 10";
+        eckit::sql::SQLParser().parseString(session, sql);
+
+        session.statement().execute();
+
+        double sum   = 0;
+        double count = 0;
+        double min   = std::numeric_limits<double>::max();
+        double max   = -std::numeric_limits<double>::max();
+        for (size_t row = 0; row < NUMERIC_ROWS; ++row) {
+            double b = numericB(row);
+            if (b != NUMERIC_MISSING && numericA(row) < 10) {
+                sum += b;
+                count++;
+                min = std::min(min, b);
+                max = std::max(max, b);
+            }
+        }
+
+        // n.b. the values are multiples of 0.25, so the sums do not depend on the order of the rows
+        EXPECT(o.floatOutput == std::vector<double>({sum, count, min, max, sum / count}));
+    }
+
+    SECTION("Test SQL select variance") {
+
+        std::string sql = "select var(b), stdev(b) from numbers where a <> 3";
+        eckit::sql::SQLParser().parseString(session, sql);
+
+        session.statement().execute();
+
+        double sum     = 0;
+        double squares = 0;
+        double count   = 0;
+        for (size_t row = 0; row < NUMERIC_ROWS; ++row) {
+            double b = numericB(row);
+            if (b != NUMERIC_MISSING && numericA(row) != 3) {
+                sum += b;
+                squares += b * b;
+                count++;
+            }
+        }
+        double var = squares / count - (sum / count) * (sum / count);
+
+        EXPECT(o.floatOutput.size() == 2);
+        EXPECT(eckit::types::is_approximately_equal(o.floatOutput[0], var, 1e-6));
+        EXPECT(eckit::types::is_approximately_equal(o.floatOutput[1], std::sqrt(var), 1e-6));
+    }
+
+    SECTION("Test SQL select columns") {
+
+        std::string sql = "select a from numbers where b > 600";
+        eckit::sql::SQLParser().parseString(session, sql);
+
+        session.statement().execute();
+
+        std::vector<long> expected;
+        for (size_t row = 0; row < NUMERIC_ROWS; ++row) {
+            if (numericB(row) != NUMERIC_MISSING && numericB(row) > 600) {
+                expected.push_back(numericA(row));
+            }
+        }
+
+        EXPECT(!expected.empty());
+        EXPECT(o.intOutput == expected);
+    }
+
+    SECTION("Test SQL select aggregates without match") {
+
+        std::string sql = "select count(b) from numbers where a > 100";
+        eckit::sql::SQLParser().parseString(session, sql);
+
+        session.statement().execute();
+
+        EXPECT(o.floatOutput.empty());
+    }
+}
+
 CASE("Test with implicit tables") {
 
     eckit::sql::SQLSession session(std::unique_ptr<TestOutput>(new TestOutput));
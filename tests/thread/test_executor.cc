@@ -0,0 +1,294 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/thread/Executor.h"
+#include "eckit/thread/ParallelFor.h"
+#include "eckit/thread/ThreadPool.h"
+
+#include "eckit/testing/Test.h"
+
+using namespace eckit;
+using namespace eckit::testing;
+
+namespace eckit::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+long fibonacci(TaskGroup& parent, long n) {
+    if (n < 12) {
+        return n < 2 ? n : fibonacci(parent, n - 1) + fibonacci(parent, n - 2);
+    }
+    long a = 0;
+    long b = 0;
+    TaskGroup group(parent.executor());
+    group.run([&] { a = fibonacci(group, n - 1); });
+    b = fibonacci(group, n - 2);
+    group.wait();
+    return a + b;
+}
+
+CASE("Submit returns futures") {
+    Executor executor("test", 4);
+
+    std::vector<std::future<size_t>> results;
+    for (size_t i = 0; i < 1000; ++i) {
+        results.push_back(executor.submit([i] { return i * i; }));
+    }
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT(results[i].get() == i * i);
+    }
+
+    auto failure = executor.submit([]() -> int { throw BadValue("failure"); });
+    EXPECT_THROWS_AS(failure.get(), BadValue);
+}
+
+CASE("Task groups are waited upon independently") {
+    Executor executor("test", 3);
+
+    std::atomic<size_t> slow{0};
+    std::atomic<bool> release{false};
+
+    TaskGroup blocked(executor);
+    blocked.run([&] {
+        while (!release) {
+            std::this_thread::yield();
+        }
+        slow++;
+    });
+
+    TaskGroup group(executor);
+    std::atomic<size_t> count{0};
+    for (size_t i = 0; i < 10000; ++i) {
+        group.run([&] { count++; });
+    }
+    group.wait();
+
+    EXPECT(count == 10000);
+    EXPECT(!blocked.done());
+
+    release = true;
+    blocked.wait();
+    EXPECT(slow == 1);
+
+    executor.wait();
+}
+
+CASE("Task group rethrows errors") {
+    Executor executor("test", 2);
+    TaskGroup group(executor);
+
+    std::atomic<size_t> count{0};
+    for (size_t i = 0; i < 100; ++i) {
+        group.run([&, i] {
+            count++;
+            if (i == 42) {
+                throw BadParameter("42");
+            }
+        });
+    }
+
+    EXPECT_THROWS_AS(group.wait(), BadParameter);
+    EXPECT(count == 100);
+    EXPECT_NO_THROW(group.wait());
+}
+
+CASE("Nested task groups") {
+    Executor executor("test", 4);
+    TaskGroup group(executor);
+    EXPECT(fibonacci(group, 25) == 75025);
+}
+
+CASE("Pinned workers") {
+    for (auto affinity : {Executor::Affinity::Core, Executor::Affinity::NumaNode}) {
+        Executor executor("test", 2, affinity);
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 100; ++i) {
+            results.push_back(executor.submit([i] { return -i; }));
+        }
+        int sum = 0;
+        for (auto& r : results) {
+            sum += r.get();
+        }
+        EXPECT(sum == -4950);
+    }
+}
+
+CASE("TaskGroup limit") {
+    Executor executor("limit", 8);
+    TaskGroup group(executor, 3);
+
+    std::atomic<size_t> running{0};
+    std::atomic<size_t> most{0};
+    std::atomic<size_t> count{0};
+
+    for (size_t i = 0; i < 50; ++i) {
+        group.run([&] {
+            size_t now = ++running;
+            for (size_t seen = most; now > seen && !most.compare_exchange_weak(seen, now);) {
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            --running;
+            ++count;
+        });
+    }
+    group.wait();
+
+    EXPECT(count == 50);
+    EXPECT(most <= 3);
+}
+
+CASE("parallelFor") {
+    std::vector<size_t> v(100003, 0);
+
+    for (size_t threads : {0, 1, 3}) {
+        parallelFor(v.size(), 1000, threads, [&](size_t begin, size_t end) {
+            EXPECT(threads == 1 || end - begin <= 1000);
+            for (size_t i = begin; i < end; ++i) {
+                v[i]++;
+            }
+        });
+    }
+    for (auto x : v) {
+        EXPECT(x == 3);
+    }
+
+    // Nested calls run on the executor of the calling worker, rather than on the shared one
+    Executor executor("outer", 2);
+    std::atomic<size_t> sum{0};
+    std::atomic<bool> nested{true};
+    executor.submit([&] {
+        parallelFor(8, 1, 0, [&](size_t begin, size_t end) {
+            parallelFor(100, 10, 0, [&](size_t b, size_t e) {
+                nested = nested && (Executor::current() == nullptr || Executor::current() == &executor);
+                sum += e - b;
+            });
+        });
+    }).get();
+
+    EXPECT(sum == 800);
+    EXPECT(nested);
+    EXPECT_THROWS_AS(parallelFor(10, 1, 2, [](size_t, size_t) { throw SeriousBug("in a range"); }), SeriousBug);
+}
+
+CASE("Task group waited upon by a busy executor") {
+    // The only worker is blocked, so the tasks of the group are run by the thread waiting for them
+    Executor executor("busy", 1);
+    std::promise<void> release;
+    auto blocked = executor.submit([future = release.get_future().share()] { future.wait(); });
+
+    std::atomic<size_t> count{0};
+    TaskGroup group(executor, 2);
+    for (size_t i = 0; i < 10; ++i) {
+        group.run([&] { count++; });
+    }
+    group.wait();
+    EXPECT(count == 10);
+
+    release.set_value();
+    blocked.get();
+}
+
+CASE("parallelFor after fork") {
+    std::atomic<size_t> sum{0};
+    parallelFor(1000, 10, 3, [&](size_t begin, size_t end) { sum += end - begin; });
+    EXPECT(sum == 1000);
+
+    pid_t pid = ::fork();
+    if (pid == 0) {
+        // The workers of the shared executor are not running here
+        ::alarm(60);
+        std::atomic<size_t> child{0};
+        parallelFor(1000, 10, 3, [&](size_t begin, size_t end) { child += end - begin; });
+        ::_exit(child == 1000 ? 0 : 1);
+    }
+
+    ASSERT(pid > 0);
+    int status = 0;
+    SYSCALL(::waitpid(pid, &status, 0));
+    EXPECT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::atomic<size_t> executed{0};
+
+class Increment : public ThreadPoolTask {
+    void execute() override {
+        if (++executed % 100 == 0) {
+            throw SeriousBug("every hundred");
+        }
+    }
+};
+
+CASE("ThreadPool adapter") {
+    ThreadPool pool("pool", 4);
+
+    std::list<ThreadPoolTask*> tasks;
+    for (size_t i = 0; i < 250; ++i) {
+        tasks.push_back(new Increment());
+    }
+    pool.push(tasks);
+    EXPECT(tasks.empty());
+
+    pool.wait();
+    EXPECT(executed == 250);
+    EXPECT(pool.done());
+
+    EXPECT_THROWS_AS(pool.waitForThreads(), SeriousBug);
+
+    pool.resize(2);
+    pool.push(new Increment());
+    EXPECT_NO_THROW(pool.waitForThreads());
+    EXPECT(executed == 251);
+}
+
+CASE("ThreadPool without threads") {
+    executed = 0;
+
+    ThreadPool pool("pool", 0);
+    pool.push(new Increment());
+    pool.push(new Increment());
+
+    // n.b. queued until there are threads to run them
+    EXPECT(!pool.done());
+    EXPECT(executed == 0);
+
+    pool.resize(3);
+    pool.wait();
+    EXPECT(pool.done());
+    EXPECT(executed == 2);
+
+    pool.resize(0);
+    pool.push(new Increment());
+    EXPECT(executed == 2);
+    pool.resize(1);
+    EXPECT_NO_THROW(pool.waitForThreads());
+    EXPECT(executed == 3);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace eckit::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
@@ -8,11 +8,14 @@
  * does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <memory>
 
+#include "eckit/utils/CRC32C.h"
 #include "eckit/utils/Hash.h"
+#include "eckit/utils/TreeHash.h"
 
 #include "eckit/testing/Test.h"
 
@@ -111,6 +114,30 @@ std::map<string, std::vector<string>> results = {
          "2dcf47703493b6ca",  //"The quick brown fox jumps over the lazy cog"
          "e32a7da747f1bd6e",  //"The quick brown fox jumps over the lazy cog" x 2
      }},
+    {"xxh3",
+     {
+         "2d06800538d394c2",  //""
+         "e6c632b61e964e1f",  //"a"
+         "78af5f94892f3950",  //"abc"
+         "160d8e9329be94f9",  //"message digest"
+         "810f9ca067fbb90c",  //"abcdefghijklmnopqrstuvwxyz"
+         "643542bb51639cb2",  //"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
+         "7f58aa2520c681f9",  //"12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+         "acc0b02d7594cbae",  //"The quick brown fox jumps over the lazy cog"
+         "930c05cc9d3d7f83",  //"The quick brown fox jumps over the lazy cog" x 2
+     }},
+    {"crc32c",
+     {
+         "00000000",  //""
+         "c1d04330",  //"a"
+         "364b3fb7",  //"abc"
+         "02bd79d0",  //"message digest"
+         "9ee6ef25",  //"abcdefghijklmnopqrstuvwxyz"
+         "a245d57d",  //"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
+         "477a6781",  //"12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+         "5692606d",  //"The quick brown fox jumps over the lazy cog"
+         "919344f7",  //"The quick brown fox jumps over the lazy cog" x 2
+     }},
     {"xxhash",  // Deprecated alias of xxh64
      {
          "ef46db3751d8e999",  //""
@@ -190,6 +217,60 @@ CASE("Hashing") {
     }
 }
 
+CASE("CRC32C") {
+    // iSCSI check value
+    EXPECT(CRC32C::crc("123456789", 9) == 0xe3069283);
+
+    // continued over pieces, at any alignment
+    std::string data(1000, 'x');
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = char(i * 7 + i / 13);
+    }
+
+    const auto whole = CRC32C::crc(data.data(), data.size());
+    for (size_t split : {1, 3, 8, 13, 999}) {
+        auto crc = CRC32C::crc(data.data(), split);
+        EXPECT(CRC32C::crc(data.data() + split, data.size() - split, crc) == whole);
+    }
+}
+
+
+CASE("Tree hashing") {
+    std::string data(3 * TreeHash::leafSize + 12345, 'x');
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = char(i * 7 + i / 13);
+    }
+
+    TreeHash one("crc32c", 1);
+    const auto digest = one.compute(data.data(), long(data.size()));
+
+    SECTION("Independent of the number of threads") {
+        TreeHash four("crc32c", 4);
+        EXPECT(four.compute(data.data(), long(data.size())) == digest);
+    }
+
+    SECTION("Independent of how the data is added") {
+        TreeHash hash("crc32c", 3);
+        for (size_t offset = 0, step = 1; offset < data.size(); offset += step, step = step * 3 + 17) {
+            hash.add(data.data() + offset, long(std::min(step, data.size() - offset)));
+        }
+        EXPECT(hash.digest() == digest);
+
+        hash.reset();
+        hash.add(data.data(), long(data.size()));
+        EXPECT(hash.digest() == digest);
+    }
+
+    SECTION("Registered") {
+        std::unique_ptr<Hash> hash(HashFactory::instance().build("crc32c-tree"));
+        EXPECT(hash->compute(data.data(), long(data.size())) == digest);
+    }
+
+    SECTION("Differs from the leaf hash") {
+        EXPECT(digest != CRC32C().compute(data.data(), long(data.size())));
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // end namespace test